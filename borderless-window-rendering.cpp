@@ -6,7 +6,8 @@
 
 void handle_init(struct window *data)
 {
-	ImGui::CreateContext();
+	data->imgui = ImGui::CreateContext();
+	ImGui::SetCurrentContext(data->imgui);
 	ImGui_ImplGL2_Init(data->hwnd);
 	ImGui::StyleColorsDark();
 	
@@ -43,6 +44,10 @@ static void handle_paint(struct window *data)
 
 bool handle_message(struct window *data, UINT msg, WPARAM wparam, LPARAM lparam)
 {
+	if (!data->imgui)
+		return false;
+	ImGui::SetCurrentContext(data->imgui);
+
 	// TODO: Get title bar dimensions from imgui:
 	if (HIWORD(lparam) < 19 && LOWORD(lparam) < data->width - 17)
 	{
@@ -68,8 +73,10 @@ bool handle_message(struct window *data, UINT msg, WPARAM wparam, LPARAM lparam)
 	return ImGui_ImplGL2_Handle_Message(msg, wparam, lparam);
 }
 
-void handle_shutdown(struct window * /*data*/)
+void handle_shutdown(struct window *data)
 {
+	ImGui::SetCurrentContext(data->imgui);
 	ImGui_ImplGL2_Shutdown();
-	ImGui::DestroyContext();
+	ImGui::DestroyContext(data->imgui);
+	data->imgui = NULL;
 }
\ No newline at end of file
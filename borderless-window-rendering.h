@@ -1,8 +1,11 @@
 #pragma once
 
+struct ImGuiContext;
+
 struct window
 {
 	HWND hwnd;
+	struct ImGuiContext *imgui; // each window has its own ImGui context, made current while handling its messages
 
 	unsigned width;
 	unsigned height;
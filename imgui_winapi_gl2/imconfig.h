@@ -30,6 +30,30 @@
 //---- Don't implement ImFormatString(), ImFormatStringV() so you can reimplement them yourself.
 //#define IMGUI_DISABLE_FORMAT_STRING_FUNCTIONS
 
+//---- Rasterize font atlas glyphs on worker threads in ImFontAtlas::Build() (uses <thread>, <mutex> and <atomic>). The output is identical to the single-threaded build.
+//#define IMGUI_ENABLE_FONT_ATLAS_BUILD_THREADS
+
+//---- Read and write the .ini file on a background thread (uses <thread>, <mutex>, <condition_variable> and <atomic>), so NewFrame() never waits for the disk. Allocators set with SetAllocatorFunctions() must be thread-safe.
+//#define IMGUI_ENABLE_INI_SETTINGS_THREAD
+
+//---- Write the output of LogToFile()/LogToTTY() on a background thread (uses <thread>, <mutex>, <condition_variable> and <atomic>). See io.LogFileOverflow for what happens when it falls behind.
+//#define IMGUI_ENABLE_LOG_FILE_THREAD
+
+//---- Filter large arrays on worker threads in ImGuiTextFilter::PassFilterArray() (uses <thread>, <mutex>, <condition_variable> and <atomic>). The threads are created on first use and kept by the context. The output is identical to the single-threaded path.
+//#define IMGUI_ENABLE_TEXT_FILTER_THREADS
+
+//---- Count memory allocations per frame and per category (draw lists, storage, text, windows), with bytes and peak usage, displayed in ShowMetricsWindow(). Prefixes each allocation with a 16 bytes header.
+//#define IMGUI_ENABLE_ALLOCATION_STATS
+
+//---- Make the current context pointer (GImGui) thread-local (uses C++11 thread_local), so several contexts can build frames at the same time, one per thread. Each thread calls SetCurrentContext() for the context it uses. With Visual C++, requires VS2015 or later (VS2013 has no thread_local nor thread-safe initialization of local statics, which GetGlyphRangesChinese() relies on). Not supported with a DLL build (IMGUI_API set to __declspec(dllexport)/__declspec(dllimport)).
+//#define IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+
+//---- Use 32-bit ImWchar to display and input codepoints beyond the Basic Multilingual Plane (U+10000..U+10FFFF, e.g. emojis). Default is 16-bit.
+//#define IMGUI_USE_WCHAR32
+
+//---- Don't use SSE2 intrinsics for text processing fast paths, even when the compiler targets SSE2.
+//#define IMGUI_DISABLE_SSE
+
 //---- Include imgui_user.h at the end of imgui.h as a convenience
 //#define IMGUI_INCLUDE_IMGUI_USER_H
 
@@ -641,10 +641,31 @@
 #else
 #include <stdint.h>     // intptr_t
 #endif
+#if defined(IMGUI_ENABLE_INI_SETTINGS_THREAD) || defined(IMGUI_ENABLE_LOG_FILE_THREAD)
+#include <thread>       // std::thread
+#include <mutex>        // std::mutex
+#include <condition_variable>
+#include <atomic>       // std::atomic
+#include <chrono>       // std::chrono::milliseconds
+#endif
+#if defined(IMGUI_ENABLE_TEXT_FILTER_THREADS)
+#include <thread>       // std::thread
+#include <mutex>        // std::mutex
+#include <condition_variable>
+#include <atomic>       // std::atomic
+#endif
+#if defined(IMGUI_ENABLE_THREAD_LOCAL_CONTEXT)
+#include <atomic>       // std::atomic
+#endif
 
 #define IMGUI_DEBUG_NAV_SCORING     0
 #define IMGUI_DEBUG_NAV_RECTS       0
 
+#define IMGUI_LOG_FILE_CHUNK_SIZE           (64*1024)   // Output of LogText() is written to the log file in chunks of at least that many bytes
+#define IMGUI_LOG_FILE_CHUNKS_COUNT         8           // Chunks queued for the log file writer thread before io.LogFileOverflow applies (power of two)
+
+#define IMGUI_TEXT_LOG_CHUNK_SIZE           (64*1024)   // ImGuiTextLog storage is allocated in chunks of that many bytes (more for a single longer line)
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (disable: 4127) // condition expression is constant
@@ -699,14 +720,17 @@ static ImGuiWindow*     CreateNewWindow(const char* name, ImVec2 size, ImGuiWind
 static void             CheckStacksSize(ImGuiWindow* window, bool write);
 static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* window);
 
+static void             LogFlushFileBuffer(ImGuiContext& g);
+static void             LogStartWriter(ImGuiContext& g);
+static void             LogStopWriter(ImGuiContext& g);
+
 static void             AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list);
 static void             AddWindowToDrawData(ImVector<ImDrawList*>* out_list, ImGuiWindow* window);
 static void             AddWindowToSortedBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window);
 
-static ImGuiWindowSettings* AddWindowSettings(const char* name);
+static ImGuiWindowSettings* AddWindowSettings(const char* name, const char* name_end = NULL);
 
 static void             LoadIniSettingsFromDisk(const char* ini_filename);
-static void             LoadIniSettingsFromMemory(const char* buf);
 static void             SaveIniSettingsToDisk(const char* ini_filename);
 static void             SaveIniSettingsToMemory(ImVector<char>& out_buf);
 static void             MarkIniSettingsDirty(ImGuiWindow* window);
@@ -752,11 +776,16 @@ static void             ImeSetInputScreenPosFn_DefaultImpl(int x, int y);
 // CreateContext() will automatically set this pointer if it is NULL. Change to a different context by calling ImGui::SetCurrentContext(). 
 // If you use DLL hotreloading you might need to call SetCurrentContext() after reloading code from this file. 
 // ImGui functions are not thread-safe because of this pointer. If you want thread-safety to allow N threads to access N different contexts, you can:
-// - Change this variable to use thread local storage. You may #define GImGui in imconfig.h for that purpose. Future development aim to make this context pointer explicit to all calls. Also read https://github.com/ocornut/imgui/issues/586
+// - Change this variable to use thread local storage: #define IMGUI_ENABLE_THREAD_LOCAL_CONTEXT in imconfig.h, or #define GImGui to your own. Future development aim to make this context pointer explicit to all calls. Also read https://github.com/ocornut/imgui/issues/586
 // - Having multiple instances of the ImGui code compiled inside different namespace (easiest/safest, if you have a finite number of contexts)
+// Apart from this pointer and the allocator functions, ImGui keeps no global state: contexts don't share anything unless you give them the same ImFontAtlas. (The demo code in imgui_demo.cpp keeps its own state in static variables.)
 #ifndef GImGui
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+thread_local ImGuiContext* GImGui = NULL;
+#else
 ImGuiContext*   GImGui = NULL;
 #endif
+#endif
 
 // Memory Allocator functions. Use SetAllocatorFunctions() to change them.
 // If you use DLL hotreloading you might need to call SetAllocatorFunctions() after reloading code from this file. 
@@ -772,7 +801,35 @@ static void    FreeWrapper(void* ptr, void* user_data)        { (void)user_data;
 static void*  (*GImAllocatorAllocFunc)(size_t size, void* user_data) = MallocWrapper;
 static void   (*GImAllocatorFreeFunc)(void* ptr, void* user_data) = FreeWrapper;
 static void*    GImAllocatorUserData = NULL;
-static size_t   GImAllocatorActiveAllocationsCount = 0;
+#if defined(IMGUI_ENABLE_INI_SETTINGS_THREAD) || defined(IMGUI_ENABLE_LOG_FILE_THREAD) || defined(IMGUI_ENABLE_THREAD_LOCAL_CONTEXT)
+typedef std::atomic<size_t> ImAllocatorCounter;     // The settings and log threads allocate too, so do contexts used from different threads
+#define IM_ALLOCATOR_THREAD_LOCAL   thread_local
+static inline void ImAllocatorCounterMax(ImAllocatorCounter& counter, size_t v) { size_t prev = counter; while (v > prev && !counter.compare_exchange_weak(prev, v)) {} }
+#else
+typedef size_t ImAllocatorCounter;
+#define IM_ALLOCATOR_THREAD_LOCAL
+static inline void ImAllocatorCounterMax(ImAllocatorCounter& counter, size_t v) { if (v > counter) counter = v; }
+#endif
+static ImAllocatorCounter GImAllocatorActiveAllocationsCount(0);
+static IM_ALLOCATOR_THREAD_LOCAL bool GImAllocatorInWorkerThread = false;     // Set by the settings and log writer threads, which don't count toward the current context
+
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+// Each allocation is prefixed with its size and category so MemFree() can account for it
+union ImAllocatorHeader
+{
+    struct { size_t Size; ImGuiAllocCategory Category; } Info;
+    char    Pad[16];    // Keep the returned memory 16 bytes aligned
+};
+static ImAllocatorCounter GImAllocStatsCount[ImGuiAllocCategory_COUNT];
+static ImAllocatorCounter GImAllocStatsBytes[ImGuiAllocCategory_COUNT];
+static ImAllocatorCounter GImAllocStatsLiveBytes[ImGuiAllocCategory_COUNT];
+static ImAllocatorCounter GImAllocStatsLiveBytesTotal(0);
+// Peak of the live bytes for each of the last frames started by NewFrame(), whatever the context, so each context can take the peak over the frames started since its own previous NewFrame()
+#define IM_ALLOC_STATS_PEAK_HISTORY 64
+static ImAllocatorCounter GImAllocStatsPeakLiveBytes[IM_ALLOC_STATS_PEAK_HISTORY];
+static ImAllocatorCounter GImAllocStatsPeakFrame(0);
+static IM_ALLOCATOR_THREAD_LOCAL ImGuiAllocCategory GImAllocatorCategory = ImGuiAllocCategory_Misc;   // Set by IM_ALLOC_CATEGORY()
+#endif
 
 //-----------------------------------------------------------------------------
 // User facing structures
@@ -850,6 +907,7 @@ ImGuiIO::ImGuiIO()
     IniSavingRate = 5.0f;
     IniFilename = "imgui.ini";
     LogFilename = "imgui_log.txt";
+    LogFileOverflow = ImGuiLogOverflow_Block;
     MouseDoubleClickTime = 0.30f;
     MouseDoubleClickMaxDist = 6.0f;
     for (int i = 0; i < ImGuiKey_COUNT; i++)
@@ -857,6 +915,7 @@ ImGuiIO::ImGuiIO()
     KeyRepeatDelay = 0.250f;
     KeyRepeatRate = 0.050f;
     UserData = NULL;
+    BindingUserData = NULL;
 
     Fonts = NULL;
     FontGlobalScale = 1.0f;
@@ -1085,48 +1144,97 @@ int ImFormatStringV(char* buf, size_t buf_size, const char* fmt, va_list args)
 }
 #endif // #ifdef IMGUI_DISABLE_FORMAT_STRING_FUNCTIONS
 
-// Pass data_size==0 for zero-terminated strings
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
-ImU32 ImHash(const void* data, int data_size, ImU32 seed)
+// MurmurHash3 (x86_32) consuming 4 bytes per step. A zero-terminated string hashes the same as its characters with an explicit size.
+#define IM_HASH_PAGE_SIZE   4096    // Smallest memory page size of the supported platforms
+#if defined(__clang__) || defined(__GNUC__)
+#define IM_HASH_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))   // Reading a whole word may read past the terminator of a string, within the same page
+#else
+#define IM_HASH_NO_SANITIZE_ADDRESS
+#endif
+static inline ImU32 ImHashRotl(ImU32 x, int r)  { return (x << r) | (x >> (32 - r)); }
+static inline bool  ImHashIsPlainChar(unsigned char c) { return c != 0 && c != '#'; }
+static inline bool  ImHashIsPlainWord(ImU32 v)          { const ImU32 v_hash = v ^ 0x23232323; return ((((v - 0x01010101) & ~v) | ((v_hash - 0x01010101) & ~v_hash)) & 0x80808080) == 0; }  // No zero nor '#' byte
+static inline ImU32 ImHashReadWord(const unsigned char* p) { return (ImU32)p[0] | ((ImU32)p[1] << 8) | ((ImU32)p[2] << 16) | ((ImU32)p[3] << 24); }
+static inline ImU32 ImHashMixWord(ImU32 h, ImU32 k)
 {
-    static ImU32 crc32_lut[256] = { 0 };
-    if (!crc32_lut[1])
+    k *= 0xCC9E2D51; k = ImHashRotl(k, 15); k *= 0x1B873593;
+    h ^= k; h = ImHashRotl(h, 13);
+    return h * 5 + 0xE6546B64;
+}
+static inline ImU32 ImHashFinal(ImU32 h, ImU32 tail, ImU32 len)
+{
+    if (tail)
     {
-        const ImU32 polynomial = 0xEDB88320;
-        for (ImU32 i = 0; i < 256; i++)
-        {
-            ImU32 crc = i;
-            for (ImU32 j = 0; j < 8; j++)
-                crc = (crc >> 1) ^ (ImU32(-int(crc & 1)) & polynomial);
-            crc32_lut[i] = crc;
-        }
+        tail *= 0xCC9E2D51; tail = ImHashRotl(tail, 15); tail *= 0x1B873593;
+        h ^= tail;
     }
+    h ^= len;
+    h ^= h >> 16; h *= 0x85EBCA6B;
+    h ^= h >> 13; h *= 0xC2B2AE35;
+    h ^= h >> 16;
+    return h;
+}
 
-    seed = ~seed;
-    ImU32 crc = seed;
+// Pass data_size==0 for zero-terminated strings
+IM_HASH_NO_SANITIZE_ADDRESS ImU32 ImHash(const void* data, int data_size, ImU32 seed)
+{
+    ImU32 h = seed;
     const unsigned char* current = (const unsigned char*)data;
 
     if (data_size > 0)
     {
         // Known size
-        while (data_size--)
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *current++];
-    }
-    else
+        const unsigned char* words_end = current + (data_size & ~3);
+        for (; current < words_end; current += 4)
+            h = ImHashMixWord(h, ImHashReadWord(current));
+        ImU32 tail = 0;
+        for (int n = (data_size & 3) - 1; n >= 0; n--)
+            tail = (tail << 8) | current[n];
+        return ImHashFinal(h, tail, (ImU32)data_size);
+    }
+
+    // Zero-terminated string: whole words are read and tested for a terminator or '#' at once. A word is only read when it doesn't cross a page boundary,
+    // so reading it never faults even when the terminator is in the middle of it. Otherwise, and around '#', characters are gathered into words one by one.
+    ImU32 word = 0, len = 0;
+    int shift = 0;
+    for (;;)
     {
-        // Zero-terminated string
-        while (unsigned char c = *current++)
+        if (shift == 0)
+            while (((size_t)current & (IM_HASH_PAGE_SIZE - 1)) <= IM_HASH_PAGE_SIZE - 4)
+            {
+                ImU32 v;
+                memcpy(&v, current, 4);
+                if (!ImHashIsPlainWord(v))
+                    break;
+                h = ImHashMixWord(h, ImHashReadWord(current));
+                current += 4;
+                len += 4;
+            }
+
+        const unsigned char c = *current++;
+        if (c == 0)
+            break;
+
+        // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
+        // Because this syntax is rarely used we are optimizing for the common case.
+        // - If we reach ### in the string we discard the hash so far and reset to the seed.
+        // - We don't do 'current += 2; continue;' after handling ### to keep the code smaller.
+        if (c == '#' && current[0] == '#' && current[1] == '#')
+        {
+            h = seed;
+            word = len = 0;
+            shift = 0;
+        }
+        word |= (ImU32)c << shift;
+        len++;
+        if ((shift += 8) == 32)
         {
-            // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
-            // Because this syntax is rarely used we are optimizing for the common case.
-            // - If we reach ### in the string we discard the hash so far and reset to the seed.
-            // - We don't do 'current += 2; continue;' after handling ### to keep the code smaller.
-            if (c == '#' && current[0] == '#' && current[1] == '#')
-                crc = seed;
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
+            h = ImHashMixWord(h, word);
+            word = 0;
+            shift = 0;
         }
     }
-    return ~crc;
+    return ImHashFinal(h, word, len);
 }
 
 //-----------------------------------------------------------------------------
@@ -1136,7 +1244,8 @@ ImU32 ImHash(const void* data, int data_size, ImU32 seed)
 // Convert UTF-8 to 32-bits character, process single character input.
 // Based on stb_from_utf8() from github.com/nothings/stb/
 // We handle UTF-8 decoding error by skipping forward.
-int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char* in_text_end)
+// Returns codepoints up to 0x10FFFF, ImTextCharFromUtf8() replaces the ones which don't fit in ImWchar.
+static int ImTextCharFromUtf8Unclamped(unsigned int* out_char, const char* in_text, const char* in_text_end)
 {
     unsigned int c = (unsigned int)-1;
     const unsigned char* str = (const unsigned char*)in_text;
@@ -1194,6 +1303,14 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return 0;
 }
 
+int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char* in_text_end)
+{
+    const int len = ImTextCharFromUtf8Unclamped(out_char, in_text, in_text_end);
+    // codepoints beyond the Basic Multilingual Plane don't fit in a 16-bit ImWchar (see IMGUI_USE_WCHAR32)
+    if (*out_char > IM_UNICODE_CODEPOINT_MAX) *out_char = 0xFFFD;
+    return len;
+}
+
 int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
 {
     ImWchar* buf_out = buf;
@@ -1204,8 +1321,7 @@ int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const cha
         in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         if (c == 0)
             break;
-        if (c < 0x10000)    // FIXME: Losing characters that don't fit in 2 bytes
-            *buf_out++ = (ImWchar)c;
+        *buf_out++ = (ImWchar)c;
     }
     *buf_out = 0;
     if (in_text_remaining)
@@ -1222,8 +1338,7 @@ int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
         in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         if (c == 0)
             break;
-        if (c < 0x10000)
-            char_count++;
+        char_count++;
     }
     return char_count;
 }
@@ -1247,7 +1362,7 @@ static inline int ImTextCharToUtf8(char* buf, int buf_size, unsigned int c)
     {
         return 0;
     }
-    if (c >= 0xd800 && c < 0xdc00)
+    if ((c >= 0xd800 && c < 0xdc00) || c >= 0x10000)
     {
         if (buf_size < 4) return 0;
         buf[0] = (char)(0xf0 + (c >> 18));
@@ -1271,7 +1386,7 @@ static inline int ImTextCountUtf8BytesFromChar(unsigned int c)
     if (c < 0x80) return 1;
     if (c < 0x800) return 2;
     if (c >= 0xdc00 && c < 0xe000) return 0;
-    if (c >= 0xd800 && c < 0xdc00) return 4;
+    if ((c >= 0xd800 && c < 0xdc00) || c >= 0x10000) return 4;
     return 3;
 }
 
@@ -1305,6 +1420,95 @@ int ImTextCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_e
     return bytes_count;
 }
 
+// UTF-16 is what the Win32 wide character functions take, whatever the size of ImWchar. Codepoints beyond the Basic Multilingual Plane are written as surrogate pairs.
+int ImTextStrToUtf16(wchar_t* buf, int buf_size, const char* in_text, const char* in_text_end)
+{
+    wchar_t* buf_out = buf;
+    wchar_t* buf_end = buf + buf_size;
+    while (buf_out < buf_end-1 && (!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        unsigned int c;
+        in_text += ImTextCharFromUtf8Unclamped(&c, in_text, in_text_end);
+        if (c == 0)
+            break;
+        if (c < 0x10000)
+        {
+            *buf_out++ = (wchar_t)c;
+            continue;
+        }
+        if (buf_out + 1 >= buf_end-1)
+            break;
+        *buf_out++ = (wchar_t)(0xD800 + ((c - 0x10000) >> 10));
+        *buf_out++ = (wchar_t)(0xDC00 + ((c - 0x10000) & 0x3FF));
+    }
+    *buf_out = 0;
+    return (int)(buf_out - buf);
+}
+
+int ImTextCountUtf16UnitsFromUtf8(const char* in_text, const char* in_text_end)
+{
+    int units_count = 0;
+    while ((!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        unsigned int c;
+        in_text += ImTextCharFromUtf8Unclamped(&c, in_text, in_text_end);
+        if (c == 0)
+            break;
+        units_count += (c < 0x10000) ? 1 : 2;
+    }
+    return units_count;
+}
+
+// Unpaired surrogates are replaced by U+FFFD
+static inline unsigned int ImTextCharFromUtf16(const wchar_t** in_text, const wchar_t* in_text_end)
+{
+    const wchar_t* s = *in_text;
+    unsigned int c = (unsigned int)(*s++ & 0xFFFF);
+    if (c >= 0xD800 && c < 0xDC00)
+    {
+        const unsigned int c2 = ((!in_text_end || s < in_text_end) && *s) ? (unsigned int)(*s & 0xFFFF) : 0;
+        if (c2 >= 0xDC00 && c2 < 0xE000)
+        {
+            c = 0x10000 + ((c - 0xD800) << 10) + (c2 - 0xDC00);
+            s++;
+        }
+        else
+        {
+            c = 0xFFFD;
+        }
+    }
+    else if (c >= 0xDC00 && c < 0xE000)
+    {
+        c = 0xFFFD;
+    }
+    *in_text = s;
+    return c;
+}
+
+int ImTextStrFromUtf16(char* buf, int buf_size, const wchar_t* in_text, const wchar_t* in_text_end)
+{
+    char* buf_out = buf;
+    const char* buf_end = buf + buf_size;
+    while (buf_out < buf_end-1 && (!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        const unsigned int c = ImTextCharFromUtf16(&in_text, in_text_end);
+        if (c < 0x80)
+            *buf_out++ = (char)c;
+        else
+            buf_out += ImTextCharToUtf8(buf_out, (int)(buf_end-buf_out-1), c);
+    }
+    *buf_out = 0;
+    return (int)(buf_out - buf);
+}
+
+int ImTextCountUtf8BytesFromUtf16(const wchar_t* in_text, const wchar_t* in_text_end)
+{
+    int bytes_count = 0;
+    while ((!in_text_end || in_text < in_text_end) && *in_text)
+        bytes_count += ImTextCountUtf8BytesFromChar(ImTextCharFromUtf16(&in_text, in_text_end));
+    return bytes_count;
+}
+
 ImVec4 ImGui::ColorConvertU32ToFloat4(ImU32 in)
 {
     float s = 1.0f/255.0f;
@@ -1411,14 +1615,14 @@ void ImGui::ColorConvertHSVtoRGB(float h, float s, float v, float& out_r, float&
 FILE* ImFileOpen(const char* filename, const char* mode)
 {
 #if defined(_WIN32) && !defined(__CYGWIN__)
-    // We need a fopen() wrapper because MSVC/Windows fopen doesn't handle UTF-8 filenames. Converting both strings from UTF-8 to wchar format (using a single allocation, because we can)
-    const int filename_wsize = ImTextCountCharsFromUtf8(filename, NULL) + 1;
-    const int mode_wsize = ImTextCountCharsFromUtf8(mode, NULL) + 1;
-    ImVector<ImWchar> buf;
+    // We need a fopen() wrapper because MSVC/Windows fopen doesn't handle UTF-8 filenames. Converting both strings from UTF-8 to UTF-16 (using a single allocation, because we can)
+    const int filename_wsize = ImTextCountUtf16UnitsFromUtf8(filename, NULL) + 1;
+    const int mode_wsize = ImTextCountUtf16UnitsFromUtf8(mode, NULL) + 1;
+    ImVector<wchar_t> buf;
     buf.resize(filename_wsize + mode_wsize);
-    ImTextStrFromUtf8(&buf[0], filename_wsize, filename, NULL);
-    ImTextStrFromUtf8(&buf[filename_wsize], mode_wsize, mode, NULL);
-    return _wfopen((wchar_t*)&buf[0], (wchar_t*)&buf[filename_wsize]);
+    ImTextStrToUtf16(&buf[0], filename_wsize, filename, NULL);
+    ImTextStrToUtf16(&buf[filename_wsize], mode_wsize, mode, NULL);
+    return _wfopen(&buf[0], &buf[filename_wsize]);
 #else
     return fopen(filename, mode);
 #endif
@@ -1471,32 +1675,84 @@ void* ImFileLoadToMemory(const char* filename, const char* file_open_mode, int*
 // Helper: Key->value storage
 //-----------------------------------------------------------------------------
 
-// std::lower_bound but without the bullshit
-static ImVector<ImGuiStorage::Pair>::iterator LowerBound(ImVector<ImGuiStorage::Pair>& data, ImGuiID key)
+static inline ImU32 StorageHashKey(ImGuiID key)
 {
-    ImVector<ImGuiStorage::Pair>::iterator first = data.begin();
-    ImVector<ImGuiStorage::Pair>::iterator last = data.end();
-    size_t count = (size_t)(last - first);
-    while (count > 0)
+    // IDs are already hashes, but keys set by the user may be sequential
+    ImU32 h = key * 0x9E3779B1;
+    return h ^ (h >> 15);
+}
+
+// Rebuild the hash table for 'count' pairs, the Data of the storage may hold fewer pairs
+static void StorageBuildIndex(ImGuiStorage* storage, int count)
+{
+    int capacity = 16;
+    while (capacity < count * 2)
+        capacity <<= 1;
+    storage->Index.resize(capacity);
+    memset(storage->Index.Data, 0, (size_t)capacity * sizeof(int));
+    const ImU32 mask = (ImU32)capacity - 1;
+    for (int n = 0; n < storage->Data.Size; n++)
     {
-        size_t count2 = count >> 1;
-        ImVector<ImGuiStorage::Pair>::iterator mid = first + count2;
-        if (mid->key < key)
-        {
-            first = ++mid;
-            count -= count2 + 1;
-        }
-        else
-        {
-            count = count2;
-        }
+        ImU32 slot = StorageHashKey(storage->Data[n].key) & mask;
+        while (storage->Index[slot] != 0)
+            slot = (slot + 1) & mask;
+        storage->Index[slot] = n + 1;
+    }
+    storage->IndexedCount = storage->Data.Size;
+}
+
+// Return the slot of the hash table holding 'key', or the empty slot where it would be inserted
+static int* StorageFindSlot(ImGuiStorage* storage, ImGuiID key)
+{
+    if (storage->IndexedCount != storage->Data.Size || storage->Index.Size == 0)
+        StorageBuildIndex(storage, storage->Data.Size);
+    const ImU32 mask = (ImU32)storage->Index.Size - 1;
+    ImU32 slot = StorageHashKey(key) & mask;
+    while (storage->Index[slot] != 0 && storage->Data[storage->Index[slot] - 1].key != key)
+        slot = (slot + 1) & mask;
+    return &storage->Index[slot];
+}
+
+// Read-only query, never rebuilds Index: when Data was modified directly since the last Set***() or BuildSortByKey(), fall back to a linear search
+static const ImGuiStorage::Pair* StorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    const ImVector<ImGuiStorage::Pair>& data = storage->Data;
+    if (storage->IndexedCount != data.Size || storage->Index.Size == 0)
+    {
+        for (int n = 0; n < data.Size; n++)
+            if (data[n].key == key)
+                return &data[n];
+        return NULL;
+    }
+    const ImU32 mask = (ImU32)storage->Index.Size - 1;
+    for (ImU32 slot = StorageHashKey(key) & mask; storage->Index[slot] != 0; slot = (slot + 1) & mask)
+        if (data[storage->Index[slot] - 1].key == key)
+            return &data[storage->Index[slot] - 1];
+    return NULL;
+}
+
+// Find the pair of pair.key, inserting 'pair' when missing
+static ImGuiStorage::Pair* StorageFindOrInsert(ImGuiStorage* storage, const ImGuiStorage::Pair& pair)
+{
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_Storage);
+    int* slot = StorageFindSlot(storage, pair.key);
+    if (*slot != 0)
+        return &storage->Data[*slot - 1];
+    if ((storage->Data.Size + 1) * 2 > storage->Index.Size)
+    {
+        StorageBuildIndex(storage, storage->Data.Size + 1);
+        slot = StorageFindSlot(storage, pair.key);
     }
-    return first;
+    storage->Data.push_back(pair);
+    storage->IndexedCount = storage->Data.Size;
+    *slot = storage->Data.Size;
+    return &storage->Data.back();
 }
 
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_Storage);
     struct StaticFunc 
     { 
         static int IMGUI_CDECL PairCompareByID(const void* lhs, const void* rhs) 
@@ -1509,14 +1765,13 @@ void ImGuiStorage::BuildSortByKey()
     };
     if (Data.Size > 1)
         qsort(Data.Data, (size_t)Data.Size, sizeof(Pair), StaticFunc::PairCompareByID);
+    StorageBuildIndex(this, Data.Size);
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImVector<Pair>::iterator it = LowerBound(const_cast<ImVector<ImGuiStorage::Pair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_i;
+    const Pair* pair = StorageFind(this, key);
+    return pair ? pair->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -1526,27 +1781,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImVector<Pair>::iterator it = LowerBound(const_cast<ImVector<ImGuiStorage::Pair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_f;
+    const Pair* pair = StorageFind(this, key);
+    return pair ? pair->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImVector<Pair>::iterator it = LowerBound(const_cast<ImVector<ImGuiStorage::Pair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return NULL;
-    return it->val_p;
+    const Pair* pair = StorageFind(this, key);
+    return pair ? pair->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, Pair(key, default_val));
-    return &it->val_i;
+    return &StorageFindOrInsert(this, Pair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -1556,30 +1804,17 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, Pair(key, default_val));
-    return &it->val_f;
+    return &StorageFindOrInsert(this, Pair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, Pair(key, default_val));
-    return &it->val_p;
+    return &StorageFindOrInsert(this, Pair(key, default_val))->val_p;
 }
 
-// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, Pair(key, val));
-        return;
-    }
-    it->val_i = val;
+    StorageFindOrInsert(this, Pair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -1589,24 +1824,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, Pair(key, val));
-        return;
-    }
-    it->val_f = val;
+    StorageFindOrInsert(this, Pair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, Pair(key, val));
-        return;
-    }
-    it->val_p = val;
+    StorageFindOrInsert(this, Pair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -1629,7 +1852,7 @@ ImGuiTextFilter::ImGuiTextFilter(const char* default_filter)
     }
     else
     {
-        InputBuf[0] = 0;
+        InputBuf[0] = FoldedBuf[0] = 0;
         CountGrep = 0;
     }
 }
@@ -1664,12 +1887,20 @@ void ImGuiTextFilter::TextRange::split(char separator, ImVector<TextRange>& out)
         out.push_back(TextRange(wb, we));
 }
 
+// Case folding used by filters, matching toupper() in the "C" locale
+static inline char ImTextFilterFold(char c) { return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c; }
+
 void ImGuiTextFilter::Build()
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_Text);
     Filters.resize(0);
     TextRange input_range(InputBuf, InputBuf+strlen(InputBuf));
     input_range.split(',', Filters);
 
+    // Fold once here so PassFilter() never has to fold the filters again
+    for (int i = 0; i <= input_range.e - input_range.b; i++)
+        FoldedBuf[i] = ImTextFilterFold(InputBuf[i]);
+
     CountGrep = 0;
     for (int i = 0; i != Filters.Size; i++)
     {
@@ -1681,29 +1912,77 @@ void ImGuiTextFilter::Build()
     }
 }
 
+// Case-insensitive search of a needle already folded with ImTextFilterFold().
+// Candidates are positions where the first and last characters of the needle match while ignoring bit 5 (a superset of case-insensitive matches), then verified.
+static const char* ImTextFilterFind(const char* haystack, const char* haystack_end, const char* needle, int needle_len)
+{
+    if (haystack_end - haystack < needle_len)
+        return NULL;
+    const int last = needle_len - 1;
+    const char first_c = (char)(needle[0] | 0x20);
+    const char last_c = (char)(needle[last] | 0x20);
+    const char* p = haystack;
+    const char* p_end = haystack_end - last; // Candidates start before p_end
+#ifdef IMGUI_ENABLE_SSE
+    const __m128i bit5 = _mm_set1_epi8(0x20);
+    const __m128i first_v = _mm_set1_epi8(first_c);
+    const __m128i last_v = _mm_set1_epi8(last_c);
+    for (; p_end - p >= 16; p += 16)
+    {
+        const __m128i first_m = _mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128((const __m128i*)p), bit5), first_v);
+        const __m128i last_m = _mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128((const __m128i*)(p + last)), bit5), last_v);
+        for (unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(first_m, last_m)), n = 0; mask != 0; mask >>= 1, n++)
+        {
+            if (!(mask & 1))
+                continue;
+            int i = 0;
+            while (i < needle_len && ImTextFilterFold(p[n + i]) == needle[i])
+                i++;
+            if (i == needle_len)
+                return p + n;
+        }
+    }
+#endif
+    for (; p < p_end; p++)
+    {
+        if ((char)(p[0] | 0x20) != first_c || (char)(p[last] | 0x20) != last_c)
+            continue;
+        int i = 0;
+        while (i < needle_len && ImTextFilterFold(p[i]) == needle[i])
+            i++;
+        if (i == needle_len)
+            return p;
+    }
+    return NULL;
+}
+
 bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 {
     if (Filters.empty())
         return true;
 
     if (text == NULL)
-        text = "";
+        text = text_end = "";
+    if (text_end == NULL)
+        text_end = text + strlen(text);
 
     for (int i = 0; i != Filters.Size; i++)
     {
         const TextRange& f = Filters[i];
         if (f.empty())
             continue;
+        const char* needle = FoldedBuf + (f.begin() - InputBuf);
+        const int needle_len = (int)(f.end() - f.begin());
         if (f.front() == '-')
         {
             // Subtract
-            if (ImStristr(text, text_end, f.begin()+1, f.end()) != NULL)
+            if (needle_len > 1 && ImTextFilterFind(text, text_end, needle + 1, needle_len - 1) != NULL)
                 return false;
         }
         else
         {
             // Grep
-            if (ImStristr(text, text_end, f.begin(), f.end()) != NULL)
+            if (ImTextFilterFind(text, text_end, needle, needle_len) != NULL)
                 return true;
         }
     }
@@ -1715,6 +1994,129 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
     return false;
 }
 
+static int TextFilterPassItems(const ImGuiTextFilter& filter, const char* const* items, int item_begin, int item_end, ImU32* out_bits)
+{
+    int pass_count = 0;
+    for (int n = item_begin; n < item_end; n++)
+        if (filter.PassFilter(items[n]))
+        {
+            out_bits[n >> 5] |= (ImU32)1 << (n & 31);
+            pass_count++;
+        }
+    return pass_count;
+}
+
+#ifdef IMGUI_ENABLE_TEXT_FILTER_THREADS
+// Worker threads of PassFilterArray(), created on first use and kept until the context is destroyed.
+// A call publishes a job and processes blocks of items on the calling thread too. Workers join the job while it is open, it is closed once the caller runs out of blocks.
+struct ImGuiTextFilterWorkers
+{
+    enum { BlockSize = 4096 };              // Items per block, a multiple of 32 so blocks never share a word of out_bits[]
+    std::thread             Threads[31];
+    int                     ThreadsCount;
+    std::mutex              Mutex;
+    std::condition_variable WakeUp;         // Signaled when a job is published, or when the threads should exit
+    std::condition_variable JobFinished;    // Signaled when the last worker leaves a closed job
+    const ImGuiTextFilter*  Filter;
+    const char* const*      Items;
+    int                     ItemsCount;
+    ImU32*                  OutBits;
+    std::atomic<int>        NextBlock;
+    std::atomic<int>        PassCount;
+    unsigned int            JobId;          // Incremented for each job
+    bool                    JobOpen;
+    int                     JobWorkersCount;// Workers processing the current job
+    bool                    Quit;
+
+    ImGuiTextFilterWorkers(int threads_count) : NextBlock(0), PassCount(0)
+    {
+        Filter = NULL; Items = NULL; ItemsCount = 0; OutBits = NULL;
+        JobId = 0; JobOpen = false; JobWorkersCount = 0; Quit = false;
+        ThreadsCount = ImMin(threads_count, IM_ARRAYSIZE(Threads));
+        for (int thread_n = 0; thread_n < ThreadsCount; thread_n++)
+            Threads[thread_n] = std::thread(ThreadMain, this);
+    }
+    ~ImGuiTextFilterWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            Quit = true;
+        }
+        WakeUp.notify_all();
+        for (int thread_n = 0; thread_n < ThreadsCount; thread_n++)
+            Threads[thread_n].join();
+    }
+
+    void ProcessBlocks()
+    {
+        int pass_count = 0;
+        for (int item_begin = (NextBlock++) * BlockSize; item_begin < ItemsCount; item_begin = (NextBlock++) * BlockSize)
+            pass_count += TextFilterPassItems(*Filter, Items, item_begin, ImMin(item_begin + BlockSize, ItemsCount), OutBits);
+        PassCount += pass_count;
+    }
+
+    int Run(const ImGuiTextFilter* filter, const char* const* items, int items_count, ImU32* out_bits)
+    {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            IM_ASSERT(!JobOpen && JobWorkersCount == 0);
+            Filter = filter; Items = items; ItemsCount = items_count; OutBits = out_bits;
+            NextBlock = 0;
+            PassCount = 0;
+            JobId++;
+            JobOpen = true;
+        }
+        WakeUp.notify_all();
+        ProcessBlocks();
+        std::unique_lock<std::mutex> lock(Mutex);
+        JobOpen = false;
+        JobFinished.wait(lock, [this] { return JobWorkersCount == 0; });
+        return PassCount;
+    }
+
+    static void ThreadMain(ImGuiTextFilterWorkers* w)
+    {
+        std::unique_lock<std::mutex> lock(w->Mutex);
+        unsigned int last_job_id = 0;
+        for (;;)
+        {
+            w->WakeUp.wait(lock, [w, last_job_id] { return w->Quit || (w->JobOpen && w->JobId != last_job_id); });
+            if (w->Quit)
+                break;
+            last_job_id = w->JobId;
+            w->JobWorkersCount++;
+            lock.unlock();
+            w->ProcessBlocks();
+            lock.lock();
+            if (--w->JobWorkersCount == 0 && !w->JobOpen)
+                w->JobFinished.notify_one();
+        }
+    }
+};
+#endif
+
+int ImGuiTextFilter::PassFilterArray(const char* const* items, int items_count, ImU32* out_bits) const
+{
+    memset(out_bits, 0, (size_t)((items_count + 31) / 32) * sizeof(ImU32));
+
+#ifdef IMGUI_ENABLE_TEXT_FILTER_THREADS
+    // Worker threads are only woken up for arrays of several blocks, they persist in the current context between calls
+    ImGuiContext* ctx = GImGui;
+    if (ctx && IsActive() && items_count >= ImGuiTextFilterWorkers::BlockSize * 2)
+    {
+        if (!ctx->TextFilterWorkers)
+        {
+            const int hardware_threads_count = (int)std::thread::hardware_concurrency();
+            if (hardware_threads_count > 1)
+                ctx->TextFilterWorkers = IM_NEW(ImGuiTextFilterWorkers)(hardware_threads_count - 1);
+        }
+        if (ctx->TextFilterWorkers)
+            return ctx->TextFilterWorkers->Run(this, items, items_count, out_bits);
+    }
+#endif
+    return TextFilterPassItems(*this, items, 0, items_count, out_bits);
+}
+
 //-----------------------------------------------------------------------------
 // ImGuiTextBuffer
 //-----------------------------------------------------------------------------
@@ -1728,6 +2130,7 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 // Helper: Text buffer for logging/accumulating text
 void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_Text);
     va_list args_copy;
     va_copy(args_copy, args);
 
@@ -1755,6 +2158,147 @@ void ImGuiTextBuffer::appendf(const char* fmt, ...)
     va_end(args);
 }
 
+//-----------------------------------------------------------------------------
+// ImGuiTextLog
+//-----------------------------------------------------------------------------
+
+ImGuiTextLog::ImGuiTextLog()
+{
+    ChunkUsed = ChunkCapacity = OpenLineOffset = 0;
+    FilteredCount = 0;
+    FilteredInputBuf[0] = 0;
+    AutoScroll = true;
+}
+
+ImGuiTextLog::~ImGuiTextLog()
+{
+    clear();
+}
+
+void ImGuiTextLog::clear()
+{
+    for (int i = 0; i < Chunks.Size; i++)
+        ImGui::MemFree(Chunks[i]);
+    Chunks.clear();
+    ChunkUsed = ChunkCapacity = OpenLineOffset = 0;
+    Lines.clear();
+    FilteredLines.clear();
+    FilteredCount = 0;
+}
+
+// Make room for 'len' more bytes after the open line. Only the open line is moved when a new chunk is needed.
+static char* TextLogReserve(ImGuiTextLog& log, int len)
+{
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_Text);
+    if (log.ChunkUsed + len <= log.ChunkCapacity)
+        return log.Chunks.back() + log.ChunkUsed;
+
+    const int open_len = log.ChunkUsed - log.OpenLineOffset;
+    const int capacity = ImMax(IMGUI_TEXT_LOG_CHUNK_SIZE, open_len + len);
+    char* chunk = (char*)ImGui::MemAlloc((size_t)capacity);
+    if (open_len > 0)
+        memcpy(chunk, log.Chunks.back() + log.OpenLineOffset, (size_t)open_len);
+    if (log.Chunks.Size > 0 && log.OpenLineOffset == 0) // Last chunk only held the open line
+    {
+        ImGui::MemFree(log.Chunks.back());
+        log.Chunks.pop_back();
+    }
+    log.Chunks.push_back(chunk);
+    log.ChunkCapacity = capacity;
+    log.ChunkUsed = open_len;
+    log.OpenLineOffset = 0;
+    return chunk + open_len;
+}
+
+// Commit 'len' bytes written after the open line, indexing every line they complete
+static void TextLogCommit(ImGuiTextLog& log, int len)
+{
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_Text);
+    char* chunk = log.Chunks.back();
+    const char* p = chunk + log.ChunkUsed;
+    const char* p_end = p + len;
+    while (const char* line_end = (const char*)memchr(p, '\n', (size_t)(p_end - p)))
+    {
+        log.Lines.push_back(ImGuiTextLog::Line(chunk + log.OpenLineOffset, line_end));
+        log.OpenLineOffset = (int)(line_end + 1 - chunk);
+        p = line_end + 1;
+    }
+    log.ChunkUsed += len;
+}
+
+void ImGuiTextLog::append(const char* str, const char* str_end)
+{
+    const int len = (int)(str_end ? str_end - str : strlen(str));
+    if (len <= 0)
+        return;
+    memcpy(TextLogReserve(*this, len), str, (size_t)len);
+    TextLogCommit(*this, len);
+}
+
+void ImGuiTextLog::appendfv(const char* fmt, va_list args)
+{
+    va_list args_copy, args_copy2;
+    va_copy(args_copy, args);
+    va_copy(args_copy2, args);
+
+    // First attempt writing in the space left in the last chunk, which is enough most of the time.
+    // Otherwise measure and write again in a new chunk. The zero-terminator is written in reserved space but not committed.
+    const int avail = ChunkCapacity - ChunkUsed;
+    int len = (avail > 1) ? ImFormatStringV(Chunks.back() + ChunkUsed, (size_t)avail, fmt, args) : -1;
+    if (len < 0 || len >= avail - 1)
+    {
+        len = ImFormatStringV(NULL, 0, fmt, args_copy);
+        if (len <= 0)
+            return;
+        ImFormatStringV(TextLogReserve(*this, len + 1), (size_t)len + 1, fmt, args_copy2);
+    }
+    TextLogCommit(*this, len);
+}
+
+void ImGuiTextLog::appendf(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    appendfv(fmt, args);
+    va_end(args);
+}
+
+void ImGuiTextLog::Draw(const char* str_id, const ImVec2& size)
+{
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_Text);
+    // Update cached filter results: rebuild when the filter changed, otherwise only test lines completed since last time
+    if (strcmp(FilteredInputBuf, Filter.InputBuf) != 0)
+    {
+        ImStrncpy(FilteredInputBuf, Filter.InputBuf, IM_ARRAYSIZE(FilteredInputBuf));
+        FilteredLines.resize(0);
+        FilteredCount = 0;
+    }
+    const bool filtering = Filter.IsActive();
+    if (filtering)
+        for (; FilteredCount < Lines.Size; FilteredCount++)
+            if (Filter.PassFilter(Lines[FilteredCount].b, Lines[FilteredCount].e))
+                FilteredLines.push_back(FilteredCount);
+
+    // The open line is still growing so it is tested every frame
+    const Line open_line = Chunks.Size > 0 ? Line(Chunks.back() + OpenLineOffset, Chunks.back() + ChunkUsed) : Line();
+    const bool open_line_visible = !open_line.empty() && (!filtering || Filter.PassFilter(open_line.b, open_line.e));
+    const int lines_count = (filtering ? FilteredLines.Size : Lines.Size) + (open_line_visible ? 1 : 0);
+
+    ImGui::BeginChild(str_id, size, false, ImGuiWindowFlags_HorizontalScrollbar);
+    const bool scroll_to_bottom = AutoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY();
+    ImGuiListClipper clipper(lines_count, ImGui::GetTextLineHeightWithSpacing());
+    while (clipper.Step())
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+        {
+            const int line_no = filtering ? (i < FilteredLines.Size ? FilteredLines[i] : Lines.Size) : i;
+            const Line& line = line_no < Lines.Size ? Lines[line_no] : open_line;
+            ImGui::TextUnformatted(line.b, line.e);
+        }
+    if (scroll_to_bottom)
+        ImGui::SetScrollHere(1.0f);
+    ImGui::EndChild();
+}
+
 //-----------------------------------------------------------------------------
 // ImGuiSimpleColumns (internal use only)
 //-----------------------------------------------------------------------------
@@ -1883,6 +2427,177 @@ bool ImGuiListClipper::Step()
     return false;
 }
 
+//-----------------------------------------------------------------------------
+// ImGuiListHeightCache, ImGuiListClipperVariable
+//-----------------------------------------------------------------------------
+
+// Fenwick tree helper. Node i (1-based, stored in Tree[i-1]) holds the sum of deltas of items (i - lowbit(i), i].
+static inline int FenwickLowBit(int i) { return i & -i; }
+
+void ImGuiListHeightCache::Resize(int items_count)
+{
+    IM_ASSERT(items_count >= 0);
+    if (DefaultHeight <= 0.0f)
+        DefaultHeight = ImGui::GetTextLineHeightWithSpacing();
+
+    const int old_count = Tree.Size;
+    if (items_count <= old_count)
+    {
+        Tree.resize(items_count); // Nodes only cover preceding items so truncating keeps the tree valid
+        return;
+    }
+
+    if (items_count - old_count < old_count / 16)
+    {
+        // Appending a few items (e.g. a growing log): new items have a zero delta, each node is the sum of its children. O(K log N)
+        Tree.resize(items_count);
+        for (int i = old_count + 1; i <= items_count; i++)
+        {
+            double sum = 0.0;
+            for (int child = i - 1; child > i - FenwickLowBit(i); child -= FenwickLowBit(child))
+                sum += Tree[child - 1];
+            Tree[i - 1] = sum;
+        }
+        return;
+    }
+
+    // Bulk growth: flatten the tree back to per-item deltas, then rebuild it. O(N)
+    for (int i = old_count; i >= 1; i--)
+        if (i + FenwickLowBit(i) <= old_count)
+            Tree[i + FenwickLowBit(i) - 1] -= Tree[i - 1];
+    Tree.resize(items_count, 0.0);
+    for (int i = 1; i <= items_count; i++)
+        if (i + FenwickLowBit(i) <= items_count)
+            Tree[i + FenwickLowBit(i) - 1] += Tree[i - 1];
+}
+
+float ImGuiListHeightCache::GetHeight(int item_idx) const
+{
+    IM_ASSERT(item_idx >= 0 && item_idx < Tree.Size);
+    const int i = item_idx + 1;
+    double delta = Tree[i - 1];
+    for (int child = i - 1; child > i - FenwickLowBit(i); child -= FenwickLowBit(child))
+        delta -= Tree[child - 1];
+    return DefaultHeight + (float)delta;
+}
+
+void ImGuiListHeightCache::SetHeight(int item_idx, float height)
+{
+    IM_ASSERT(item_idx >= 0 && item_idx < Tree.Size);
+    const double diff = (double)height - (double)GetHeight(item_idx);
+    if (diff == 0.0)
+        return;
+    for (int i = item_idx + 1; i <= Tree.Size; i += FenwickLowBit(i))
+        Tree[i - 1] += diff;
+}
+
+double ImGuiListHeightCache::GetOffset(int item_idx) const
+{
+    IM_ASSERT(item_idx >= 0 && item_idx <= Tree.Size);
+    double offset = (double)item_idx * DefaultHeight;
+    for (int i = item_idx; i > 0; i -= FenwickLowBit(i))
+        offset += Tree[i - 1];
+    return offset;
+}
+
+int ImGuiListHeightCache::FindItem(double offset) const
+{
+    // Descend the tree from the largest power of two, skipping whole nodes while they end before 'offset'
+    int step = 1;
+    while (step <= Tree.Size / 2)
+        step <<= 1;
+    int pos = 0;
+    for (; step > 0; step >>= 1)
+    {
+        if (pos + step > Tree.Size)
+            continue;
+        const double node_height = Tree[pos + step - 1] + (double)step * DefaultHeight;
+        if (node_height <= offset)
+        {
+            pos += step;
+            offset -= node_height;
+        }
+    }
+    return pos;
+}
+
+void ImGuiListClipperVariable::Begin(int items_count)
+{
+    IM_ASSERT(Heights != NULL);
+    Heights->Resize(items_count);
+    StartPosY = ItemPosY = ImGui::GetCursorPosY();
+    ItemsCount = items_count;
+    StepNo = 0;
+    DisplayStart = DisplayEnd = -1;
+    ExtraItems = 0;
+}
+
+void ImGuiListClipperVariable::End()
+{
+    if (ItemsCount < 0)
+        return;
+    if (ItemsCount > 0)
+        SetCursorPosYAndSetupDummyPrevLine(StartPosY + (float)Heights->GetTotalHeight(), Heights->GetHeight(ItemsCount - 1)); // advance cursor
+    ItemsCount = -1;
+    StepNo = 2;
+}
+
+bool ImGuiListClipperVariable::Step()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    if (ItemsCount <= 0 || window->SkipItems)
+    {
+        ItemsCount = -1;
+        return false;
+    }
+    if (StepNo == 0) // Step 0: binary search the first visible item from the scroll position and seek the cursor to it.
+    {
+        int start = 0;
+        if (!g.LogEnabled) // If logging is active, do not perform any clipping
+        {
+            start = Heights->FindItem((double)(window->ClipRect.Min.y - window->DC.CursorPos.y));
+            if (g.NavMoveRequest && g.NavMoveDir == ImGuiDir_Up) // When performing a navigation request, ensure we have one item extra in the direction we are moving to
+                start = ImMax(start - 1, 0);
+            if (g.NavMoveRequest && g.NavMoveDir == ImGuiDir_Down)
+                ExtraItems = 1;
+        }
+        if (start >= ItemsCount)
+        {
+            End();
+            return false;
+        }
+        if (start > 0)
+            SetCursorPosYAndSetupDummyPrevLine(StartPosY + (float)Heights->GetOffset(start), Heights->GetHeight(start - 1)); // advance cursor
+        ItemPosY = ImGui::GetCursorPosY();
+        DisplayStart = start;
+        DisplayEnd = start + 1;
+        StepNo = 1;
+        return true;
+    }
+    if (StepNo == 1) // Step 1: measure the item that was just submitted, carry on until the cursor leaves the clipping rectangle, then advance the cursor to the end of the list.
+    {
+        const float height = ImGui::GetCursorPosY() - ItemPosY;
+        IM_ASSERT(height >= 0.0f); // If this triggers, it means the item moved the cursor backward
+        Heights->SetHeight(DisplayStart, height);
+        DisplayStart++;
+        bool visible = g.LogEnabled || window->DC.CursorPos.y < window->ClipRect.Max.y;
+        if (!visible && ExtraItems > 0)
+        {
+            ExtraItems--;
+            visible = true;
+        }
+        if (visible && DisplayStart < ItemsCount)
+        {
+            ItemPosY = ImGui::GetCursorPosY();
+            DisplayEnd = DisplayStart + 1;
+            return true;
+        }
+        End();
+    }
+    return false;
+}
+
 //-----------------------------------------------------------------------------
 // ImGuiWindow
 //-----------------------------------------------------------------------------
@@ -2564,15 +3279,87 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
 void* ImGui::MemAlloc(size_t sz)
 {
     GImAllocatorActiveAllocationsCount++;
+    ImGuiContext* ctx = GImAllocatorInWorkerThread ? NULL : GImGui;     // Per context counters are only touched by the thread the context is current in
+    if (ctx)
+        ctx->AllocsCount++;
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+    ImAllocatorHeader* header = (ImAllocatorHeader*)GImAllocatorAllocFunc(sizeof(ImAllocatorHeader) + sz, GImAllocatorUserData);
+    if (header == NULL)
+        return NULL;
+    const ImGuiAllocCategory category = GImAllocatorCategory;
+    header->Info.Size = sz;
+    header->Info.Category = category;
+    GImAllocStatsCount[category]++;
+    GImAllocStatsBytes[category] += sz;
+    if (ctx)
+    {
+        ctx->AllocStats.Count[category]++;
+        ctx->AllocStats.Bytes[category] += sz;
+    }
+    GImAllocStatsLiveBytes[category] += sz;
+    const size_t live_bytes_total = (GImAllocStatsLiveBytesTotal += sz);
+    ImAllocatorCounterMax(GImAllocStatsPeakLiveBytes[GImAllocStatsPeakFrame % IM_ALLOC_STATS_PEAK_HISTORY], live_bytes_total);
+    return header + 1;
+#else
     return GImAllocatorAllocFunc(sz, GImAllocatorUserData);
+#endif
 }
 
 void ImGui::MemFree(void* ptr)
 {
     if (ptr) GImAllocatorActiveAllocationsCount--;
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+    if (ptr == NULL)
+        return;
+    ImAllocatorHeader* header = (ImAllocatorHeader*)ptr - 1;
+    GImAllocStatsLiveBytes[header->Info.Category] -= header->Info.Size;
+    GImAllocStatsLiveBytesTotal -= header->Info.Size;
+    ptr = header;
+#endif
     return GImAllocatorFreeFunc(ptr, GImAllocatorUserData);
 }
 
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+ImGuiAllocCategory ImGui::SetAllocCategory(ImGuiAllocCategory category)
+{
+    const ImGuiAllocCategory prev_category = GImAllocatorCategory;
+    GImAllocatorCategory = category;
+    return prev_category;
+}
+
+void ImGui::GetAllocStats(ImGuiAllocStats* out_stats)
+{
+    for (int n = 0; n < ImGuiAllocCategory_COUNT; n++)
+    {
+        out_stats->Count[n] = GImAllocStatsCount[n];
+        out_stats->Bytes[n] = GImAllocStatsBytes[n];
+        out_stats->LiveBytes[n] = GImAllocStatsLiveBytes[n];
+    }
+    out_stats->PeakLiveBytes = GImAllocStatsPeakLiveBytes[GImAllocStatsPeakFrame % IM_ALLOC_STATS_PEAK_HISTORY];
+}
+
+// Peak of the live bytes since the frame started by the previous NewFrame() of this context, then start a new frame
+static void UpdateAllocStatsPeak(ImGuiContext& g)
+{
+    const size_t last_frame = GImAllocStatsPeakFrame;
+    size_t first_frame = g.AllocStatsPeakFrameStart;
+    if (last_frame - first_frame >= IM_ALLOC_STATS_PEAK_HISTORY)    // Other contexts started more frames than we keep: use the peak of the last ones
+        first_frame = last_frame - (IM_ALLOC_STATS_PEAK_HISTORY - 1);
+    size_t peak_live_bytes = 0;
+    for (size_t frame = first_frame; frame != last_frame + 1; frame++)
+    {
+        const size_t frame_peak_live_bytes = GImAllocStatsPeakLiveBytes[frame % IM_ALLOC_STATS_PEAK_HISTORY];
+        if (frame_peak_live_bytes > peak_live_bytes)
+            peak_live_bytes = frame_peak_live_bytes;
+    }
+    g.AllocStatsLastFrame.PeakLiveBytes = peak_live_bytes;
+
+    const size_t new_frame = ++GImAllocStatsPeakFrame;
+    GImAllocStatsPeakLiveBytes[new_frame % IM_ALLOC_STATS_PEAK_HISTORY] = (size_t)GImAllocStatsLiveBytesTotal;
+    g.AllocStatsPeakFrameStart = new_frame;
+}
+#endif
+
 const char* ImGui::GetClipboardText()
 {
     return GImGui->IO.GetClipboardTextFn ? GImGui->IO.GetClipboardTextFn(GImGui->IO.ClipboardUserData) : "";
@@ -3277,6 +4064,22 @@ void ImGui::NewFrame()
     if (g.IO.ConfigFlags & ImGuiConfigFlags_NavEnableKeyboard)
         IM_ASSERT(g.IO.KeyMap[ImGuiKey_Space] != -1 && "ImGuiKey_Space is not mapped, required for keyboard navigation.");
 
+    // Count the memory allocations made with this context during the previous frame
+    g.IO.MetricsFrameAllocs = (int)(g.AllocsCount - g.FrameAllocsStart);
+    g.FrameAllocsStart = g.AllocsCount;
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+    ImGuiAllocStats alloc_stats;
+    GetAllocStats(&alloc_stats);
+    for (int n = 0; n < ImGuiAllocCategory_COUNT; n++)
+    {
+        g.AllocStatsLastFrame.Count[n] = g.AllocStats.Count[n] - g.AllocStatsFrameStart.Count[n];
+        g.AllocStatsLastFrame.Bytes[n] = g.AllocStats.Bytes[n] - g.AllocStatsFrameStart.Bytes[n];
+        g.AllocStatsLastFrame.LiveBytes[n] = alloc_stats.LiveBytes[n];    // Process-wide: a block may be freed by another context than the one which allocated it
+    }
+    g.AllocStatsFrameStart = g.AllocStats;
+    UpdateAllocStatsPeak(g);
+#endif
+
     // Load settings on first frame
     if (!g.SettingsLoaded)
     {
@@ -3290,6 +4093,9 @@ void ImGui::NewFrame()
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
 
+    // Rasterize glyphs missed during the previous frame (fonts using ImFontConfig::DynamicGlyphs)
+    g.IO.Fonts->UpdateDynamicGlyphs();
+
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
     g.DrawListSharedData.ClipRectFullscreen = ImVec4(0.0f, 0.0f, g.IO.DisplaySize.x, g.IO.DisplaySize.y);
@@ -3298,7 +4104,7 @@ void ImGui::NewFrame()
     g.OverlayDrawList.Clear();
     g.OverlayDrawList.PushTextureID(g.IO.Fonts->TexID);
     g.OverlayDrawList.PushClipRectFullScreen();
-    g.OverlayDrawList.Flags = (g.Style.AntiAliasedLines ? ImDrawListFlags_AntiAliasedLines : 0) | (g.Style.AntiAliasedFill ? ImDrawListFlags_AntiAliasedFill : 0);
+    g.OverlayDrawList.Flags = (g.Style.AntiAliasedLines ? ImDrawListFlags_AntiAliasedLines : 0) | (g.Style.AntiAliasedFill ? ImDrawListFlags_AntiAliasedFill : 0) | ((g.IO.ConfigFlags & ImGuiConfigFlags_RendererHasAnalyticShapes) ? ImDrawListFlags_AnalyticShapes : 0);
 
     // Mark rendering data as invalid to prevent user who may have a handle on it to use it
     g.DrawData.Clear();
@@ -3532,22 +4338,77 @@ void ImGui::NewFrame()
     Begin("Debug##Default");
 }
 
-static void* SettingsHandlerWindow_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name)
+// Hash a window name like GetID() does: only the part starting at the last "###" marker counts
+static ImGuiID SettingsHashWindowName(const char* name, const char* name_end)
+{
+    if (!name_end)
+        return ImHash(name, 0);
+    for (const char* p = name; p + 3 <= name_end; p++)
+        if (p[0] == '#' && p[1] == '#' && p[2] == '#')
+            name = p;
+    return (name < name_end) ? ImHash(name, (int)(name_end - name)) : ImHash("", 0);
+}
+
+// Parse a number such as "-12" or "3.5" in [p, p_end), skipping leading blanks like sscanf("%f") does. Returns NULL if there is none.
+static const char* SettingsParseFloat(const char* p, const char* p_end, float* out)
+{
+    while (p < p_end && (*p == ' ' || *p == '\t'))
+        p++;
+    bool negative = false;
+    if (p < p_end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+    const char* digits_start = p;
+    double v = 0.0;
+    while (p < p_end && *p >= '0' && *p <= '9')
+        v = v * 10.0 + (*p++ - '0');
+    bool has_digits = (p > digits_start);
+    if (p < p_end && *p == '.')
+    {
+        double scale = 0.1;
+        for (p++; p < p_end && *p >= '0' && *p <= '9'; p++, scale *= 0.1)
+        {
+            v += (*p - '0') * scale;
+            has_digits = true;
+        }
+    }
+    if (!has_digits)
+        return NULL;
+    *out = (float)(negative ? -v : v);
+    return p;
+}
+
+// Equivalent to sscanf(line, "<prefix>%f,%f...") == values_count, on a line which isn't zero-terminated
+static bool SettingsParseLine(const char* line, const char* line_end, const char* prefix, float* out_values, int values_count)
+{
+    const size_t prefix_len = strlen(prefix);
+    if ((size_t)(line_end - line) < prefix_len || memcmp(line, prefix, prefix_len) != 0)
+        return false;
+    const char* p = line + prefix_len;
+    for (int n = 0; n < values_count; n++)
+    {
+        if (n > 0 && (p == line_end || *p++ != ','))
+            return false;
+        if (!(p = SettingsParseFloat(p, line_end, &out_values[n])))
+            return false;
+    }
+    return true;
+}
+
+static void* SettingsHandlerWindow_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name, const char* name_end)
 {
-    ImGuiWindowSettings* settings = ImGui::FindWindowSettings(ImHash(name, 0));
+    ImGuiWindowSettings* settings = ImGui::FindWindowSettings(SettingsHashWindowName(name, name_end));
     if (!settings)
-        settings = AddWindowSettings(name);
+        settings = AddWindowSettings(name, name_end);
     return (void*)settings;
 }
 
-static void SettingsHandlerWindow_ReadLine(ImGuiContext*, ImGuiSettingsHandler*, void* entry, const char* line)
+static void SettingsHandlerWindow_ReadLine(ImGuiContext*, ImGuiSettingsHandler*, void* entry, const char* line, const char* line_end)
 {
     ImGuiWindowSettings* settings = (ImGuiWindowSettings*)entry;
-    float x, y; 
-    int i;
-    if (sscanf(line, "Pos=%f,%f", &x, &y) == 2)         settings->Pos = ImVec2(x, y);
-    else if (sscanf(line, "Size=%f,%f", &x, &y) == 2)   settings->Size = ImMax(ImVec2(x, y), GImGui->Style.WindowMinSize);
-    else if (sscanf(line, "Collapsed=%d", &i) == 1)     settings->Collapsed = (i != 0);
+    float v[2];
+    if (SettingsParseLine(line, line_end, "Pos=", v, 2))                settings->Pos = ImVec2(v[0], v[1]);
+    else if (SettingsParseLine(line, line_end, "Size=", v, 2))          settings->Size = ImMax(ImVec2(v[0], v[1]), GImGui->Style.WindowMinSize);
+    else if (SettingsParseLine(line, line_end, "Collapsed=", v, 1))     settings->Collapsed = ((int)v[0] != 0);
 }
 
 static void SettingsHandlerWindow_WriteAll(ImGuiContext* imgui_ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
@@ -3590,6 +4451,11 @@ void ImGui::Initialize(ImGuiContext* context)
 {
     ImGuiContext& g = *context;
     IM_ASSERT(!g.Initialized && !g.SettingsLoaded);
+    g.FrameAllocsStart = g.AllocsCount;
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+    g.AllocStatsFrameStart = g.AllocStats;
+    g.AllocStatsPeakFrameStart = GImAllocStatsPeakFrame;
+#endif
     g.LogClipboard = IM_NEW(ImGuiTextBuffer)();
 
     // Add .ini handle for ImGuiWindow type
@@ -3612,12 +4478,21 @@ void ImGui::Shutdown(ImGuiContext* context)
     // The fonts atlas can be used prior to calling NewFrame(), so we clear it even if g.Initialized is FALSE (which would happen if we never called NewFrame)
     if (g.IO.Fonts && g.FontAtlasOwnedByContext)
         IM_DELETE(g.IO.Fonts);
+#ifdef IMGUI_ENABLE_TEXT_FILTER_THREADS
+    if (g.TextFilterWorkers)
+        IM_DELETE(g.TextFilterWorkers);
+    g.TextFilterWorkers = NULL;
+#endif
 
     // Cleanup of other data are conditional on actually having initialize ImGui.
     if (!g.Initialized)
         return;
 
     SaveIniSettingsToDisk(g.IO.IniFilename);
+#ifdef IMGUI_ENABLE_INI_SETTINGS_THREAD
+    if (g.SettingsThread)
+        IM_DELETE(g.SettingsThread); // Waits for the last save to be written
+#endif
 
     // Clear everything else
     for (int i = 0; i < g.Windows.Size; i++)
@@ -3643,15 +4518,21 @@ void ImGui::Shutdown(ImGuiContext* context)
     g.OverlayDrawList.ClearFreeMemory();
     g.PrivateClipboard.clear();
     g.InputTextState.Text.clear();
+    g.InputTextState.TextA.clear();
     g.InputTextState.InitialText.clear();
     g.InputTextState.TempTextBuffer.clear();
+    g.InputTextState.Lines.clear();
 
     g.SettingsWindows.clear();
+    g.SettingsWindowsById.Clear();
     g.SettingsHandlers.clear();
 
-    if (g.LogFile && g.LogFile != stdout)
+    if (g.LogFile)
     {
-        fclose(g.LogFile);
+        LogFlushFileBuffer(g);
+        LogStopWriter(g);
+        if (g.LogFile != stdout)
+            fclose(g.LogFile);
         g.LogFile = NULL;
     }
     if (g.LogClipboard)
@@ -3663,93 +4544,261 @@ void ImGui::Shutdown(ImGuiContext* context)
 ImGuiWindowSettings* ImGui::FindWindowSettings(ImGuiID id)
 {
     ImGuiContext& g = *GImGui;
-    for (int i = 0; i != g.SettingsWindows.Size; i++)
-        if (g.SettingsWindows[i].Id == id)
-            return &g.SettingsWindows[i];
-    return NULL;
+    const int index = g.SettingsWindowsById.GetInt(id, 0);
+    return index ? &g.SettingsWindows[index - 1] : NULL;
 }
 
-static ImGuiWindowSettings* AddWindowSettings(const char* name)
+static ImGuiWindowSettings* AddWindowSettings(const char* name, const char* name_end)
 {
     ImGuiContext& g = *GImGui;
+    if (!name_end)
+        name_end = name + strlen(name);
     g.SettingsWindows.push_back(ImGuiWindowSettings());
     ImGuiWindowSettings* settings = &g.SettingsWindows.back();
-    settings->Name = ImStrdup(name);
-    settings->Id = ImHash(name, 0);
+    const size_t name_len = (size_t)(name_end - name);
+    settings->Name = (char*)ImGui::MemAlloc(name_len + 1);
+    memcpy(settings->Name, name, name_len);
+    settings->Name[name_len] = 0;
+    settings->Id = SettingsHashWindowName(name, name_end);
+    g.SettingsWindowsById.SetInt(settings->Id, g.SettingsWindows.Size);
     return settings;
 }
 
+// Write to "<ini_filename>.tmp" then replace the .ini file, so an interrupted save never leaves a truncated file behind
+static bool WriteIniSettingsFile(const char* ini_filename, const char* data, size_t data_size)
+{
+    const int filename_len = (int)strlen(ini_filename);
+    ImVector<char> tmp_filename;
+    tmp_filename.resize(filename_len + 5);
+    memcpy(tmp_filename.Data, ini_filename, (size_t)filename_len);
+    memcpy(tmp_filename.Data + filename_len, ".tmp", 5);
+
+    FILE* f = ImFileOpen(tmp_filename.Data, "wt");
+    if (!f)
+        return false;
+    bool ok = fwrite(data, sizeof(char), data_size, f) == data_size;
+    ok = (fclose(f) == 0) && ok;
+    ok = ok && ImFileReplace(tmp_filename.Data, ini_filename);
+    if (!ok)
+        remove(tmp_filename.Data);
+    return ok;
+}
+
+#ifdef IMGUI_ENABLE_INI_SETTINGS_THREAD
+// Background thread reading and writing the .ini file.
+// A queued save is replaced by newer ones until the thread picks it up, so a burst of saves ends up in a single write of the latest settings.
+struct ImGuiSettingsThread
+{
+    std::thread             Thread;
+    std::mutex              Mutex;
+    std::condition_variable WakeUp;         // Signaled when a job is queued, or when the thread should exit
+    std::condition_variable LoadFinished;
+    ImVector<char>          LoadFilename;   // Zero-terminated. Empty until PreloadIniSettings() is called.
+    char*                   LoadData;       // Contents of the file once loaded, NULL if missing
+    int                     LoadDataSize;
+    bool                    LoadQueued, LoadDone;
+    ImVector<char>          SaveFilename;   // Zero-terminated
+    ImVector<char>          SaveData;
+    bool                    SaveQueued;
+    bool                    Quit;
+
+    ImGuiSettingsThread()   { LoadData = NULL; LoadDataSize = 0; LoadQueued = LoadDone = SaveQueued = Quit = false; Thread = std::thread(ThreadMain, this); }
+    ~ImGuiSettingsThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            Quit = true;
+        }
+        WakeUp.notify_one();
+        Thread.join(); // Pending jobs are processed first
+        if (LoadData)
+            ImGui::MemFree(LoadData);
+    }
+
+    static void ThreadMain(ImGuiSettingsThread* st)
+    {
+        GImAllocatorInWorkerThread = true;
+        std::unique_lock<std::mutex> lock(st->Mutex);
+        for (;;)
+        {
+            if (st->LoadQueued)
+            {
+                // LoadFilename isn't modified once the load is queued
+                st->LoadQueued = false;
+                lock.unlock();
+                int data_size = 0;
+                char* data = (char*)ImFileLoadToMemory(st->LoadFilename.Data, "rb", &data_size, +1);
+                lock.lock();
+                st->LoadData = data;
+                st->LoadDataSize = data_size;
+                st->LoadDone = true;
+                st->LoadFinished.notify_all();
+            }
+            else if (st->SaveQueued)
+            {
+                ImVector<char> filename, data;
+                filename.swap(st->SaveFilename);
+                data.swap(st->SaveData);
+                st->SaveQueued = false;
+                lock.unlock();
+                WriteIniSettingsFile(filename.Data, data.Data, (size_t)data.Size);
+                lock.lock();
+            }
+            else if (st->Quit)
+            {
+                break;
+            }
+            else
+            {
+                st->WakeUp.wait(lock);
+            }
+        }
+    }
+};
+
+static ImGuiSettingsThread* GetSettingsThread()
+{
+    ImGuiContext& g = *GImGui;
+    if (!g.SettingsThread)
+        g.SettingsThread = IM_NEW(ImGuiSettingsThread)();
+    return g.SettingsThread;
+}
+
+static void SettingsThreadSetFilename(ImVector<char>& out_filename, const char* filename)
+{
+    out_filename.resize((int)strlen(filename) + 1);
+    memcpy(out_filename.Data, filename, (size_t)out_filename.Size);
+}
+
+// Wait for the file read by PreloadIniSettings(). Returns false if no preload of 'ini_filename' was started (e.g. io.IniFilename was changed since).
+static bool SettingsThreadTakePreloadedFile(const char* ini_filename, char** out_file_data, int* out_file_size)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiSettingsThread* st = g.SettingsThread;
+    if (!st)
+        return false;
+    std::unique_lock<std::mutex> lock(st->Mutex);
+    if (st->LoadFilename.empty() || strcmp(st->LoadFilename.Data, ini_filename) != 0)
+        return false;
+    st->LoadFinished.wait(lock, [st] { return st->LoadDone; });
+    *out_file_data = st->LoadData;
+    *out_file_size = st->LoadDataSize;
+    st->LoadData = NULL;
+    return true;
+}
+#endif // #ifdef IMGUI_ENABLE_INI_SETTINGS_THREAD
+
+void ImGui::PreloadIniSettings()
+{
+#ifdef IMGUI_ENABLE_INI_SETTINGS_THREAD
+    ImGuiContext& g = *GImGui;
+    if (g.SettingsLoaded || !g.IO.IniFilename)
+        return;
+    ImGuiSettingsThread* st = GetSettingsThread();
+    {
+        std::lock_guard<std::mutex> lock(st->Mutex);
+        if (!st->LoadFilename.empty())
+            return;
+        SettingsThreadSetFilename(st->LoadFilename, g.IO.IniFilename);
+        st->LoadQueued = true;
+    }
+    st->WakeUp.notify_one();
+#endif
+}
+
 static void LoadIniSettingsFromDisk(const char* ini_filename)
 {
     if (!ini_filename)
         return;
-    char* file_data = (char*)ImFileLoadToMemory(ini_filename, "rb", NULL, +1);
+    char* file_data;
+    int file_size = 0;
+#ifdef IMGUI_ENABLE_INI_SETTINGS_THREAD
+    if (!SettingsThreadTakePreloadedFile(ini_filename, &file_data, &file_size))
+#endif
+        file_data = (char*)ImFileLoadToMemory(ini_filename, "rb", &file_size, +1);
     if (!file_data)
         return;
-    LoadIniSettingsFromMemory(file_data);
+    ImGui::LoadIniSettingsFromMemory(file_data, file_data + file_size);
     ImGui::MemFree(file_data);
 }
 
-ImGuiSettingsHandler* ImGui::FindSettingsHandler(const char* type_name)
+static ImGuiSettingsHandler* FindSettingsHandlerByHash(ImGuiID type_hash)
 {
     ImGuiContext& g = *GImGui;
-    const ImGuiID type_hash = ImHash(type_name, 0, 0);
     for (int handler_n = 0; handler_n < g.SettingsHandlers.Size; handler_n++)
         if (g.SettingsHandlers[handler_n].TypeHash == type_hash)
             return &g.SettingsHandlers[handler_n];
     return NULL;
 }
 
-// Zero-tolerance, no error reporting, cheap .ini parsing
-static void LoadIniSettingsFromMemory(const char* buf_readonly)
+ImGuiSettingsHandler* ImGui::FindSettingsHandler(const char* type_name)
 {
-    // For convenience and to make the code simpler, we'll write zero terminators inside the buffer. So let's create a writable copy.
-    char* buf = ImStrdup(buf_readonly);
-    char* buf_end = buf + strlen(buf);
+    return FindSettingsHandlerByHash(ImHash(type_name, 0, 0));
+}
 
+// Zero-tolerance, no error reporting, cheap .ini parsing
+// Single pass over the buffer, which is never copied nor modified: handlers are given ranges of the buffer.
+void ImGui::LoadIniSettingsFromMemory(const char* buf, const char* buf_end)
+{
     ImGuiContext& g = *GImGui;
+    if (!buf_end)
+        buf_end = buf + strlen(buf);
     void* entry_data = NULL;
     ImGuiSettingsHandler* entry_handler = NULL;
 
-    char* line_end = NULL;
-    for (char* line = buf; line < buf_end; line = line_end + 1)
+    for (const char* line = buf; line < buf_end; )
     {
-        // Skip new lines markers, then find end of the line
-        while (*line == '\n' || *line == '\r')
-            line++;
-        line_end = line;
-        while (line_end < buf_end && *line_end != '\n' && *line_end != '\r')
-            line_end++;
-        line_end[0] = 0;
+        // Find the end of the line, which may be terminated by "\n", "\r\n" or "\r". Empty lines are skipped.
+        const char* line_end = (const char*)memchr(line, '\n', (size_t)(buf_end - line));
+        if (!line_end)
+            line_end = buf_end;
+        if (const char* cr = (const char*)memchr(line, '\r', (size_t)(line_end - line)))
+            line_end = cr;
+        const char* next_line = line_end + 1;
+        if (line_end == line)
+        {
+            line = next_line;
+            continue;
+        }
 
-        if (line[0] == '[' && line_end > line && line_end[-1] == ']')
+        if (line[0] == '[' && line_end[-1] == ']')
         {
             // Parse "[Type][Name]". Note that 'Name' can itself contains [] characters, which is acceptable with the current format and parsing code.
-            line_end[-1] = 0;
-            const char* name_end = line_end - 1; 
+            const char* name_end = line_end - 1;
             const char* type_start = line + 1;
-            char* type_end = ImStrchrRange(type_start, name_end, ']');
+            const char* type_end = ImStrchrRange(type_start, name_end, ']');
             const char* name_start = type_end ? ImStrchrRange(type_end + 1, name_end, '[') : NULL;
             if (!type_end || !name_start)
             {
                 name_start = type_start; // Import legacy entries that have no type
                 type_start = "Window";
+                type_end = type_start + 6;
             }
             else
             {
-                *type_end = 0; // Overwrite first ']' 
                 name_start++;  // Skip second '['
             }
-            entry_handler = ImGui::FindSettingsHandler(type_start);
-            entry_data = entry_handler ? entry_handler->ReadOpenFn(&g, entry_handler, name_start) : NULL;
+
+            // Sections of a same type usually follow each other, so the handler is looked up only when the type changes
+            if (type_end == type_start)
+            {
+                entry_handler = NULL;
+            }
+            else
+            {
+                const ImGuiID type_hash = ImHash(type_start, (int)(type_end - type_start), 0);
+                if (!entry_handler || entry_handler->TypeHash != type_hash)
+                    entry_handler = FindSettingsHandlerByHash(type_hash);
+            }
+            entry_data = entry_handler ? entry_handler->ReadOpenFn(&g, entry_handler, name_start, name_end) : NULL;
         }
         else if (entry_handler != NULL && entry_data != NULL)
         {
             // Let type handler parse the line
-            entry_handler->ReadLineFn(&g, entry_handler, entry_data, line);
+            entry_handler->ReadLineFn(&g, entry_handler, entry_data, line, line_end);
         }
+        line = next_line;
     }
-    ImGui::MemFree(buf);
     g.SettingsLoaded = true;
 }
 
@@ -3763,11 +4812,18 @@ static void SaveIniSettingsToDisk(const char* ini_filename)
     ImVector<char> buf;
     SaveIniSettingsToMemory(buf);
 
-    FILE* f = ImFileOpen(ini_filename, "wt");
-    if (!f)
-        return;
-    fwrite(buf.Data, sizeof(char), (size_t)buf.Size, f);
-    fclose(f);
+#ifdef IMGUI_ENABLE_INI_SETTINGS_THREAD
+    ImGuiSettingsThread* st = GetSettingsThread();
+    {
+        std::lock_guard<std::mutex> lock(st->Mutex);
+        SettingsThreadSetFilename(st->SaveFilename, ini_filename);
+        st->SaveData.swap(buf); // Replaces the snapshot not written yet, if any
+        st->SaveQueued = true;
+    }
+    st->WakeUp.notify_one();
+#else
+    WriteIniSettingsFile(ini_filename, buf.Data, (size_t)buf.Size);
+#endif
 }
 
 static void SaveIniSettingsToMemory(ImVector<char>& out_buf)
@@ -4023,6 +5079,7 @@ void ImGui::EndFrame()
 
 void ImGui::Render()
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_DrawList);
     ImGuiContext& g = *GImGui;
     IM_ASSERT(g.Initialized);   // Forgot to call ImGui::NewFrame()
 
@@ -4079,6 +5136,18 @@ const char* ImGui::FindRenderedTextEnd(const char* text, const char* text_end)
     if (!text_end)
         text_end = (const char*)-1;
 
+#ifdef IMGUI_ENABLE_SSE
+    // Skip blocks of 16 characters containing neither '#' nor a zero terminator (only when the text length is known, so we never read past its end)
+    const __m128i hash_char = _mm_set1_epi8('#');
+    const __m128i zero = _mm_setzero_si128();
+    while (text_end != (const char*)-1 && text_end - text_display_end >= 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)text_display_end);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chars, hash_char), _mm_cmpeq_epi8(chars, zero))) != 0)
+            break;
+        text_display_end += 16;
+    }
+#endif
     while (text_display_end < text_end && *text_display_end != '\0' && (text_display_end[0] != '#' || text_display_end[1] != '#'))
         text_display_end++;
     return text_display_end;
@@ -4091,17 +5160,13 @@ void ImGui::LogText(const char* fmt, ...)
     if (!g.LogEnabled)
         return;
 
+    // Output to a file is buffered too, then written in large chunks
     va_list args;
     va_start(args, fmt);
-    if (g.LogFile)
-    {
-        vfprintf(g.LogFile, fmt, args);
-    }
-    else
-    {
-        g.LogClipboard->appendfv(fmt, args);
-    }
+    g.LogClipboard->appendfv(fmt, args);
     va_end(args);
+    if (g.LogFile && g.LogClipboard->size() >= IMGUI_LOG_FILE_CHUNK_SIZE)
+        LogFlushFileBuffer(g);
 }
 
 // Internal version that takes a position to decide on newline placement and pad items according to their depth.
@@ -5253,6 +6318,7 @@ ImGuiWindow* ImGui::FindWindowByName(const char* name)
 
 static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFlags flags)
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_Window);
     ImGuiContext& g = *GImGui;
 
     // Create window the first time
@@ -5555,6 +6621,7 @@ static void ImGui::UpdateManualResize(ImGuiWindow* window, const ImVec2& size_au
 // - Passing 'bool* p_open' displays a Close button on the upper-right corner of the window, the pointed value will be set to false when the button is pressed.
 bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_Window);
     ImGuiContext& g = *GImGui;
     const ImGuiStyle& style = g.Style;
     IM_ASSERT(name != NULL);                        // Window name required
@@ -5886,7 +6953,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 
         // Setup draw list and outer clipping rectangle
         window->DrawList->Clear();
-        window->DrawList->Flags = (g.Style.AntiAliasedLines ? ImDrawListFlags_AntiAliasedLines : 0) | (g.Style.AntiAliasedFill ? ImDrawListFlags_AntiAliasedFill : 0);
+        window->DrawList->Flags = (g.Style.AntiAliasedLines ? ImDrawListFlags_AntiAliasedLines : 0) | (g.Style.AntiAliasedFill ? ImDrawListFlags_AntiAliasedFill : 0) | ((g.IO.ConfigFlags & ImGuiConfigFlags_RendererHasAnalyticShapes) ? ImDrawListFlags_AnalyticShapes : 0);
         window->DrawList->PushTextureID(g.Font->ContainerAtlas->TexID);
         ImRect viewport_rect(GetViewportRect());
         if ((flags & ImGuiWindowFlags_ChildWindow) && !(flags & ImGuiWindowFlags_Popup) && !window_is_child_tooltip)
@@ -6186,6 +7253,7 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_first_use,
 
 void ImGui::End()
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_Window);
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = g.CurrentWindow;
 
@@ -7833,6 +8901,7 @@ void ImGui::LogToTTY(int max_depth)
 
     IM_ASSERT(g.LogFile == NULL);
     g.LogFile = stdout;
+    LogStartWriter(g);
     g.LogEnabled = true;
     g.LogStartDepth = window->DC.TreeDepth;
     if (max_depth >= 0)
@@ -7861,6 +8930,7 @@ void ImGui::LogToFile(int max_depth, const char* filename)
         IM_ASSERT(g.LogFile != NULL); // Consider this an error
         return;
     }
+    LogStartWriter(g);
     g.LogEnabled = true;
     g.LogStartDepth = window->DC.TreeDepth;
     if (max_depth >= 0)
@@ -7892,6 +8962,8 @@ void ImGui::LogFinish()
     LogText(IM_NEWLINE);
     if (g.LogFile != NULL)
     {
+        LogFlushFileBuffer(g);
+        LogStopWriter(g);
         if (g.LogFile == stdout)
             fflush(g.LogFile);
         else
@@ -7906,6 +8978,155 @@ void ImGui::LogFinish()
     g.LogEnabled = false;
 }
 
+#ifdef IMGUI_ENABLE_LOG_FILE_THREAD
+// Background writer of the log file.
+// Output is handed over in chunks through a ring of IMGUI_LOG_FILE_CHUNKS_COUNT slots without locking (the mutexes are only used to sleep): the UI thread fills empty slots in order,
+// the writer thread claims the oldest full slot by incrementing ReadIdx, swaps its buffer with its own and writes it with a single fwrite().
+struct ImGuiLogWriter
+{
+    enum { SlotState_Empty, SlotState_Full };
+    struct Slot
+    {
+        ImVector<char>      Data;           // Zero-terminated, as ImGuiTextBuffer::Buf
+        std::atomic<int>    State;
+    };
+    FILE*                   File;
+    Slot                    Slots[IMGUI_LOG_FILE_CHUNKS_COUNT];
+    unsigned int            WriteIdx;       // Next slot to fill, only used by the UI thread
+    std::atomic<unsigned int> ReadIdx;      // Next slot to write. Incremented by the writer thread, or by the UI thread dropping the oldest chunk.
+    std::atomic<bool>       Quit;
+    std::mutex              WakeUpMutex;    // Only used to sleep while there is nothing to write
+    std::condition_variable WakeUp;
+    std::mutex              SlotEmptiedMutex;   // Only used by the UI thread to sleep while the slot it wants to fill is full (ImGuiLogOverflow_Block)
+    std::condition_variable SlotEmptied;
+    std::thread             Thread;
+
+    ImGuiLogWriter(FILE* file) : ReadIdx(0), Quit(false)
+    {
+        File = file;
+        WriteIdx = 0;
+        for (int n = 0; n < IMGUI_LOG_FILE_CHUNKS_COUNT; n++)
+            Slots[n].State.store(SlotState_Empty);
+        Thread = std::thread(ThreadMain, this);
+    }
+    ~ImGuiLogWriter()
+    {
+        Quit.store(true);
+        WakeUp.notify_one();
+        Thread.join(); // Chunks still in the ring are written first
+    }
+
+    static void ThreadMain(ImGuiLogWriter* w)
+    {
+        GImAllocatorInWorkerThread = true;
+        ImVector<char> data;
+        for (;;)
+        {
+            const bool quit = w->Quit.load();
+            unsigned int read_idx = w->ReadIdx.load();
+            Slot& slot = w->Slots[read_idx % IMGUI_LOG_FILE_CHUNKS_COUNT];
+            if (slot.State.load(std::memory_order_acquire) == SlotState_Full)
+            {
+                // The UI thread may have dropped this chunk in the meantime, in which case we try again with the next one
+                if (w->ReadIdx.compare_exchange_strong(read_idx, read_idx + 1))
+                {
+                    slot.Data.swap(data);
+                    slot.State.store(SlotState_Empty, std::memory_order_release);
+                    { std::lock_guard<std::mutex> lock(w->SlotEmptiedMutex); }  // Taking the lock once makes sure a UI thread about to wait sees the slot empty, or gets notified
+                    w->SlotEmptied.notify_one();
+                    fwrite(data.Data, sizeof(char), (size_t)(data.Size - 1), w->File);
+                    data.resize(0);
+                }
+                continue;
+            }
+            if (quit)
+                break;
+            std::unique_lock<std::mutex> lock(w->WakeUpMutex);
+            w->WakeUp.wait_for(lock, std::chrono::milliseconds(10));
+        }
+        fflush(w->File);
+    }
+
+    // Hand a chunk over to the writer thread, applying io.LogFileOverflow when all slots are waiting to be written. 'buf' is left with an empty or unused buffer.
+    void Push(ImGuiContext& g, ImVector<char>& buf)
+    {
+        const int size = buf.Size - 1;
+        for (;;)
+        {
+            Slot& slot = Slots[WriteIdx % IMGUI_LOG_FILE_CHUNKS_COUNT];
+            if (slot.State.load(std::memory_order_acquire) == SlotState_Empty)
+            {
+                slot.Data.swap(buf);
+                slot.State.store(SlotState_Full, std::memory_order_release);
+                WriteIdx++;
+                g.LogBytesWritten += (ImU64)size;
+                WakeUp.notify_one();
+                return;
+            }
+
+            // All slots are full, or the writer thread is emptying the slot we want
+            if (g.IO.LogFileOverflow == ImGuiLogOverflow_DropNewest)
+            {
+                g.LogBytesDropped += (ImU64)size;
+                g.LogChunksDropped++;
+                return;
+            }
+            unsigned int oldest_idx = WriteIdx - IMGUI_LOG_FILE_CHUNKS_COUNT;
+            if (g.IO.LogFileOverflow == ImGuiLogOverflow_DropOldest && ReadIdx.compare_exchange_strong(oldest_idx, oldest_idx + 1))
+            {
+                // The writer thread hadn't claimed the oldest chunk, which sits in the slot we want
+                g.LogBytesWritten -= (ImU64)(slot.Data.Size - 1);
+                g.LogBytesDropped += (ImU64)(slot.Data.Size - 1);
+                g.LogChunksDropped++;
+                slot.Data.resize(0);
+                slot.State.store(SlotState_Empty, std::memory_order_relaxed);
+                continue;
+            }
+
+            // Wait for the writer thread to empty the slot
+            std::unique_lock<std::mutex> lock(SlotEmptiedMutex);
+            SlotEmptied.wait(lock, [&slot] { return slot.State.load(std::memory_order_acquire) == SlotState_Empty; });
+        }
+    }
+};
+#endif // #ifdef IMGUI_ENABLE_LOG_FILE_THREAD
+
+// Pass the output buffered by LogText() to the log file, or to its writer thread
+static void LogFlushFileBuffer(ImGuiContext& g)
+{
+    ImVector<char>& buf = g.LogClipboard->Buf;
+    if (buf.Size <= 1)
+        return;
+#ifdef IMGUI_ENABLE_LOG_FILE_THREAD
+    g.LogWriter->Push(g, buf);
+#else
+    fwrite(buf.Data, sizeof(char), (size_t)(buf.Size - 1), g.LogFile);
+    g.LogBytesWritten += (ImU64)(buf.Size - 1);
+#endif
+    buf.resize(0); // Keep the allocation
+    buf.push_back(0);
+}
+
+static void LogStartWriter(ImGuiContext& g)
+{
+#ifdef IMGUI_ENABLE_LOG_FILE_THREAD
+    IM_ASSERT(g.LogWriter == NULL);
+    g.LogWriter = IM_NEW(ImGuiLogWriter)(g.LogFile);
+#else
+    (void)g;
+#endif
+}
+
+// Wait for the writer thread to write everything passed to it
+static void LogStopWriter(ImGuiContext& g)
+{
+#ifdef IMGUI_ENABLE_LOG_FILE_THREAD
+    IM_DELETE(g.LogWriter);
+#else
+    (void)g;
+#endif
+}
+
 // Helper to display logging buttons
 void ImGui::LogButtons()
 {
@@ -9621,20 +10842,44 @@ namespace ImGuiStb
 static int     STB_TEXTEDIT_STRINGLEN(const STB_TEXTEDIT_STRING* obj)                             { return obj->CurLenW; }
 static ImWchar STB_TEXTEDIT_GETCHAR(const STB_TEXTEDIT_STRING* obj, int idx)                      { return obj->Text[idx]; }
 static float   STB_TEXTEDIT_GETWIDTH(STB_TEXTEDIT_STRING* obj, int line_start_idx, int char_idx)  { ImWchar c = obj->Text[line_start_idx+char_idx]; if (c == '\n') return STB_TEXTEDIT_GETWIDTH_NEWLINE; return GImGui->Font->GetCharAdvance(c) * (GImGui->FontSize / GImGui->Font->FontSize); }
-static int     STB_TEXTEDIT_KEYTOTEXT(int key)                                                    { return key >= 0x10000 ? 0 : key; }
+static int     STB_TEXTEDIT_KEYTOTEXT(int key)                                                    { return key >= 0x200000 ? 0 : key; }
 static ImWchar STB_TEXTEDIT_NEWLINE = '\n';
 static void    STB_TEXTEDIT_LAYOUTROW(StbTexteditRow* r, STB_TEXTEDIT_STRING* obj, int line_start_idx)
 {
+    // Rows are lines, their extent comes from the line index and their width is measured once until they are modified
+    const int line = obj->FindLine(line_start_idx);
+    ImGuiTextEditLine& line_data = obj->Lines[line];
+    const int line_end_idx = (line + 1 < obj->Lines.Size) ? obj->Lines[line + 1].StartW : obj->CurLenW;
     const ImWchar* text = obj->Text.Data;
-    const ImWchar* text_remaining = NULL;
-    const ImVec2 size = InputTextCalcTextSizeW(text + line_start_idx, text + obj->CurLenW, &text_remaining, NULL, true);
+    float width;
+    if (line_data.StartW != line_start_idx)
+        width = InputTextCalcTextSizeW(text + line_start_idx, text + line_end_idx, NULL, NULL, true).x;
+    else if ((width = line_data.Width) < 0.0f)
+        width = line_data.Width = InputTextCalcTextSizeW(text + line_start_idx, text + line_end_idx, NULL, NULL, true).x;
     r->x0 = 0.0f;
-    r->x1 = size.x;
-    r->baseline_y_delta = size.y;
+    r->x1 = width;
+    r->baseline_y_delta = GImGui->FontSize;
     r->ymin = 0.0f;
-    r->ymax = size.y;
-    r->num_chars = (int)(text_remaining - (text + line_start_idx));
+    r->ymax = GImGui->FontSize;
+    r->num_chars = line_end_idx - line_start_idx;
+}
+
+static void STB_TEXTEDIT_SEEKROW_Y_IMPL(STB_TEXTEDIT_STRING* obj, float y, int* row_start, float* row_y)
+{
+    const int line = (y > 0.0f) ? ImMin((int)(y / GImGui->FontSize), obj->Lines.Size - 1) : 0;
+    *row_start = obj->Lines[line].StartW;
+    *row_y = line * GImGui->FontSize;
+}
+
+static void STB_TEXTEDIT_SEEKROW_CHAR_IMPL(STB_TEXTEDIT_STRING* obj, int char_idx, int* row_start, int* prev_row_start, float* row_y)
+{
+    const int line = obj->FindLine(char_idx);
+    *row_start = obj->Lines[line].StartW;
+    *prev_row_start = obj->Lines[line > 0 ? line - 1 : 0].StartW;
+    *row_y = line * GImGui->FontSize;
 }
+#define STB_TEXTEDIT_SEEKROW_Y      STB_TEXTEDIT_SEEKROW_Y_IMPL       // They need to be #define for stb_textedit.h
+#define STB_TEXTEDIT_SEEKROW_CHAR   STB_TEXTEDIT_SEEKROW_CHAR_IMPL
 
 static bool is_separator(unsigned int c)                                        { return ImCharIsSpace(c) || c==',' || c==';' || c=='(' || c==')' || c=='{' || c=='}' || c=='[' || c==']' || c=='|'; }
 static int  is_word_boundary_from_right(STB_TEXTEDIT_STRING* obj, int idx)      { return idx > 0 ? (is_separator( obj->Text[idx-1] ) && !is_separator( obj->Text[idx] ) ) : 1; }
@@ -9650,17 +10895,31 @@ static int  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL(STB_TEXTEDIT_STRING* obj, int idx)
 
 static void STB_TEXTEDIT_DELETECHARS(STB_TEXTEDIT_STRING* obj, int pos, int n)
 {
-    ImWchar* dst = obj->Text.Data + pos;
-
-    // We maintain our buffer length in both UTF-8 and wchar formats
-    obj->CurLenA -= ImTextCountUtf8BytesFromStr(dst, dst + n);
+    ImWchar* text = obj->Text.Data;
+    char* text_a = obj->TextA.Data;
+    const int pos_a = obj->GetOffsetA(pos);
+    const int n_a = ImTextCountUtf8BytesFromStr(text + pos, text + pos + n);
+
+    // Remove the lines starting after one of the deleted '\n', shift the following ones
+    ImVector<ImGuiTextEditLine>& lines = obj->Lines;
+    const int first_line = obj->FindLine(pos);
+    const int last_line = obj->FindLine(pos + n);
+    if (last_line > first_line)
+        memmove(lines.Data + first_line + 1, lines.Data + last_line + 1, (size_t)(lines.Size - last_line - 1) * sizeof(ImGuiTextEditLine));
+    lines.resize(lines.Size - (last_line - first_line));
+    lines[first_line].Width = -1.0f;
+    for (int line = first_line + 1; line < lines.Size; line++)
+    {
+        lines[line].StartW -= n;
+        lines[line].StartA -= n_a;
+    }
+
+    // We maintain our buffer in both UTF-8 and wchar formats (including their zero-terminator)
+    memmove(text + pos, text + pos + n, (size_t)(obj->CurLenW - pos - n + 1) * sizeof(ImWchar));
+    memmove(text_a + pos_a, text_a + pos_a + n_a, (size_t)(obj->CurLenA - pos_a - n_a + 1));
     obj->CurLenW -= n;
-
-    // Offset remaining text
-    const ImWchar* src = obj->Text.Data + pos + n;
-    while (ImWchar c = *src++)
-        *dst++ = c;
-    *dst = '\0';
+    obj->CurLenA -= n_a;
+    obj->TextAIsDirty = true;
 }
 
 static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const ImWchar* new_text, int new_text_len)
@@ -9679,29 +10938,70 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
         memmove(text + pos + new_text_len, text + pos, (size_t)(text_len - pos) * sizeof(ImWchar));
     memcpy(text + pos, new_text, (size_t)new_text_len * sizeof(ImWchar));
 
+    // Same insertion in the UTF-8 buffer. ImTextStrToUtf8() writes a zero-terminator after the new text so we restore the character it overwrites.
+    const int pos_a = obj->GetOffsetA(pos);
+    char* text_a = obj->TextA.Data;
+    memmove(text_a + pos_a + new_text_len_utf8, text_a + pos_a, (size_t)(obj->CurLenA - pos_a + 1));
+    const char c_after = text_a[pos_a + new_text_len_utf8];
+    ImTextStrToUtf8(text_a + pos_a, new_text_len_utf8 + 1, new_text, new_text + new_text_len);
+    text_a[pos_a + new_text_len_utf8] = c_after;
+
+    // Shift the following lines, then insert one line per new '\n'
+    ImVector<ImGuiTextEditLine>& lines = obj->Lines;
+    const int line = obj->FindLine(pos);
+    lines[line].Width = -1.0f;
+    for (int n = line + 1; n < lines.Size; n++)
+    {
+        lines[n].StartW += new_text_len;
+        lines[n].StartA += new_text_len_utf8;
+    }
+    int new_lines_count = 0;
+    for (int n = 0; n < new_text_len; n++)
+        if (new_text[n] == '\n')
+            new_lines_count++;
+    if (new_lines_count > 0)
+    {
+        lines.resize(lines.Size + new_lines_count);
+        memmove(lines.Data + line + 1 + new_lines_count, lines.Data + line + 1, (size_t)(lines.Size - line - 1 - new_lines_count) * sizeof(ImGuiTextEditLine));
+        ImGuiTextEditLine* new_line = lines.Data + line + 1;
+        int offset_a = pos_a;
+        for (int n = 0; n < new_text_len; n++)
+        {
+            const unsigned int c = (unsigned int)new_text[n];
+            offset_a += (c < 0x80) ? 1 : ImTextCountUtf8BytesFromChar(c);
+            if (c != '\n')
+                continue;
+            new_line->StartW = pos + n + 1;
+            new_line->StartA = offset_a;
+            new_line->Width = -1.0f;
+            new_line++;
+        }
+    }
+
     obj->CurLenW += new_text_len;
     obj->CurLenA += new_text_len_utf8;
     obj->Text[obj->CurLenW] = '\0';
+    obj->TextAIsDirty = true;
 
     return true;
 }
 
 // We don't use an enum so we can build even with conflicting symbols (if another user of stb_textedit.h leak their STB_TEXTEDIT_K_* symbols)
-#define STB_TEXTEDIT_K_LEFT         0x10000 // keyboard input to move cursor left
-#define STB_TEXTEDIT_K_RIGHT        0x10001 // keyboard input to move cursor right
-#define STB_TEXTEDIT_K_UP           0x10002 // keyboard input to move cursor up
-#define STB_TEXTEDIT_K_DOWN         0x10003 // keyboard input to move cursor down
-#define STB_TEXTEDIT_K_LINESTART    0x10004 // keyboard input to move cursor to start of line
-#define STB_TEXTEDIT_K_LINEEND      0x10005 // keyboard input to move cursor to end of line
-#define STB_TEXTEDIT_K_TEXTSTART    0x10006 // keyboard input to move cursor to start of text
-#define STB_TEXTEDIT_K_TEXTEND      0x10007 // keyboard input to move cursor to end of text
-#define STB_TEXTEDIT_K_DELETE       0x10008 // keyboard input to delete selection or character under cursor
-#define STB_TEXTEDIT_K_BACKSPACE    0x10009 // keyboard input to delete selection or character left of cursor
-#define STB_TEXTEDIT_K_UNDO         0x1000A // keyboard input to perform undo
-#define STB_TEXTEDIT_K_REDO         0x1000B // keyboard input to perform redo
-#define STB_TEXTEDIT_K_WORDLEFT     0x1000C // keyboard input to move cursor left one word
-#define STB_TEXTEDIT_K_WORDRIGHT    0x1000D // keyboard input to move cursor right one word
-#define STB_TEXTEDIT_K_SHIFT        0x20000
+#define STB_TEXTEDIT_K_LEFT         0x200000 // keyboard input to move cursor left
+#define STB_TEXTEDIT_K_RIGHT        0x200001 // keyboard input to move cursor right
+#define STB_TEXTEDIT_K_UP           0x200002 // keyboard input to move cursor up
+#define STB_TEXTEDIT_K_DOWN         0x200003 // keyboard input to move cursor down
+#define STB_TEXTEDIT_K_LINESTART    0x200004 // keyboard input to move cursor to start of line
+#define STB_TEXTEDIT_K_LINEEND      0x200005 // keyboard input to move cursor to end of line
+#define STB_TEXTEDIT_K_TEXTSTART    0x200006 // keyboard input to move cursor to start of text
+#define STB_TEXTEDIT_K_TEXTEND      0x200007 // keyboard input to move cursor to end of text
+#define STB_TEXTEDIT_K_DELETE       0x200008 // keyboard input to delete selection or character under cursor
+#define STB_TEXTEDIT_K_BACKSPACE    0x200009 // keyboard input to delete selection or character left of cursor
+#define STB_TEXTEDIT_K_UNDO         0x20000A // keyboard input to perform undo
+#define STB_TEXTEDIT_K_REDO         0x20000B // keyboard input to perform redo
+#define STB_TEXTEDIT_K_WORDLEFT     0x20000C // keyboard input to move cursor left one word
+#define STB_TEXTEDIT_K_WORDRIGHT    0x20000D // keyboard input to move cursor right one word
+#define STB_TEXTEDIT_K_SHIFT        0x400000
 
 #define STB_TEXTEDIT_IMPLEMENTATION
 #include "stb_textedit.h"
@@ -9715,6 +11015,63 @@ void ImGuiTextEditState::OnKeyPressed(int key)
     CursorAnimReset();
 }
 
+void ImGuiTextEditState::SetText(const char* text)
+{
+    // Text is sized by the caller. TextA holds the UTF-8 form of Text which may differ from 'text' if it is malformed.
+    CurLenW = ImTextStrFromUtf8(Text.Data, Text.Size, text, NULL);
+    TextA.resize(Text.Size * 4);
+    CurLenA = ImTextStrToUtf8(TextA.Data, TextA.Size, Text.Data, NULL);
+    TextAIsDirty = true;
+
+    Lines.resize(0);
+    ImGuiTextEditLine line = { 0, 0, -1.0f };
+    Lines.push_back(line);
+    for (int n = 0, offset_a = 0; n < CurLenW; n++)
+    {
+        const unsigned int c = (unsigned int)Text[n];
+        offset_a += (c < 0x80) ? 1 : ImTextCountUtf8BytesFromChar(c);
+        if (c != '\n')
+            continue;
+        line.StartW = n + 1;
+        line.StartA = offset_a;
+        Lines.push_back(line);
+    }
+}
+
+int ImGuiTextEditState::FindLine(int pos_w) const
+{
+    int lo = 0, hi = Lines.Size - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi + 1) >> 1;
+        if (Lines[mid].StartW <= pos_w)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
+int ImGuiTextEditState::GetOffsetA(int pos_w) const
+{
+    const ImGuiTextEditLine& line = Lines[FindLine(pos_w)];
+    return line.StartA + ImTextCountUtf8BytesFromStr(Text.Data + line.StartW, Text.Data + pos_w);
+}
+
+int ImGuiTextEditState::GetOffsetW(int pos_a) const
+{
+    int lo = 0, hi = Lines.Size - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi + 1) >> 1;
+        if (Lines[mid].StartA <= pos_a)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return Lines[lo].StartW + ImTextCountCharsFromUtf8(TextA.Data + Lines[lo].StartA, TextA.Data + pos_a);
+}
+
 // Public API to manipulate UTF-8 text
 // We expose UTF-8 to the user (unlike the STB_TEXTEDIT_* functions which are manipulating wchar)
 // FIXME: The existence of this rarely exercised code path is a bit of a nuisance.
@@ -9813,6 +11170,7 @@ static bool InputTextFilterCharacter(unsigned int* p_char, ImGuiInputTextFlags f
 // FIXME: Rather messy function partly because we are doing UTF8 > u16 > UTF8 conversions on the go to more easily handle stb_textedit calls. Ideally we should stay in UTF-8 all the time. See https://github.com/nothings/stb/issues/188
 bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2& size_arg, ImGuiInputTextFlags flags, ImGuiTextEditCallback callback, void* user_data)
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_Text);
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
         return false;
@@ -9863,6 +11221,8 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
     // Password pushes a temporary font with only a fallback glyph
     if (is_password)
     {
+        if (g.Font->DynamicGlyphs)
+            g.Font->ContainerAtlas->TouchDynamicGlyph(g.Font, '*');
         const ImFontGlyph* glyph = g.Font->FindGlyph('*');
         ImFont* password_font = &g.InputTextPasswordFont;
         password_font->FontSize = g.Font->FontSize;
@@ -9873,7 +11233,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
         password_font->ContainerAtlas = g.Font->ContainerAtlas;
         password_font->FallbackGlyph = glyph;
         password_font->FallbackAdvanceX = glyph->AdvanceX;
-        IM_ASSERT(password_font->Glyphs.empty() && password_font->IndexAdvanceX.empty() && password_font->IndexLookup.empty());
+        IM_ASSERT(password_font->Glyphs.empty() && password_font->IndexPageMap.empty() && password_font->IndexPages.empty());
         PushFont(password_font);
     }
 
@@ -9901,9 +11261,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             edit_state.Text.resize(buf_size+1);        // wchar count <= UTF-8 count. we use +1 to make sure that .Data isn't NULL so it doesn't crash.
             edit_state.InitialText.resize(buf_size+1); // UTF-8. we use +1 to make sure that .Data isn't NULL so it doesn't crash.
             ImStrncpy(edit_state.InitialText.Data, buf, edit_state.InitialText.Size);
-            const char* buf_end = NULL;
-            edit_state.CurLenW = ImTextStrFromUtf8(edit_state.Text.Data, edit_state.Text.Size, buf, NULL, &buf_end);
-            edit_state.CurLenA = (int)(buf_end - buf); // We can't get the result from ImFormatString() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+            edit_state.SetText(buf); // This is the only full conversion of the text, the UTF-8 copy and line index are then updated by each edit.
             edit_state.CursorAnimReset();
 
             // Preserve cursor position and undo/redo stack if we come back to same widget
@@ -9945,17 +11303,25 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
 
     if (g.ActiveId == id)
     {
-        if (!is_editable && !g.ActiveIdIsJustActivated)
+        if (!is_editable && !g.ActiveIdIsJustActivated && strcmp(edit_state.TextA.Data, buf) != 0)
         {
             // When read-only we always use the live data passed to the function
             edit_state.Text.resize(buf_size+1);
-            const char* buf_end = NULL;
-            edit_state.CurLenW = ImTextStrFromUtf8(edit_state.Text.Data, edit_state.Text.Size, buf, NULL, &buf_end);
-            edit_state.CurLenA = (int)(buf_end - buf);
+            edit_state.SetText(buf);
             edit_state.CursorClamp();
         }
 
         edit_state.BufSizeA = buf_size;
+        if (edit_state.TextA.Size < buf_size + 1)
+            edit_state.TextA.resize(buf_size + 1);
+        if (edit_state.LinesFont != g.Font || edit_state.LinesFontSize != g.FontSize)
+        {
+            // Cached line widths depend on the font
+            for (int n = 0; n < edit_state.Lines.Size; n++)
+                edit_state.Lines[n].Width = -1.0f;
+            edit_state.LinesFont = g.Font;
+            edit_state.LinesFontSize = g.FontSize;
+        }
 
         // Although we are active we don't prevent mouse from hovering other elements unless we are interacting right now with the widget.
         // Down the line we should have a cleaner library-wide concept of Selected vs Active.
@@ -10106,7 +11472,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
                     s += ImTextCharFromUtf8(&c, s, NULL);
                     if (c == 0)
                         break;
-                    if (c >= 0x10000 || !InputTextFilterCharacter(&c, flags, callback, user_data))
+                    if (c > IM_UNICODE_CODEPOINT_MAX || !InputTextFilterCharacter(&c, flags, callback, user_data))
                         continue;
                     clipboard_filtered[clipboard_filtered_len++] = (ImWchar)c;
                 }
@@ -10140,13 +11506,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
         {
             // Apply new value immediately - copy modified buffer back
             // Note that as soon as the input box is active, the in-widget value gets priority over any underlying modification of the input buffer
-            // FIXME: We actually always render 'buf' when calling DrawList->AddText, making the comment above incorrect.
-            // FIXME-OPT: CPU waste to do this every time the widget is active, should mark dirty state from the stb_textedit callbacks.
-            if (is_editable)
-            {
-                edit_state.TempTextBuffer.resize(edit_state.Text.Size * 4);
-                ImTextStrToUtf8(edit_state.TempTextBuffer.Data, edit_state.TempTextBuffer.Size, edit_state.Text.Data, NULL);
-            }
+            // TextA is updated along with Text by the stb_textedit callbacks, which mark it dirty so we only copy it back after an edit.
 
             // User callback
             if ((flags & (ImGuiInputTextFlags_CallbackCompletion | ImGuiInputTextFlags_CallbackHistory | ImGuiInputTextFlags_CallbackAlways)) != 0)
@@ -10184,42 +11544,44 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
                     callback_data.ReadOnly = !is_editable;
 
                     callback_data.EventKey = event_key;
-                    callback_data.Buf = edit_state.TempTextBuffer.Data;
+                    callback_data.Buf = edit_state.TextA.Data;
                     callback_data.BufTextLen = edit_state.CurLenA;
                     callback_data.BufSize = edit_state.BufSizeA;
                     callback_data.BufDirty = false;
 
-                    // We have to convert from wchar-positions to UTF-8-positions, which can be pretty slow (an incentive to ditch the ImWchar buffer, see https://github.com/nothings/stb/issues/188)
-                    ImWchar* text = edit_state.Text.Data;
-                    const int utf8_cursor_pos = callback_data.CursorPos = ImTextCountUtf8BytesFromStr(text, text + edit_state.StbState.cursor);
-                    const int utf8_selection_start = callback_data.SelectionStart = ImTextCountUtf8BytesFromStr(text, text + edit_state.StbState.select_start);
-                    const int utf8_selection_end = callback_data.SelectionEnd = ImTextCountUtf8BytesFromStr(text, text + edit_state.StbState.select_end);
+                    // We have to convert from wchar-positions to UTF-8-positions, the line index makes it cheap
+                    const int utf8_cursor_pos = callback_data.CursorPos = edit_state.GetOffsetA(edit_state.StbState.cursor);
+                    const int utf8_selection_start = callback_data.SelectionStart = edit_state.GetOffsetA(edit_state.StbState.select_start);
+                    const int utf8_selection_end = callback_data.SelectionEnd = edit_state.GetOffsetA(edit_state.StbState.select_end);
 
                     // Call user code
                     callback(&callback_data);
 
                     // Read back what user may have modified
-                    IM_ASSERT(callback_data.Buf == edit_state.TempTextBuffer.Data);  // Invalid to modify those fields
+                    IM_ASSERT(callback_data.Buf == edit_state.TextA.Data);  // Invalid to modify those fields
                     IM_ASSERT(callback_data.BufSize == edit_state.BufSizeA);
                     IM_ASSERT(callback_data.Flags == flags);
-                    if (callback_data.CursorPos != utf8_cursor_pos)            edit_state.StbState.cursor = ImTextCountCharsFromUtf8(callback_data.Buf, callback_data.Buf + callback_data.CursorPos);
-                    if (callback_data.SelectionStart != utf8_selection_start)  edit_state.StbState.select_start = ImTextCountCharsFromUtf8(callback_data.Buf, callback_data.Buf + callback_data.SelectionStart);
-                    if (callback_data.SelectionEnd != utf8_selection_end)      edit_state.StbState.select_end = ImTextCountCharsFromUtf8(callback_data.Buf, callback_data.Buf + callback_data.SelectionEnd);
                     if (callback_data.BufDirty)
                     {
                         IM_ASSERT(callback_data.BufTextLen == (int)strlen(callback_data.Buf)); // You need to maintain BufTextLen if you change the text!
-                        edit_state.CurLenW = ImTextStrFromUtf8(edit_state.Text.Data, edit_state.Text.Size, callback_data.Buf, NULL);
-                        edit_state.CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
+                        edit_state.SetText(callback_data.Buf);
                         edit_state.CursorAnimReset();
                     }
+                    if (callback_data.CursorPos != utf8_cursor_pos)            edit_state.StbState.cursor = edit_state.GetOffsetW(callback_data.CursorPos);
+                    if (callback_data.SelectionStart != utf8_selection_start)  edit_state.StbState.select_start = edit_state.GetOffsetW(callback_data.SelectionStart);
+                    if (callback_data.SelectionEnd != utf8_selection_end)      edit_state.StbState.select_end = edit_state.GetOffsetW(callback_data.SelectionEnd);
                 }
             }
 
             // Copy back to user buffer
-            if (is_editable && strcmp(edit_state.TempTextBuffer.Data, buf) != 0)
+            if (is_editable && edit_state.TextAIsDirty)
             {
-                ImStrncpy(buf, edit_state.TempTextBuffer.Data, buf_size);
-                value_changed = true;
+                edit_state.TextAIsDirty = false;
+                if (strcmp(edit_state.TextA.Data, buf) != 0)
+                {
+                    ImStrncpy(buf, edit_state.TextA.Data, buf_size);
+                    value_changed = true;
+                }
             }
         }
     }
@@ -10230,7 +11592,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
 
     // Render
     // Select which buffer we are going to display. When ImGuiInputTextFlags_NoLiveEdit is set 'buf' might still be the old value. We set buf to NULL to prevent accidental usage from now on.
-    const char* buf_display = (g.ActiveId == id && is_editable) ? edit_state.TempTextBuffer.Data : buf; buf = NULL; 
+    const char* buf_display = (g.ActiveId == id && is_editable) ? edit_state.TextA.Data : buf; buf = NULL; 
 
     RenderNavHighlight(frame_bb, id);
     if (!is_multiline)
@@ -10248,52 +11610,28 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
         // - Display the text (this alone can be more easily clipped)
         // - Handle scrolling, highlight selection, display cursor (those all requires some form of 1d->2d cursor position calculation)
         // - Measure text height (for scrollbar)
-        // We are attempting to do most of that in **one main pass** to minimize the computation cost (non-negligible for large amount of text) + 2nd pass for selection rendering (we could merge them by an extra refactoring effort)
-        // FIXME: This should occur on buf_display but we'd need to maintain cursor/select_start/select_end for UTF-8.
+        // The line index gives us the line of any position and the number of lines, so we only ever process the lines holding the cursor/selection start and the visible ones.
         const ImWchar* text_begin = edit_state.Text.Data;
+        const char* text_display = edit_state.TextA.Data;
         ImVec2 cursor_offset, select_start_offset;
+        int select_start_line = 0;
 
         {
-            // Count lines + find lines numbers straddling 'cursor' and 'select_start' position.
-            const ImWchar* searches_input_ptr[2];
-            searches_input_ptr[0] = text_begin + edit_state.StbState.cursor;
-            searches_input_ptr[1] = NULL;
-            int searches_remaining = 1;
-            int searches_result_line_number[2] = { -1, -999 };
+            // Find lines holding 'cursor' and 'select_start' position, then calculate 2d position by measuring distance from the beginning of the line
+            const int cursor_line = edit_state.FindLine(edit_state.StbState.cursor);
+            cursor_offset.x = InputTextCalcTextSizeW(text_begin + edit_state.Lines[cursor_line].StartW, text_begin + edit_state.StbState.cursor).x;
+            cursor_offset.y = (cursor_line + 1) * g.FontSize;
             if (edit_state.StbState.select_start != edit_state.StbState.select_end)
             {
-                searches_input_ptr[1] = text_begin + ImMin(edit_state.StbState.select_start, edit_state.StbState.select_end);
-                searches_result_line_number[1] = -1;
-                searches_remaining++;
-            }
-
-            // Iterate all lines to find our line numbers
-            // In multi-line mode, we never exit the loop until all lines are counted, so add one extra to the searches_remaining counter.
-            searches_remaining += is_multiline ? 1 : 0;
-            int line_count = 0;
-            for (const ImWchar* s = text_begin; *s != 0; s++)
-                if (*s == '\n')
-                {
-                    line_count++;
-                    if (searches_result_line_number[0] == -1 && s >= searches_input_ptr[0]) { searches_result_line_number[0] = line_count; if (--searches_remaining <= 0) break; }
-                    if (searches_result_line_number[1] == -1 && s >= searches_input_ptr[1]) { searches_result_line_number[1] = line_count; if (--searches_remaining <= 0) break; }
-                }
-            line_count++;
-            if (searches_result_line_number[0] == -1) searches_result_line_number[0] = line_count;
-            if (searches_result_line_number[1] == -1) searches_result_line_number[1] = line_count;
-
-            // Calculate 2d position by finding the beginning of the line and measuring distance
-            cursor_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[0], text_begin), searches_input_ptr[0]).x;
-            cursor_offset.y = searches_result_line_number[0] * g.FontSize;
-            if (searches_result_line_number[1] >= 0)
-            {
-                select_start_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[1], text_begin), searches_input_ptr[1]).x;
-                select_start_offset.y = searches_result_line_number[1] * g.FontSize;
+                const int select_start = ImMin(edit_state.StbState.select_start, edit_state.StbState.select_end);
+                select_start_line = edit_state.FindLine(select_start);
+                select_start_offset.x = InputTextCalcTextSizeW(text_begin + edit_state.Lines[select_start_line].StartW, text_begin + select_start).x;
+                select_start_offset.y = (select_start_line + 1) * g.FontSize;
             }
 
             // Store text height (note that we haven't calculated text width at all, see GitHub issues #383, #1224)
             if (is_multiline)
-                text_size = ImVec2(size.x, line_count * g.FontSize);
+                text_size = ImVec2(size.x, edit_state.Lines.Size * g.FontSize);
         }
 
         // Scroll
@@ -10329,6 +11667,14 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
         edit_state.CursorFollow = false;
         const ImVec2 render_scroll = ImVec2(edit_state.ScrollX, 0.0f);
 
+        // Range of visible lines
+        int visible_line_begin = 0, visible_line_end = edit_state.Lines.Size;
+        if (is_multiline)
+        {
+            visible_line_begin = ImClamp((int)((draw_window->ClipRect.Min.y - render_pos.y) / g.FontSize), 0, edit_state.Lines.Size);
+            visible_line_end = ImClamp((int)((draw_window->ClipRect.Max.y - render_pos.y) / g.FontSize) + 1, visible_line_begin, edit_state.Lines.Size);
+        }
+
         // Draw selection
         if (edit_state.StbState.select_start != edit_state.StbState.select_end)
         {
@@ -10339,7 +11685,15 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
             ImU32 bg_color = GetColorU32(ImGuiCol_TextSelectedBg);
             ImVec2 rect_pos = render_pos + select_start_offset - render_scroll;
-            for (const ImWchar* p = text_selected_begin; p < text_selected_end; )
+            const ImWchar* p = text_selected_begin;
+            if (visible_line_begin > select_start_line + 1)
+            {
+                // Skip the selected lines above the visible ones
+                const int line = visible_line_begin - 1;
+                p = (text_begin + edit_state.Lines[line].StartW < text_selected_end) ? text_begin + edit_state.Lines[line].StartW : text_selected_end;
+                rect_pos = ImVec2(render_pos.x - render_scroll.x, render_pos.y + (line + 1) * g.FontSize);
+            }
+            while (p < text_selected_end)
             {
                 if (rect_pos.y > clip_rect.w + g.FontSize)
                     break;
@@ -10363,7 +11717,13 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             }
         }
 
-        draw_window->DrawList->AddText(g.Font, g.FontSize, render_pos - render_scroll, GetColorU32(ImGuiCol_Text), buf_display, buf_display + edit_state.CurLenA, 0.0f, is_multiline ? NULL : &clip_rect);
+        // Draw visible lines only
+        if (visible_line_begin < visible_line_end)
+        {
+            const char* line_text_begin = text_display + edit_state.Lines[visible_line_begin].StartA;
+            const char* line_text_end = (visible_line_end < edit_state.Lines.Size) ? text_display + edit_state.Lines[visible_line_end].StartA : text_display + edit_state.CurLenA;
+            draw_window->DrawList->AddText(g.Font, g.FontSize, render_pos - render_scroll + ImVec2(0.0f, visible_line_begin * g.FontSize), GetColorU32(ImGuiCol_Text), line_text_begin, line_text_end, 0.0f, is_multiline ? NULL : &clip_rect);
+        }
 
         // Draw blinking cursor
         bool cursor_is_visible = (!g.IO.OptCursorBlink) || (g.InputTextState.CursorAnim <= 0.0f) || fmodf(g.InputTextState.CursorAnim, 1.20f) <= 0.80f;
@@ -12983,7 +14343,7 @@ void ImGui::EndDragDropTarget()
 // PLATFORM DEPENDENT HELPERS
 //-----------------------------------------------------------------------------
 
-#if defined(_WIN32) && !defined(_WINDOWS_) && (!defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS) || !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS))
+#if defined(_WIN32) && !defined(_WINDOWS_)
 #undef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #ifndef __MINGW32__
@@ -12993,6 +14353,26 @@ void ImGui::EndDragDropTarget()
 #endif
 #endif
 
+// File replacement, used to save the .ini file without ever leaving a partially written file
+#if defined(_WIN32) && !defined(__CYGWIN__)
+bool ImFileReplace(const char* src_filename, const char* dst_filename)
+{
+    // Same UTF-8 to UTF-16 conversion as ImFileOpen()
+    const int src_wsize = ImTextCountUtf16UnitsFromUtf8(src_filename, NULL) + 1;
+    const int dst_wsize = ImTextCountUtf16UnitsFromUtf8(dst_filename, NULL) + 1;
+    ImVector<wchar_t> buf;
+    buf.resize(src_wsize + dst_wsize);
+    ImTextStrToUtf16(&buf[0], src_wsize, src_filename, NULL);
+    ImTextStrToUtf16(&buf[src_wsize], dst_wsize, dst_filename, NULL);
+    return MoveFileExW(&buf[0], &buf[src_wsize], MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+#else
+bool ImFileReplace(const char* src_filename, const char* dst_filename)
+{
+    return rename(src_filename, dst_filename) == 0;
+}
+#endif
+
 // Win32 API clipboard implementation
 #if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS)
 
@@ -13002,7 +14382,7 @@ void ImGui::EndDragDropTarget()
 
 static const char* GetClipboardTextFn_DefaultImpl(void*)
 {
-    static ImVector<char> buf_local;
+    ImVector<char>& buf_local = GImGui->PrivateClipboard; // Per-context storage for the returned text
     buf_local.clear();
     if (!OpenClipboard(NULL))
         return NULL;
@@ -13012,11 +14392,11 @@ static const char* GetClipboardTextFn_DefaultImpl(void*)
         CloseClipboard();
         return NULL;
     }
-    if (ImWchar* wbuf_global = (ImWchar*)GlobalLock(wbuf_handle))
+    if (const wchar_t* wbuf_global = (const wchar_t*)GlobalLock(wbuf_handle))
     {
-        int buf_len = ImTextCountUtf8BytesFromStr(wbuf_global, NULL) + 1;
+        int buf_len = ImTextCountUtf8BytesFromUtf16(wbuf_global, NULL) + 1;
         buf_local.resize(buf_len);
-        ImTextStrToUtf8(buf_local.Data, buf_len, wbuf_global, NULL);
+        ImTextStrFromUtf16(buf_local.Data, buf_len, wbuf_global, NULL);
     }
     GlobalUnlock(wbuf_handle);
     CloseClipboard();
@@ -13027,15 +14407,15 @@ static void SetClipboardTextFn_DefaultImpl(void*, const char* text)
 {
     if (!OpenClipboard(NULL))
         return;
-    const int wbuf_length = ImTextCountCharsFromUtf8(text, NULL) + 1;
-    HGLOBAL wbuf_handle = GlobalAlloc(GMEM_MOVEABLE, (SIZE_T)wbuf_length * sizeof(ImWchar));
+    const int wbuf_length = ImTextCountUtf16UnitsFromUtf8(text, NULL) + 1;
+    HGLOBAL wbuf_handle = GlobalAlloc(GMEM_MOVEABLE, (SIZE_T)wbuf_length * sizeof(wchar_t));
     if (wbuf_handle == NULL)
     {
         CloseClipboard();
         return;
     }
-    ImWchar* wbuf_global = (ImWchar*)GlobalLock(wbuf_handle);
-    ImTextStrFromUtf8(wbuf_global, wbuf_length, text, NULL);
+    wchar_t* wbuf_global = (wchar_t*)GlobalLock(wbuf_handle);
+    ImTextStrToUtf16(wbuf_global, wbuf_length, text, NULL);
     GlobalUnlock(wbuf_handle);
     EmptyClipboard();
     SetClipboardData(CF_UNICODETEXT, wbuf_handle);
@@ -13103,9 +14483,8 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         ImGui::Text("Dear ImGui %s", ImGui::GetVersion());
         ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
         ImGui::Text("%d vertices, %d indices (%d triangles)", ImGui::GetIO().MetricsRenderVertices, ImGui::GetIO().MetricsRenderIndices, ImGui::GetIO().MetricsRenderIndices / 3);
-        ImGui::Text("%d allocations", (int)GImAllocatorActiveAllocationsCount);
-        static bool show_clip_rects = true;
-        ImGui::Checkbox("Show clipping rectangles when hovering draw commands", &show_clip_rects);
+        ImGui::Text("%d allocations (all contexts), %d during the last frame of this context", (int)GImAllocatorActiveAllocationsCount, ImGui::GetIO().MetricsFrameAllocs);
+        ImGui::Checkbox("Show clipping rectangles when hovering draw commands", &GImGui->MetricsShowClipRects);
         ImGui::Separator();
 
         struct Funcs
@@ -13139,7 +14518,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                     }
                     ImDrawIdx* idx_buffer = (draw_list->IdxBuffer.Size > 0) ? draw_list->IdxBuffer.Data : NULL;
                     bool pcmd_node_open = ImGui::TreeNode((void*)(pcmd - draw_list->CmdBuffer.begin()), "Draw %4d %s vtx, tex 0x%p, clip_rect (%4.0f,%4.0f)-(%4.0f,%4.0f)", pcmd->ElemCount, draw_list->IdxBuffer.Size > 0 ? "indexed" : "non-indexed", pcmd->TextureId, pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
-                    if (show_clip_rects && ImGui::IsItemHovered())
+                    if (GImGui->MetricsShowClipRects && ImGui::IsItemHovered())
                     {
                         ImRect clip_rect = pcmd->ClipRect;
                         ImRect vtxs_rect;
@@ -13150,6 +14529,10 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                     }
                     if (!pcmd_node_open)
                         continue;
+                    if (pcmd->ShapeType != ImDrawShape_None)
+                        ImGui::BulletText("Shape %d, rect (%4.0f,%4.0f)-(%4.0f,%4.0f), rounding %.1f, thickness %.1f", pcmd->ShapeType, pcmd->ShapeRect.x, pcmd->ShapeRect.y, pcmd->ShapeRect.z, pcmd->ShapeRect.w, pcmd->ShapeRounding, pcmd->ShapeThickness);
+                    if (pcmd->DistanceField)
+                        ImGui::BulletText("Signed distance field");
 
                     // Display individual triangles/vertices. Hover on to get the corresponding triangle highlighted.
                     ImGuiListClipper clipper(pcmd->ElemCount/3); // Manually coarse clip our print out of individual vertices to save CPU, only items that may be visible.
@@ -13223,7 +14606,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                     }
                     ImGui::TreePop();
                 }
-                ImGui::BulletText("Storage: %d bytes", window->StateStorage.Data.Size * (int)sizeof(ImGuiStorage::Pair));
+                ImGui::BulletText("Storage: %d bytes", window->StateStorage.Data.Size * (int)sizeof(ImGuiStorage::Pair) + window->StateStorage.Index.Size * (int)sizeof(int));
                 ImGui::TreePop();
             }
         };
@@ -13246,6 +14629,27 @@ void ImGui::ShowMetricsWindow(bool* p_open)
             }
             ImGui::TreePop();
         }
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+        if (ImGui::TreeNode("Allocations", "Allocations (peak %d KB in use by all contexts during the last frame)", (int)(g.AllocStatsLastFrame.PeakLiveBytes / 1024)))
+        {
+            const char* category_names[] = { "Misc", "DrawList", "Storage", "Text", "Window" }; IM_ASSERT(IM_ARRAYSIZE(category_names) == ImGuiAllocCategory_COUNT);
+            ImGui::Columns(4, "##allocs");
+            ImGui::Text("Category"); ImGui::NextColumn();
+            ImGui::Text("Last frame"); ImGui::NextColumn();
+            ImGui::Text("Last frame bytes"); ImGui::NextColumn();
+            ImGui::Text("In use bytes (all contexts)"); ImGui::NextColumn();
+            ImGui::Separator();
+            for (int n = 0; n < ImGuiAllocCategory_COUNT; n++)
+            {
+                ImGui::Text("%s", category_names[n]); ImGui::NextColumn();
+                ImGui::Text("%d", (int)g.AllocStatsLastFrame.Count[n]); ImGui::NextColumn();
+                ImGui::Text("%llu", (unsigned long long)g.AllocStatsLastFrame.Bytes[n]); ImGui::NextColumn();
+                ImGui::Text("%llu", (unsigned long long)g.AllocStatsLastFrame.LiveBytes[n]); ImGui::NextColumn();
+            }
+            ImGui::Columns(1);
+            ImGui::TreePop();
+        }
+#endif
         if (ImGui::TreeNode("Internal state"))
         {
             const char* input_source_names[] = { "None", "Mouse", "Nav", "NavGamepad", "NavKeyboard" }; IM_ASSERT(IM_ARRAYSIZE(input_source_names) == ImGuiInputSource_COUNT);
@@ -13260,6 +14664,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
             ImGui::Text("NavActivateId: 0x%08X, NavInputId: 0x%08X", g.NavActivateId, g.NavInputId);
             ImGui::Text("NavDisableHighlight: %d, NavDisableMouseHover: %d", g.NavDisableHighlight, g.NavDisableMouseHover);
             ImGui::Text("DragDrop: %d, SourceId = 0x%08X, Payload \"%s\" (%d bytes)", g.DragDropActive, g.DragDropPayload.SourceId, g.DragDropPayload.DataType, g.DragDropPayload.DataSize);
+            ImGui::Text("Log: %llu bytes written to files, %llu bytes dropped (%d chunks)", (unsigned long long)g.LogBytesWritten, (unsigned long long)g.LogBytesDropped, g.LogChunksDropped);
             ImGui::TreePop();
         }
     }
@@ -61,6 +61,7 @@ struct ImDrawVert;                  // A single vertex (20 bytes by default, ove
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
+struct ImFontParsedData;            // Font file parsed once for every size it is built at (internal to imgui_draw.cpp)
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
 struct ImGuiOnceUponAFrame;         // Simple helper for running a block of code not more than once a frame, used by IMGUI_ONCE_UPON_A_FRAME macro
@@ -68,9 +69,12 @@ struct ImGuiStorage;                // Simple custom key value storage
 struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTextFilter;             // Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
 struct ImGuiTextBuffer;             // Text buffer for logging/accumulating text
+struct ImGuiTextLog;                // Append-only text log with a line index and cached filtering, to display large logs
 struct ImGuiTextEditCallbackData;   // Shared state of ImGui::InputText() when using custom ImGuiTextEditCallback (rare/advanced use)
 struct ImGuiSizeCallbackData;       // Structure used to constraint window size in custom ways when using custom ImGuiSizeCallback (rare/advanced use)
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiListClipperVariable;    // Helper to manually clip large list of items of variable height
+struct ImGuiListHeightCache;        // Persistent item heights for ImGuiListClipperVariable
 struct ImGuiPayload;                // User data payload for drag and drop operations
 struct ImGuiContext;                // ImGui context (opaque)
 
@@ -81,16 +85,24 @@ typedef void* ImTextureID;          // user data to identify a texture (this is
 // Typedefs and Enumerations (declared as int for compatibility with old C++ and to not pollute the top of this file)
 typedef unsigned int ImU32;         // 32-bit unsigned integer (typically used to store packed colors)
 typedef unsigned int ImGuiID;       // unique ID used by widgets (typically hashed from a stack of string)
+#ifdef IMGUI_USE_WCHAR32
+typedef unsigned int ImWchar;       // character for keyboard input/display, 32-bit to support codepoints beyond the Basic Multilingual Plane (see IMGUI_USE_WCHAR32 in imconfig.h)
+#define IM_UNICODE_CODEPOINT_MAX 0x10FFFF
+#else
 typedef unsigned short ImWchar;     // character for keyboard input/display
+#define IM_UNICODE_CODEPOINT_MAX 0xFFFF
+#endif
 typedef int ImGuiCol;               // enum: a color identifier for styling     // enum ImGuiCol_
 typedef int ImGuiDir;               // enum: a cardinal direction               // enum ImGuiDir_
 typedef int ImGuiCond;              // enum: a condition for Set*()             // enum ImGuiCond_
 typedef int ImGuiKey;               // enum: a key identifier (ImGui-side enum) // enum ImGuiKey_
+typedef int ImGuiLogOverflow;       // enum: for io.LogFileOverflow             // enum ImGuiLogOverflow_
 typedef int ImGuiNavInput;          // enum: an input identifier for navigation // enum ImGuiNavInput_
 typedef int ImGuiMouseCursor;       // enum: a mouse cursor identifier          // enum ImGuiMouseCursor_
 typedef int ImGuiStyleVar;          // enum: a variable identifier for styling  // enum ImGuiStyleVar_
 typedef int ImDrawCornerFlags;      // flags: for ImDrawList::AddRect*() etc.   // enum ImDrawCornerFlags_
 typedef int ImDrawListFlags;        // flags: for ImDrawList                    // enum ImDrawListFlags_
+typedef int ImDrawShape;            // enum: an analytic shape for ImDrawCmd    // enum ImDrawShape_
 typedef int ImFontAtlasFlags;       // flags: for ImFontAtlas                   // enum ImFontAtlasFlags_
 typedef int ImGuiColorEditFlags;    // flags: for ColorEdit*(), ColorPicker*()  // enum ImGuiColorEditFlags_
 typedef int ImGuiColumnsFlags;      // flags: for *Columns*()                   // enum ImGuiColumnsFlags_
@@ -155,6 +167,7 @@ namespace ImGui
     IMGUI_API void          Render();                                   // ends the ImGui frame, finalize the draw data. (Obsolete: optionally call io.RenderDrawListsFn if set. Nowadays, prefer calling your render function yourself.)
     IMGUI_API ImDrawData*   GetDrawData();                              // valid after Render() and until the next call to NewFrame(). this is what you have to render. (Obsolete: this used to be passed to your io.RenderDrawListsFn() function.)
     IMGUI_API void          EndFrame();                                 // ends the ImGui frame. automatically called by Render(), so most likely don't need to ever call that yourself directly. If you don't need to render you may call EndFrame() but you'll have wasted CPU already. If you don't need to render, better to not create any imgui windows instead!
+    IMGUI_API void          PreloadIniSettings();                       // start reading io.IniFilename on the background thread, to be parsed by the first NewFrame(). does nothing unless IMGUI_ENABLE_INI_SETTINGS_THREAD is defined. call once io.IniFilename is set (e.g. in your binding's Init function).
 
     // Demo, Debug, Informations
     IMGUI_API void          ShowDemoWindow(bool* p_open = NULL);        // create demo/test window (previously called ShowTestWindow). demonstrate most ImGui features. call this to learn about the library! try to make it always available in your application!
@@ -770,6 +783,7 @@ enum ImGuiConfigFlags_
     ImGuiConfigFlags_NavEnableGamepad     = 1 << 1,   // Master gamepad navigation enable flag. This is mostly to instruct your imgui back-end to fill io.NavInputs[].
     ImGuiConfigFlags_NavMoveMouse         = 1 << 2,   // Request navigation to allow moving the mouse cursor. May be useful on TV/console systems where moving a virtual mouse is awkward. Will update io.MousePos and set io.WantMoveMouse=true. If enabled you MUST honor io.WantMoveMouse requests in your binding, otherwise ImGui will react as if the mouse is jumping around back and forth.
     ImGuiConfigFlags_NavNoCaptureKeyboard = 1 << 3,   // Do not set the io.WantCaptureKeyboard flag with io.NavActive is set. 
+    ImGuiConfigFlags_RendererHasAnalyticShapes = 1 << 4, // Back-end renderer evaluates ImDrawCmd::ShapeType per pixel. Rounded rectangles, circles and their borders are then emitted as a single quad instead of being tessellated. See ImDrawShape_.
 
     // User storage (to allow your back-end/engine to communicate to code that may be shared between multiple projects. Those flags are not used by core ImGui)
     ImGuiConfigFlags_IsSRGB               = 1 << 20,  // Back-end is SRGB-aware.
@@ -917,6 +931,14 @@ enum ImGuiMouseCursor_
 #endif
 };
 
+// Enumeration for io.LogFileOverflow: what logging does when the log file writer thread (IMGUI_ENABLE_LOG_FILE_THREAD) falls behind
+enum ImGuiLogOverflow_
+{
+    ImGuiLogOverflow_Block,             // Wait for the writer thread, nothing is lost
+    ImGuiLogOverflow_DropOldest,        // Discard the oldest output not written yet
+    ImGuiLogOverflow_DropNewest         // Discard the output being logged
+};
+
 // Condition for ImGui::SetWindow***(), SetNextWindow***(), SetNextTreeNode***() functions
 // All those functions treat 0 as a shortcut to ImGuiCond_Always. From the point of view of the user use this as an enum (don't combine multiple values into flags).
 enum ImGuiCond_
@@ -985,6 +1007,7 @@ struct ImGuiIO
     float         IniSavingRate;            // = 5.0f               // Maximum time between saving positions/sizes to .ini file, in seconds.
     const char*   IniFilename;              // = "imgui.ini"        // Path to .ini file. NULL to disable .ini saving.
     const char*   LogFilename;              // = "imgui_log.txt"    // Path to .log file (default parameter to ImGui::LogToFile when no file is specified).
+    ImGuiLogOverflow LogFileOverflow;       // = ImGuiLogOverflow_Block // What logging to a file does when the writer thread falls behind (only with IMGUI_ENABLE_LOG_FILE_THREAD).
     float         MouseDoubleClickTime;     // = 0.30f              // Time for a double-click, in seconds.
     float         MouseDoubleClickMaxDist;  // = 6.0f               // Distance threshold to stay in to validate a double-click, in pixels.
     float         MouseDragThreshold;       // = 6.0f               // Distance threshold before considering we are dragging.
@@ -992,6 +1015,7 @@ struct ImGuiIO
     float         KeyRepeatDelay;           // = 0.250f             // When holding a key/button, time before it starts repeating, in seconds (for buttons in Repeat mode, etc.).
     float         KeyRepeatRate;            // = 0.050f             // When holding a key/button, rate at which it repeats, in seconds.
     void*         UserData;                 // = NULL               // Store your own data for retrieval by callbacks.
+    void*         BindingUserData;          // = NULL               // Per-context data of the platform/renderer binding (imgui_impl_xxx), so each context can have its own window and graphics context.
 
     ImFontAtlas*  Fonts;                    // <auto>               // Load and assemble one or more fonts into a single tightly packed texture. Output to Fonts array.
     float         FontGlobalScale;          // = 1.0f               // Global scale all fonts
@@ -1062,6 +1086,7 @@ struct ImGuiIO
     int         MetricsRenderVertices;      // Vertices output during last call to Render()
     int         MetricsRenderIndices;       // Indices output during last call to Render() = number of triangles * 3
     int         MetricsActiveWindows;       // Number of visible root windows (exclude child windows)
+    int         MetricsFrameAllocs;         // Memory allocations made while this context was current during the last frame (between its two last calls to NewFrame()). Should stay 0 once the UI is warmed up.
     ImVec2      MouseDelta;                 // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
 
     //------------------------------------------------------------------
@@ -1180,6 +1205,7 @@ public:
     inline void                 push_front(const value_type& v) { if (Size == 0) push_back(v); else insert(Data, v); }
 
     inline iterator             erase(const_iterator it)                        { IM_ASSERT(it >= Data && it < Data+Size); const ptrdiff_t off = it - Data; memmove(Data + off, Data + off + 1, ((size_t)Size - (size_t)off - 1) * sizeof(value_type)); Size--; return Data + off; }
+    inline iterator             erase(const_iterator it, const_iterator it_last){ IM_ASSERT(it >= Data && it <= it_last && it_last <= Data+Size); const ptrdiff_t count = it_last - it; const ptrdiff_t off = it - Data; memmove(Data + off, Data + off + count, ((size_t)Size - (size_t)off - (size_t)count) * sizeof(value_type)); Size -= (int)count; return Data + off; }
     inline iterator             insert(const_iterator it, const value_type& v)  { IM_ASSERT(it >= Data && it <= Data+Size); const ptrdiff_t off = it - Data; if (Size == Capacity) reserve(_grow_capacity(Size + 1)); if (off < (int)Size) memmove(Data + off + 1, Data + off, ((size_t)Size - (size_t)off) * sizeof(value_type)); Data[off] = v; Size++; return Data + off; }
     inline bool                 contains(const value_type& v) const             { const T* data = Data;  const T* data_end = Data + Size; while (data < data_end) if (*data++ == v) return true; return false; }
 };
@@ -1221,12 +1247,14 @@ struct ImGuiTextFilter
     };
 
     char                InputBuf[256];
+    char                FoldedBuf[256];     // Upper-case copy of InputBuf made by Build(), Filters[n] is matched against the same range in there
     ImVector<TextRange> Filters;
     int                 CountGrep;
 
     IMGUI_API           ImGuiTextFilter(const char* default_filter = "");
     IMGUI_API bool      Draw(const char* label = "Filter (inc,-exc)", float width = 0.0f);    // Helper calling InputText+Build
     IMGUI_API bool      PassFilter(const char* text, const char* text_end = NULL) const;
+    IMGUI_API int       PassFilterArray(const char* const* items, int items_count, ImU32* out_bits) const; // Set bit n of out_bits[] (which needs (items_count+31)/32 entries) when items[n] passes, return the number of items passing
     IMGUI_API void      Build();
     void                Clear() { InputBuf[0] = 0; Build(); }
     bool                IsActive() const { return !Filters.empty(); }
@@ -1250,10 +1278,42 @@ struct ImGuiTextBuffer
     IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
 };
 
+// Helper: Append-only text log with a line index and cached filtering, to display large logs
+// Text is stored in chunks so appending never moves old data. Lines are indexed as they get completed, Filter is only applied to new lines, and Draw() only submits visible lines.
+// Usage:
+//     static ImGuiTextLog log;
+//     log.appendf("[%05d] %s\n", ImGui::GetFrameCount(), message);
+//     log.Filter.Draw();
+//     log.Draw("##log");
+struct ImGuiTextLog
+{
+    typedef ImGuiTextFilter::TextRange Line;
+
+    ImVector<char*>     Chunks;             // Text storage. All chunks but the last one are full.
+    int                 ChunkUsed;          // Bytes used in the last chunk
+    int                 ChunkCapacity;      // Size of the last chunk
+    int                 OpenLineOffset;     // Offset of the line not terminated by '\n' yet, in the last chunk
+    ImVector<Line>      Lines;              // Completed lines, without their '\n'
+    ImGuiTextFilter     Filter;
+    ImVector<int>       FilteredLines;      // Indices of Lines[] passing Filter
+    int                 FilteredCount;      // Number of Lines[] already tested against Filter
+    char                FilteredInputBuf[256];  // Copy of Filter.InputBuf when FilteredLines was built
+    bool                AutoScroll;         // Keep scrolling to the bottom when new lines arrive, as long as the view was at the bottom
+
+    IMGUI_API           ImGuiTextLog();
+    IMGUI_API           ~ImGuiTextLog();
+    int                 size() const { return Lines.Size + (ChunkUsed != OpenLineOffset ? 1 : 0); } // Number of lines, including an unterminated last line
+    IMGUI_API void      clear();
+    IMGUI_API void      append(const char* str, const char* str_end = NULL);
+    IMGUI_API void      appendf(const char* fmt, ...) IM_FMTARGS(2);
+    IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
+    IMGUI_API void      Draw(const char* str_id, const ImVec2& size = ImVec2(0,0));
+};
+
 // Helper: Simple Key->value storage
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1), store color edit options. 
-// This is optimized for efficient reading (dichotomy into a contiguous buffer), rare writing (typically tied to user interactions)
+// This is optimized for efficient reading and writing (open-addressing hash table indexing a contiguous buffer of pairs, kept in insertion order)
 // You can use it as custom user storage for temporary values. Declare your own storage if, for example:
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
@@ -1268,12 +1328,15 @@ struct ImGuiStorage
         Pair(ImGuiID _key, float _val_f) { key = _key; val_f = _val_f; }
         Pair(ImGuiID _key, void* _val_p) { key = _key; val_p = _val_p; }
     };
-    ImVector<Pair>      Data;
+    ImVector<Pair>      Data;           // Pairs in insertion order (sorted by key after BuildSortByKey())
+    ImVector<int>       Index;          // Hash table with linear probing: index+1 of a pair of Data, 0 for an empty slot. Never more than half full.
+    int                 IndexedCount;   // Number of pairs of Data in Index. When the size of Data was changed directly, Index is rebuilt by the next Set***(), Get***Ref() or BuildSortByKey().
+
+    ImGuiStorage()      { IndexedCount = 0; }
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
-    // - Set***() functions find pair, insertion on demand if missing.
-    // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
-    void                Clear() { Data.clear(); }
+    // - Get***() functions find pair, never add/allocate nor modify the storage. A query is O(1), or a linear search if Data was modified directly since the last Set***() or BuildSortByKey().
+    // - Set***() functions find pair, insertion on demand if missing. Insertion appends to Data, growing Index from time to time.
+    void                Clear() { Data.clear(); Index.clear(); IndexedCount = 0; }
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -1295,7 +1358,8 @@ struct ImGuiStorage
     // Use on your own storage if you know only integer are being stored (open/close all tree nodes)
     IMGUI_API void      SetAllInt(int val);
 
-    // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+    // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents to Data and then sort once.
+    // Also call it after modifying the keys of Data directly.
     IMGUI_API void      BuildSortByKey();
 };
 
@@ -1400,7 +1464,7 @@ struct ImColor
 };
 
 // Helper: Manually clip large list of items.
-// If you are submitting lots of evenly spaced items and you have a random access to the list, you can perform coarse clipping based on visibility to save yourself from processing those items at all.
+// If you are submitting lots of evenly spaced items and you have a random access to the list, you can perform coarse clipping based on visibility to save yourself from processing those items at all. (see ImGuiListClipperVariable below if your items have different heights)
 // The clipper calculates the range of visible items and advance the cursor to compensate for the non-visible items we have skipped. 
 // ImGui already clip items based on their bounds but it needs to measure text size to do so. Coarse clipping before submission makes this cost and your own data fetching/submission cost null.
 // Usage:
@@ -1429,6 +1493,49 @@ struct ImGuiListClipper
     IMGUI_API void End();                                               // Automatically called on the last call of Step() that returns false.
 };
 
+// Helper: Persistent height cache for ImGuiListClipperVariable. Keep one instance per list, alive across frames.
+// Heights are stored as deltas from DefaultHeight in a Fenwick tree, so offsets and offset->item lookups are O(log N) and unmeasured items cost nothing.
+// Call Clear() when every height becomes invalid (e.g. the wrapping width changed), SetHeight() to invalidate/patch a single item.
+struct ImGuiListHeightCache
+{
+    float               DefaultHeight;  // Estimated height of unmeasured items. Set on first Resize() if <= 0.0f. Don't change once items are measured.
+    ImVector<double>    Tree;           // Fenwick tree of (height - DefaultHeight), 1 entry per item. Double to keep offsets exact over millions of items.
+
+    ImGuiListHeightCache(float default_height = -1.0f) { DefaultHeight = default_height; }
+    void                Clear()                         { Tree.clear(); }
+    int                 Size() const                    { return Tree.Size; }
+    double              GetTotalHeight() const          { return GetOffset(Tree.Size); }
+    IMGUI_API void      Resize(int items_count);        // Keep measured heights of items [0, min(old,new)), new items get DefaultHeight.
+    IMGUI_API void      SetHeight(int item_idx, float height);
+    IMGUI_API float     GetHeight(int item_idx) const;
+    IMGUI_API double    GetOffset(int item_idx) const;  // Sum of heights of items [0, item_idx)
+    IMGUI_API int       FindItem(double offset) const;  // Index of the item covering 'offset', clamped to [0, Size()]
+};
+
+// Helper: Manually clip large list of items of variable height.
+// Items are measured from the cursor movement when they are submitted, and those heights persist in the ImGuiListHeightCache you provide.
+// Step() returns one item at a time so every visible item can be measured, the usual loop still applies:
+//     static ImGuiListHeightCache heights;
+//     ImGuiListClipperVariable clipper(&heights, 10000000);
+//     while (clipper.Step())
+//         for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+//             ImGui::TextWrapped("%s", GetItemText(i));
+// Items that were never visible are assumed to be DefaultHeight tall (default to GetTextLineHeightWithSpacing()), so the scrollbar only moves when visible items get measured.
+struct ImGuiListClipperVariable
+{
+    ImGuiListHeightCache* Heights;
+    float   StartPosY;
+    float   ItemPosY;
+    int     ItemsCount, StepNo, DisplayStart, DisplayEnd, ExtraItems;
+
+    ImGuiListClipperVariable(ImGuiListHeightCache* heights, int items_count = -1)   { Heights = heights; ItemsCount = -1; if (items_count >= 0) Begin(items_count); }
+    ~ImGuiListClipperVariable()                                                     { IM_ASSERT(ItemsCount == -1); } // Assert if user forgot to call End() or Step() until false.
+
+    IMGUI_API bool Step();                                              // Call until it returns false. DisplayStart/DisplayEnd will be set to a single item.
+    IMGUI_API void Begin(int items_count);
+    IMGUI_API void End();                                               // Automatically called on the last call of Step() that returns false.
+};
+
 //-----------------------------------------------------------------------------
 // Draw List
 // Hold a series of drawing commands. The user provides a renderer for ImDrawData which essentially contains an array of ImDrawList.
@@ -1448,8 +1555,14 @@ struct ImDrawCmd
     ImTextureID     TextureId;              // User-provided texture ID. Set by user in ImfontAtlas::SetTexID() for fonts or passed to Image*() functions. Ignore if never using images or multiple fonts atlas.
     ImDrawCallback  UserCallback;           // If != NULL, call the function instead of rendering the vertices. clip_rect and texture_id will be set normally.
     void*           UserCallbackData;       // The draw callback code can access this.
-
-    ImDrawCmd() { ElemCount = 0; ClipRect.x = ClipRect.y = ClipRect.z = ClipRect.w = 0.0f; TextureId = NULL; UserCallback = NULL; UserCallbackData = NULL; }
+    ImDrawShape     ShapeType;              // If != ImDrawShape_None, the command is a single quad covering an analytic shape. The renderer computes per-pixel coverage from the Shape* fields below and multiplies it with the vertex color.
+    ImVec4          ShapeRect;              // Shape rectangle (x1, y1, x2, y2). For borders this is the stroke center line. For circles this is the bounding box of the circle.
+    float           ShapeRounding;          // Corner radius for rectangles, radius for circles.
+    float           ShapeThickness;         // Stroke thickness for borders, 0.0f for filled shapes.
+    int             ShapeCornerFlags;       // ImDrawCornerFlags_ of the rounded corners for rectangles.
+    bool            DistanceField;          // Texture alpha is a signed distance field (text from fonts built with ImFontConfig::DistanceField), 0.5 on the glyph outline. The renderer turns it into coverage (e.g. a smoothstep or a steep ramp around 0.5) before multiplying by the vertex alpha.
+
+    ImDrawCmd() { ElemCount = 0; ClipRect.x = ClipRect.y = ClipRect.z = ClipRect.w = 0.0f; TextureId = NULL; UserCallback = NULL; UserCallbackData = NULL; ShapeType = 0; ShapeRect.x = ShapeRect.y = ShapeRect.z = ShapeRect.w = 0.0f; ShapeRounding = ShapeThickness = 0.0f; ShapeCornerFlags = 0; DistanceField = false; }
 };
 
 // Vertex index (override with '#define ImDrawIdx unsigned int' inside in imconfig.h)
@@ -1497,7 +1610,22 @@ enum ImDrawCornerFlags_
 enum ImDrawListFlags_
 {
     ImDrawListFlags_AntiAliasedLines = 1 << 0,
-    ImDrawListFlags_AntiAliasedFill  = 1 << 1
+    ImDrawListFlags_AntiAliasedFill  = 1 << 1,
+    ImDrawListFlags_AnalyticShapes   = 1 << 2   // Emit AddRect/AddRectFilled with rounding and AddCircle/AddCircleFilled as ImDrawCmd::ShapeType quads, each in its own draw command. Set by ImGui when io.ConfigFlags has ImGuiConfigFlags_RendererHasAnalyticShapes.
+};
+
+// Analytic shapes stored in ImDrawCmd::ShapeType (only emitted when ImDrawListFlags_AnalyticShapes is set)
+// Given 'd' the signed distance from the pixel center to the shape outline (negative inside), the expected coverage is:
+//   filled shapes:  clamp(0.5f - d, 0.0f, 1.0f)
+//   borders:        clamp(0.5f * ShapeThickness + 0.5f - fabsf(d), 0.0f, 1.0f)
+// The quad vertices are expanded by 1 pixel (plus half the thickness for borders) around ShapeRect to leave room for the anti-aliased fringe.
+enum ImDrawShape_
+{
+    ImDrawShape_None = 0,
+    ImDrawShape_RectFilled,     // Rectangle with ShapeRounding on the corners selected by ShapeCornerFlags
+    ImDrawShape_Rect,           // Border of a rectangle, ShapeThickness wide
+    ImDrawShape_CircleFilled,   // Circle of radius ShapeRounding
+    ImDrawShape_Circle          // Border of a circle, ShapeThickness wide
 };
 
 // Draw command list
@@ -1588,6 +1716,9 @@ struct ImDrawList
     IMGUI_API void  PrimRect(const ImVec2& a, const ImVec2& b, ImU32 col);      // Axis aligned rectangle (composed of two triangles)
     IMGUI_API void  PrimRectUV(const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, ImU32 col);
     IMGUI_API void  PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, const ImVec2& d, const ImVec2& uv_a, const ImVec2& uv_b, const ImVec2& uv_c, const ImVec2& uv_d, ImU32 col);
+    IMGUI_API void  PrimShape(ImDrawShape shape_type, const ImVec2& a, const ImVec2& b, ImU32 col, float rounding, int rounding_corners_flags, float thickness); // Analytic shape in its own draw command (requires ImDrawListFlags_AnalyticShapes)
+    IMGUI_API void  PrimBeginDistanceField();   // Following primitives go into a draw command flagged ImDrawCmd::DistanceField (consecutive runs are merged)
+    IMGUI_API void  PrimEndDistanceField();
     inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col){ _VtxWritePtr->pos = pos; _VtxWritePtr->uv = uv; _VtxWritePtr->col = col; _VtxWritePtr++; _VtxCurrentIdx++; }
     inline    void  PrimWriteIdx(ImDrawIdx idx)                                 { *_IdxWritePtr = idx; _IdxWritePtr++; }
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)     { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); }
@@ -1608,12 +1739,12 @@ struct ImDrawData
     ImDrawData() { Clear(); }
     void Clear() { Valid = false; CmdLists = NULL; CmdListsCount = TotalVtxCount = TotalIdxCount = 0; } // Draw lists are owned by the ImGuiContext and only pointed to here.
     IMGUI_API void DeIndexAllBuffers();               // For backward compatibility or convenience: convert all buffers from indexed to de-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
-    IMGUI_API void ScaleClipRects(const ImVec2& sc);  // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
+    IMGUI_API void ScaleClipRects(const ImVec2& sc);  // Helper to scale the ClipRect and Shape* fields of each ImDrawCmd. Use if your final output buffer is at a different scale than ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
 };
 
 struct ImFontConfig
 {
-    void*           FontData;                   //          // TTF/OTF data
+    void*           FontData;                   //          // TTF/OTF data. NULL for the font added by AddFontDefault() until a build decompresses it (never when Build() loads the atlas from CacheFilename).
     int             FontDataSize;               //          // TTF/OTF data size
     bool            FontDataOwnedByAtlas;       // true     // TTF/OTF data ownership taken by the container ImFontAtlas (will delete memory itself).
     int             FontNo;                     // 0        // Index of font within TTF/OTF file
@@ -1626,17 +1757,22 @@ struct ImFontConfig
     bool            MergeMode;                  // false    // Merge into previous ImFont, so you can combine multiple inputs font into one ImFont (e.g. ASCII font + icons + Japanese glyphs). You may want to use GlyphOffset.y when merge font of different heights.
     unsigned int    RasterizerFlags;            // 0x00     // Settings for custom font rasterizer (e.g. ImGuiFreeType). Leave as zero if you aren't using one.
     float           RasterizerMultiply;         // 1.0f     // Brighten (>1.0f) or darken (<1.0f) font output. Brightening small fonts may be a good workaround to make them more readable.
+    bool            DynamicGlyphs;              // false    // Rasterize glyphs missing from GlyphRanges on demand, the first time they are looked up. Requires FontData and TexPixels to stay alive (don't call ClearInputData()/ClearTexData() after building).
+    bool            DistanceField;              // false    // Bake signed distance fields instead of coverage, so one baked size stays sharp at any display scale. Oversample/RasterizerMultiply are ignored. The renderer needs to handle ImDrawCmd::DistanceField. Can't be mixed with regular glyphs in a merged font.
 
     // [Internal]
     char            Name[40];                               // Name (strictly to ease debugging)
     ImFont*         DstFont;
+    const char*     FontDataCompressedBase85;               // Embedded font added by AddFontDefault(), decompressed into FontData by the first build which doesn't load from the atlas cache
 
     IMGUI_API ImFontConfig();
 };
 
 struct ImFontGlyph
 {
-    ImWchar         Codepoint;          // 0x0000..0xFFFF
+    ImWchar         Codepoint;          // 0x0000..IM_UNICODE_CODEPOINT_MAX
+    unsigned short  Page;               // 0 for glyphs baked by Build(), else 1 + index in ImFontAtlas::DynamicPages
+    unsigned short  TexPage;            // Texture page holding the glyph, U/V are relative to that page (see ImFontAtlas::TexPageHeight)
     float           AdvanceX;           // Distance to next character (= data from font + ImFontConfig::GlyphExtraSpacing.x baked in)
     float           X0, Y0, X1, Y1;     // Glyph corners
     float           U0, V0, U1, V1;     // Texture coordinates
@@ -1661,7 +1797,7 @@ struct ImFontAtlas
     IMGUI_API ImFontAtlas();
     IMGUI_API ~ImFontAtlas();
     IMGUI_API ImFont*           AddFont(const ImFontConfig* font_cfg);
-    IMGUI_API ImFont*           AddFontDefault(const ImFontConfig* font_cfg = NULL);
+    IMGUI_API ImFont*           AddFontDefault(const ImFontConfig* font_cfg = NULL);  // The embedded font is only decompressed into ConfigData[].FontData when building, not when the atlas is loaded from CacheFilename
     IMGUI_API ImFont*           AddFontFromFileTTF(const char* filename, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);
     IMGUI_API ImFont*           AddFontFromMemoryTTF(void* font_data, int font_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // Note: Transfer ownership of 'ttf_data' to ImFontAtlas! Will be deleted after Build(). Set font_cfg->FontDataOwnedByAtlas to false to keep ownership.
     IMGUI_API ImFont*           AddFontFromMemoryCompressedTTF(const void* compressed_font_data, int compressed_font_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // 'compressed_font_data' still owned by caller. Compress with binary_to_compressed_c.cpp.
@@ -1680,6 +1816,22 @@ struct ImFontAtlas
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
+    // Texture pages (ImFontAtlas::TexPageHeight > 0)
+    // The pixels returned by GetTexData*() hold TexPagesCount pages of GetTexPageHeight() rows stacked vertically. Upload each page as its own texture and store its handle with SetTexPageID().
+    // Custom rectangles added after Build() may append a page: create textures for the new pages when TexPagesCount grows.
+    IMGUI_API void              SetTexPageID(int page, ImTextureID id);
+    ImTextureID                 GetTexPageID(int page) const { return page == 0 ? TexID : page <= TexPageIDs.Size ? TexPageIDs[page - 1] : NULL; }
+    int                         GetTexPageHeight() const    { return TexPageHeight > 0 ? TexPageHeight : TexHeight; }
+
+    // Glyphs rasterized on demand (ImFontConfig::DynamicGlyphs) and custom rectangles added after Build()
+    // ImGui::NewFrame() calls UpdateDynamicGlyphs(), which writes the glyphs queued during the previous frame into the texture pixels.
+    // When IsTexDirty() returns true, upload the rectangles of TexDirtyRects again and call ClearTexDirty(). To spread large updates over several frames, remove or shrink only the rectangles uploaded so far.
+    IMGUI_API bool              UpdateDynamicGlyphs();      // Returns true if texture pixels were modified.
+    IMGUI_API void              TouchDynamicGlyph(const ImFont* font, ImWchar c); // Keep the page of a dynamic glyph alive for this frame, or queue the glyph if the font is missing it. Called by ImFont::RenderText()/RenderChar().
+    IMGUI_API void              MarkTexDirty(int x, int y, int w, int h);   // Call after writing into the texture pixels, e.g. those of a custom rectangle added after Build().
+    bool                        IsTexDirty() const          { return TexDirtyRects.Size > 0; }
+    void                        ClearTexDirty()             { TexDirtyRects.resize(0); }
+
     //-------------------------------------------
     // Glyph Ranges
     //-------------------------------------------
@@ -1697,7 +1849,7 @@ struct ImFontAtlas
     struct GlyphRangesBuilder
     {
         ImVector<unsigned char> UsedChars;  // Store 1-bit per Unicode code point (0=unused, 1=used)
-        GlyphRangesBuilder()                { UsedChars.resize(0x10000 / 8); memset(UsedChars.Data, 0, 0x10000 / 8); }
+        GlyphRangesBuilder()                { UsedChars.resize((IM_UNICODE_CODEPOINT_MAX + 1) / 8); memset(UsedChars.Data, 0, (IM_UNICODE_CODEPOINT_MAX + 1) / 8); }
         bool           GetBit(int n)        { return (UsedChars[n >> 3] & (1 << (n & 7))) != 0; }
         void           SetBit(int n)        { UsedChars[n >> 3] |= 1 << (n & 7); }  // Set bit 'c' in the array
         void           AddChar(ImWchar c)   { SetBit(c); }                          // Add character
@@ -1712,15 +1864,18 @@ struct ImFontAtlas
 
     // You can request arbitrary rectangles to be packed into the atlas, for your own purposes. After calling Build(), you can query the rectangle position and render your pixels.
     // You can also request your rectangles to be mapped as font glyph (given a font + Unicode point), so you can render e.g. custom colorful icons and use them as regular glyphs.
+    // Rectangles added after Build() are packed right away in the free space left in the texture (when there isn't enough, a new page is added when using TexPageHeight, else IsPacked() is false and the next Build() packs them).
+    // Render their pixels then call MarkTexDirty() so the texture is uploaded again. Font glyphs are usable immediately.
     struct CustomRect
     {
         unsigned int    ID;             // Input    // User ID. Use <0x10000 to map into a font glyph, >=0x10000 for other/internal/custom texture data.
         unsigned short  Width, Height;  // Input    // Desired rectangle dimension
-        unsigned short  X, Y;           // Output   // Packed position in Atlas
+        unsigned short  X, Y;           // Output   // Packed position in Atlas, relative to its texture page (pixels start at row TexPage * GetTexPageHeight() + Y)
+        unsigned short  TexPage;        // Output   // Texture page holding the rectangle
         float           GlyphAdvanceX;  // Input    // For custom font glyphs only (ID<0x10000): glyph xadvance
         ImVec2          GlyphOffset;    // Input    // For custom font glyphs only (ID<0x10000): glyph display offset
         ImFont*         Font;           // Input    // For custom font glyphs only (ID<0x10000): target font
-        CustomRect()            { ID = 0xFFFFFFFF; Width = Height = 0; X = Y = 0xFFFF; GlyphAdvanceX = 0.0f; GlyphOffset = ImVec2(0,0); Font = NULL; }
+        CustomRect()            { ID = 0xFFFFFFFF; Width = Height = 0; X = Y = 0xFFFF; TexPage = 0; GlyphAdvanceX = 0.0f; GlyphOffset = ImVec2(0,0); Font = NULL; }
         bool IsPacked() const   { return X != 0xFFFF; }
     };
 
@@ -1740,19 +1895,56 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1.
+    int                         BuildThreadsCount;  // = 0. With IMGUI_ENABLE_FONT_ATLAS_BUILD_THREADS, number of threads rasterizing glyphs in Build(): 0 for one per hardware thread, 1 to only use the calling thread.
+    const char*                 CacheFilename;      // = NULL. Path to an on-disk cache of the built atlas. When set, Build() loads the texture and glyphs from it if they were built from the same fonts and settings, else it builds normally and writes the cache.
+    int                         DynamicGlyphsBudget;// = 1024*1024. Texture area (in pixels) reserved by Build() for glyphs rasterized on demand. When it is full, the least recently used page of glyphs is evicted.
+    int                         TexPageHeight;      // = 0. When > 0, Build() packs glyphs into as many pages of TexWidth x TexPageHeight pixels as needed, each uploaded as its own texture (see SetTexPageID()), instead of a single texture as tall as needed. Bounds the size of textures and uploads.
+    ImVector<ImTextureID>       TexPageIDs;         // Textures of pages 1 to TexPagesCount-1 (page 0 uses TexID), see SetTexPageID()
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
     unsigned int*               TexPixelsRGBA32;    // 4 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight * 4
     int                         TexWidth;           // Texture width calculated during Build().
-    int                         TexHeight;          // Texture height calculated during Build().
-    ImVec2                      TexUvScale;         // = (1.0f/TexWidth, 1.0f/TexHeight)
+    int                         TexHeight;          // Texture height calculated during Build(). TexPagesCount * TexPageHeight when using texture pages.
+    int                         TexPagesCount;      // Number of texture pages, 1 unless TexPageHeight is set
+    ImVec2                      TexUvScale;         // = (1.0f/TexWidth, 1.0f/GetTexPageHeight())
     ImVec2                      TexUvWhitePixel;    // Texture coordinates to a white pixel
     ImVector<ImFont*>           Fonts;              // Hold all the fonts returned by AddFont*. Fonts[0] is the default font upon calling ImGui::NewFrame(), use ImGui::PushFont()/PopFont() to change the current font.
     ImVector<CustomRect>        CustomRects;        // Rectangles for packing custom texture data into the atlas.
     ImVector<ImFontConfig>      ConfigData;         // Internal data
     int                         CustomRectIds[1];   // Identifiers of custom texture rectangle used by ImFontAtlas/ImDrawList
+    struct TexDirtyRect         { int X, Y, Width, Height; };
+    ImVector<TexDirtyRect>      TexDirtyRects;      // Texture pixels modified since they were uploaded (see IsTexDirty()), in rows of the whole texture. Rectangles whose bounding box wouldn't upload more pixels are merged.
+    void*                       PackContext;        // stb_rect_pack skyline (stbrp_context*) kept after Build(), so custom rectangles added later are packed in its free space. Freed by ClearTexData().
+    void*                       PackNodes;
+    int                         PackPage;           // Texture page of PackContext
+    ImVector<ImFontParsedData*> ParsedFonts;        // One per distinct font file (and FontNo) used by ConfigData: decoded cmap and glyph outlines, shared by all its sizes. Freed by ClearInputData().
+
+    // [Internal] Glyphs rasterized on demand. Each page is a horizontal band of the texture below the glyphs baked by Build(), filled row by row and recycled as a whole.
+    struct DynamicGlyphPage
+    {
+        int             Y, Height;                  // Rows of the texture owned by the page
+        int             CursorX, CursorY, RowHeight;// Packing position of the current row
+        int             GlyphsCount;
+        int             LastUsedFrame;              // Last value of DynamicFrameCount at which one of the glyphs was passed to TouchDynamicGlyph()
+    };
+    struct DynamicGlyphRequest
+    {
+        const ImFont*   Font;
+        ImWchar         Codepoint;
+    };
+    ImVector<DynamicGlyphPage>      DynamicPages;
+    ImVector<DynamicGlyphRequest>   DynamicRequests;    // Glyphs missed by TouchDynamicGlyph() since the last UpdateDynamicGlyphs()
+    ImGuiStorage                    DynamicRequested;   // Font+codepoint -> non-zero when already requested, so glyphs missing from the font files are only looked up once
+    int                             DynamicFrameCount;  // Incremented by UpdateDynamicGlyphs()
+};
+
+// Glyphs lookup table for 256 consecutive codepoints, see ImFont::IndexPages
+struct ImFontIndexPage
+{
+    float                       AdvanceX[256];      // Glyphs->AdvanceX in a directly indexable way (more cache-friendly, for CalcTextSize functions which are often bottleneck in large UI). FallbackAdvanceX for missing glyphs.
+    int                         GlyphIndex[256];    // Index in ImFont::Glyphs, -1 for missing glyphs.
 };
 
 // Font runtime data and rendering
@@ -1764,8 +1956,8 @@ struct ImFont
     float                       Scale;              // = 1.f        // Base font scale, multiplied by the per-window font scale which you can adjust with SetFontScale()
     ImVec2                      DisplayOffset;      // = (0.f,0.f)  // Offset font rendering by xx pixels
     ImVector<ImFontGlyph>       Glyphs;             //              // All glyphs.
-    ImVector<float>             IndexAdvanceX;      //              // Sparse. Glyphs->AdvanceX in a directly indexable way (more cache-friendly, for CalcTextSize functions which are often bottleneck in large UI).
-    ImVector<unsigned short>    IndexLookup;        //              // Sparse. Index glyphs by Unicode code-point.
+    ImVector<unsigned short>    IndexPageMap;       //              // Index in IndexPages[] of the page holding codepoints [n*256, n*256+255]. Only pages holding glyphs are allocated, the others map to the shared empty page 0.
+    ImVector<ImFontIndexPage>   IndexPages;         //              // Lookup tables for glyphs by Unicode codepoint, built by BuildLookupTable(). IndexPages[0] has no glyphs.
     const ImFontGlyph*          FallbackGlyph;      // == FindGlyph(FontFallbackChar)
     float                       FallbackAdvanceX;   // == FallbackGlyph->AdvanceX
     ImWchar                     FallbackChar;       // = '?'        // Replacement glyph if one isn't found. Only set via SetFallbackChar()
@@ -1776,6 +1968,8 @@ struct ImFont
     ImFontAtlas*                ContainerAtlas;     //              // What we has been loaded into
     float                       Ascent, Descent;    //              // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
     bool                        DirtyLookupTables;
+    bool                        DynamicGlyphs;      //              // One of ConfigData has DynamicGlyphs set: RenderText()/RenderChar() queue missing glyphs into ContainerAtlas
+    bool                        DistanceField;      //              // Glyphs are signed distance fields (ImFontConfig::DistanceField), rendered in ImDrawCmd::DistanceField commands
     int                         MetricsTotalSurface;//              // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
 
     // Methods
@@ -1783,9 +1977,9 @@ struct ImFont
     IMGUI_API ~ImFont();
     IMGUI_API void              ClearOutputData();
     IMGUI_API void              BuildLookupTable();
-    IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c) const;
+    IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c) const;          // Returns FallbackGlyph if the glyph is missing. Doesn't queue dynamic glyphs, see ImFontAtlas::TouchDynamicGlyph().
     IMGUI_API void              SetFallbackChar(ImWchar c);
-    float                       GetCharAdvance(ImWchar c) const     { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : FallbackAdvanceX; }
+    float                       GetCharAdvance(ImWchar c) const     { return ((int)(c >> 8) < IndexPageMap.Size) ? IndexPages.Data[IndexPageMap.Data[c >> 8]].AdvanceX[c & 0xFF] : FallbackAdvanceX; }
     bool                        IsLoaded() const                    { return ContainerAtlas != NULL; }
     const char*                 GetDebugName() const                { return ConfigData ? ConfigData->Name : "<unknown>"; }
 
@@ -1793,11 +1987,11 @@ struct ImFont
     // 'wrap_width' enable automatic word-wrapping across multiple lines to fit into given width. 0.0f to disable.
     IMGUI_API ImVec2            CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end = NULL, const char** remaining = NULL) const; // utf8
     IMGUI_API const char*       CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const;
-    IMGUI_API void              RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, unsigned short c) const;
+    IMGUI_API void              RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, ImWchar c) const;
     IMGUI_API void              RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false) const;
 
     // [Internal]
-    IMGUI_API void              GrowIndex(int new_size);
+    IMGUI_API ImFontIndexPage&  GetOrAddIndexPage(ImWchar c);
     IMGUI_API void              AddGlyph(ImWchar c, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
 
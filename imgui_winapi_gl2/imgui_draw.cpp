@@ -18,6 +18,11 @@
 #include "imgui_internal.h"
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
+#ifdef IMGUI_ENABLE_FONT_ATLAS_BUILD_THREADS
+#include <thread>       // std::thread
+#include <mutex>        // std::mutex
+#include <atomic>       // std::atomic
+#endif
 #if !defined(alloca)
 #ifdef _WIN32
 #include <malloc.h>     // alloca
@@ -95,9 +100,20 @@ namespace IMGUI_STB_NAMESPACE
 #endif
 #include "stb_rect_pack.h"
 
+#ifdef IMGUI_ENABLE_FONT_ATLAS_BUILD_THREADS
+// When rasterizing on worker threads, stbtt_fontinfo::userdata points to a mutex so our allocator and its counters are only ever entered by one thread at a time.
+static void*    ImFontAtlasBuildStbttAlloc(size_t sz, void* user_data)  { if (!user_data) return ImGui::MemAlloc(sz); std::lock_guard<std::mutex> lock(*(std::mutex*)user_data); return ImGui::MemAlloc(sz); }
+static void     ImFontAtlasBuildStbttFree(void* ptr, void* user_data)   { if (!user_data) { ImGui::MemFree(ptr); return; } std::lock_guard<std::mutex> lock(*(std::mutex*)user_data); ImGui::MemFree(ptr); }
+#define STBTT_malloc(x,u)  ImFontAtlasBuildStbttAlloc(x,u)
+#define STBTT_free(x,u)    ImFontAtlasBuildStbttFree(x,u)
+#else
 #define STBTT_malloc(x,u)  ((void)(u), ImGui::MemAlloc(x))
 #define STBTT_free(x,u)    ((void)(u), ImGui::MemFree(x))
+#endif
 #define STBTT_assert(x)    IM_ASSERT(x)
+#ifdef IMGUI_ENABLE_SSE
+#define STBTT_SSE2
+#endif
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
 #define STBTT_STATIC
 #define STB_TRUETYPE_IMPLEMENTATION
@@ -354,6 +370,7 @@ void ImDrawList::ClearFreeMemory()
 
 void ImDrawList::AddDrawCmd()
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_DrawList);
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = GetCurrentClipRect();
     draw_cmd.TextureId = GetCurrentTextureId();
@@ -391,7 +408,7 @@ void ImDrawList::UpdateClipRect()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = CmdBuffer.Size > 1 ? curr_cmd - 1 : NULL;
-    if (curr_cmd->ElemCount == 0 && prev_cmd && memcmp(&prev_cmd->ClipRect, &curr_clip_rect, sizeof(ImVec4)) == 0 && prev_cmd->TextureId == GetCurrentTextureId() && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && prev_cmd && memcmp(&prev_cmd->ClipRect, &curr_clip_rect, sizeof(ImVec4)) == 0 && prev_cmd->TextureId == GetCurrentTextureId() && prev_cmd->UserCallback == NULL && prev_cmd->ShapeType == ImDrawShape_None && prev_cmd->DistanceField == curr_cmd->DistanceField)
         CmdBuffer.pop_back();
     else
         curr_cmd->ClipRect = curr_clip_rect;
@@ -410,7 +427,7 @@ void ImDrawList::UpdateTextureID()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = CmdBuffer.Size > 1 ? curr_cmd - 1 : NULL;
-    if (curr_cmd->ElemCount == 0 && prev_cmd && prev_cmd->TextureId == curr_texture_id && memcmp(&prev_cmd->ClipRect, &GetCurrentClipRect(), sizeof(ImVec4)) == 0 && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && prev_cmd && prev_cmd->TextureId == curr_texture_id && memcmp(&prev_cmd->ClipRect, &GetCurrentClipRect(), sizeof(ImVec4)) == 0 && prev_cmd->UserCallback == NULL && prev_cmd->ShapeType == ImDrawShape_None && prev_cmd->DistanceField == curr_cmd->DistanceField)
         CmdBuffer.pop_back();
     else
         curr_cmd->TextureId = curr_texture_id;
@@ -422,6 +439,7 @@ void ImDrawList::UpdateTextureID()
 // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
 void ImDrawList::PushClipRect(ImVec2 cr_min, ImVec2 cr_max, bool intersect_with_current_clip_rect)
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_DrawList);
     ImVec4 cr(cr_min.x, cr_min.y, cr_max.x, cr_max.y);
     if (intersect_with_current_clip_rect && _ClipRectStack.Size)
     {
@@ -452,6 +470,7 @@ void ImDrawList::PopClipRect()
 
 void ImDrawList::PushTextureID(ImTextureID texture_id)
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_DrawList);
     _TextureIdStack.push_back(texture_id);
     UpdateTextureID();
 }
@@ -465,6 +484,7 @@ void ImDrawList::PopTextureID()
 
 void ImDrawList::ChannelsSplit(int channels_count)
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_DrawList);
     IM_ASSERT(_ChannelsCurrent == 0 && _ChannelsCount == 1);
     int old_channels_count = _Channels.Size;
     if (old_channels_count < channels_count)
@@ -498,6 +518,7 @@ void ImDrawList::ChannelsSplit(int channels_count)
 
 void ImDrawList::ChannelsMerge()
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_DrawList);
     // Note that we never use or rely on channels.Size because it is merely a buffer that we never shrink back to 0 to keep all sub-buffers ready for use.
     if (_ChannelsCount <= 1)
         return;
@@ -545,6 +566,7 @@ void ImDrawList::ChannelsSetCurrent(int idx)
 // NB: this can be called with negative count for removing primitives (as long as the result does not underflow)
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_DrawList);
     ImDrawCmd& draw_cmd = CmdBuffer.Data[CmdBuffer.Size-1];
     draw_cmd.ElemCount += idx_count;
 
@@ -557,6 +579,60 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
     _IdxWritePtr = IdxBuffer.Data + idx_buffer_old_size;
 }
 
+// A single quad tagged with the shape parameters, evaluated per pixel by the renderer. See ImDrawShape_ for the expected coverage.
+// The shape needs a draw command of its own: we reuse the current one if it is still empty and always open a new one after us, so following primitives are never tagged.
+void ImDrawList::PrimShape(ImDrawShape shape_type, const ImVec2& a, const ImVec2& b, ImU32 col, float rounding, int rounding_corners, float thickness)
+{
+    IM_ASSERT(shape_type != ImDrawShape_None);
+    ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size-1];
+    if (draw_cmd->ElemCount != 0 || draw_cmd->UserCallback != NULL || draw_cmd->ShapeType != ImDrawShape_None)
+    {
+        AddDrawCmd();
+        draw_cmd = &CmdBuffer.Data[CmdBuffer.Size-1];
+    }
+    draw_cmd->ShapeType = shape_type;
+    draw_cmd->ShapeRect = ImVec4(a.x, a.y, b.x, b.y);
+    draw_cmd->ShapeRounding = rounding;
+    draw_cmd->ShapeThickness = thickness;
+    draw_cmd->ShapeCornerFlags = rounding_corners;
+
+    const float fringe = 1.0f + thickness * 0.5f;
+    PrimReserve(6, 4);
+    PrimRect(ImVec2(a.x - fringe, a.y - fringe), ImVec2(b.x + fringe, b.y + fringe), col);
+    AddDrawCmd();
+}
+
+void ImDrawList::PrimBeginDistanceField()
+{
+    ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size-1];
+    if (draw_cmd->DistanceField)
+        return;
+
+    // Resume the previous distance field command if nothing was drawn since it ended
+    ImDrawCmd* prev_cmd = CmdBuffer.Size > 1 ? draw_cmd - 1 : NULL;
+    if (draw_cmd->ElemCount == 0 && draw_cmd->UserCallback == NULL && prev_cmd && prev_cmd->DistanceField && prev_cmd->UserCallback == NULL && prev_cmd->TextureId == draw_cmd->TextureId && memcmp(&prev_cmd->ClipRect, &draw_cmd->ClipRect, sizeof(ImVec4)) == 0)
+    {
+        CmdBuffer.pop_back();
+        return;
+    }
+    if (draw_cmd->ElemCount != 0 || draw_cmd->UserCallback != NULL || draw_cmd->ShapeType != ImDrawShape_None)
+    {
+        AddDrawCmd();
+        draw_cmd = &CmdBuffer.Data[CmdBuffer.Size-1];
+    }
+    draw_cmd->DistanceField = true;
+}
+
+void ImDrawList::PrimEndDistanceField()
+{
+    ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size-1];
+    IM_ASSERT(draw_cmd->DistanceField);
+    if (draw_cmd->ElemCount == 0)
+        draw_cmd->DistanceField = false;
+    else
+        AddDrawCmd();
+}
+
 // Fully unrolled with inline call to keep our debug builds decently fast.
 void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 {
@@ -865,6 +941,7 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
 
 void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int a_min_of_12, int a_max_of_12)
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_DrawList);
     if (radius == 0.0f || a_min_of_12 > a_max_of_12)
     {
         _Path.push_back(centre);
@@ -880,6 +957,7 @@ void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int a_min_of_
 
 void ImDrawList::PathArcTo(const ImVec2& centre, float radius, float a_min, float a_max, int num_segments)
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_DrawList);
     if (radius == 0.0f)
     {
         _Path.push_back(centre);
@@ -921,6 +999,7 @@ static void PathBezierToCasteljau(ImVector<ImVec2>* path, float x1, float y1, fl
 
 void ImDrawList::PathBezierCurveTo(const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments)
 {
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_DrawList);
     ImVec2 p1 = _Path.back();
     if (num_segments == 0)
     {
@@ -943,10 +1022,17 @@ void ImDrawList::PathBezierCurveTo(const ImVec2& p2, const ImVec2& p3, const ImV
     }
 }
 
-void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, int rounding_corners)
+static inline float ImDrawListClampRectRounding(const ImVec2& a, const ImVec2& b, float rounding, int rounding_corners)
 {
     rounding = ImMin(rounding, fabsf(b.x - a.x) * ( ((rounding_corners & ImDrawCornerFlags_Top)  == ImDrawCornerFlags_Top)  || ((rounding_corners & ImDrawCornerFlags_Bot)   == ImDrawCornerFlags_Bot)   ? 0.5f : 1.0f ) - 1.0f);
     rounding = ImMin(rounding, fabsf(b.y - a.y) * ( ((rounding_corners & ImDrawCornerFlags_Left) == ImDrawCornerFlags_Left) || ((rounding_corners & ImDrawCornerFlags_Right) == ImDrawCornerFlags_Right) ? 0.5f : 1.0f ) - 1.0f);
+    return rounding;
+}
+
+void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, int rounding_corners)
+{
+    IM_ALLOC_CATEGORY(ImGuiAllocCategory_DrawList);
+    rounding = ImDrawListClampRectRounding(a, b, rounding, rounding_corners);
 
     if (rounding <= 0.0f || rounding_corners == 0)
     {
@@ -982,6 +1068,13 @@ void ImDrawList::AddRect(const ImVec2& a, const ImVec2& b, ImU32 col, float roun
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (rounding > 0.0f && (Flags & ImDrawListFlags_AnalyticShapes))    // A plain border stays a few triangles in the current draw command, cheaper than a shape with its own draw call
+    {
+        const ImVec2 sa = a + ImVec2(0.5f,0.5f), sb = b - ImVec2(0.5f,0.5f);
+        rounding = ImDrawListClampRectRounding(sa, sb, rounding, rounding_corners_flags);
+        PrimShape(ImDrawShape_Rect, sa, sb, col, ImMax(rounding, 0.0f), rounding_corners_flags, thickness);
+        return;
+    }
     if (Flags & ImDrawListFlags_AntiAliasedLines)
         PathRect(a + ImVec2(0.5f,0.5f), b - ImVec2(0.50f,0.50f), rounding, rounding_corners_flags);
     else
@@ -993,7 +1086,12 @@ void ImDrawList::AddRectFilled(const ImVec2& a, const ImVec2& b, ImU32 col, floa
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
-    if (rounding > 0.0f)
+    if (rounding > 0.0f && (Flags & ImDrawListFlags_AnalyticShapes))
+    {
+        rounding = ImDrawListClampRectRounding(a, b, rounding, rounding_corners_flags);
+        PrimShape(ImDrawShape_RectFilled, a, b, col, ImMax(rounding, 0.0f), rounding_corners_flags, 0.0f);
+    }
+    else if (rounding > 0.0f)
     {
         PathRect(a, b, rounding, rounding_corners_flags);
         PathFillConvex(col);
@@ -1070,6 +1168,12 @@ void ImDrawList::AddCircle(const ImVec2& centre, float radius, ImU32 col, int nu
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (Flags & ImDrawListFlags_AnalyticShapes)
+    {
+        const float r = radius - 0.5f;
+        PrimShape(ImDrawShape_Circle, ImVec2(centre.x - r, centre.y - r), ImVec2(centre.x + r, centre.y + r), col, r, ImDrawCornerFlags_All, thickness);
+        return;
+    }
 
     const float a_max = IM_PI*2.0f * ((float)num_segments - 1.0f) / (float)num_segments;
     PathArcTo(centre, radius-0.5f, 0.0f, a_max, num_segments);
@@ -1080,6 +1184,11 @@ void ImDrawList::AddCircleFilled(const ImVec2& centre, float radius, ImU32 col,
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (Flags & ImDrawListFlags_AnalyticShapes)
+    {
+        PrimShape(ImDrawShape_CircleFilled, ImVec2(centre.x - radius, centre.y - radius), ImVec2(centre.x + radius, centre.y + radius), col, radius, ImDrawCornerFlags_All, 0.0f);
+        return;
+    }
 
     const float a_max = IM_PI*2.0f * ((float)num_segments - 1.0f) / (float)num_segments;
     PathArcTo(centre, radius, 0.0f, a_max, num_segments);
@@ -1220,6 +1329,13 @@ void ImDrawData::ScaleClipRects(const ImVec2& scale)
         {
             ImDrawCmd* cmd = &cmd_list->CmdBuffer[cmd_i];
             cmd->ClipRect = ImVec4(cmd->ClipRect.x * scale.x, cmd->ClipRect.y * scale.y, cmd->ClipRect.z * scale.x, cmd->ClipRect.w * scale.y);
+            if (cmd->ShapeType != ImDrawShape_None)
+            {
+                // Lengths use the mean scale, framebuffers are scaled uniformly in practice
+                cmd->ShapeRect = ImVec4(cmd->ShapeRect.x * scale.x, cmd->ShapeRect.y * scale.y, cmd->ShapeRect.z * scale.x, cmd->ShapeRect.w * scale.y);
+                cmd->ShapeRounding *= (scale.x + scale.y) * 0.5f;
+                cmd->ShapeThickness *= (scale.x + scale.y) * 0.5f;
+            }
         }
     }
 }
@@ -1305,8 +1421,11 @@ ImFontConfig::ImFontConfig()
     MergeMode = false;
     RasterizerFlags = 0x00;
     RasterizerMultiply = 1.0f;
+    DynamicGlyphs = false;
+    DistanceField = false;
     memset(Name, 0, sizeof(Name));
     DstFont = NULL;
+    FontDataCompressedBase85 = NULL;
 }
 
 //-----------------------------------------------------------------------------
@@ -1367,14 +1486,22 @@ ImFontAtlas::ImFontAtlas()
     TexID = NULL;
     TexDesiredWidth = 0;
     TexGlyphPadding = 1;
+    BuildThreadsCount = 0;
+    CacheFilename = NULL;
+    DynamicGlyphsBudget = 1024 * 1024;
+    TexPageHeight = 0;
 
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
     TexWidth = TexHeight = 0;
+    TexPagesCount = 0;
     TexUvScale = ImVec2(0.0f, 0.0f);
     TexUvWhitePixel = ImVec2(0.0f, 0.0f);
     for (int n = 0; n < IM_ARRAYSIZE(CustomRectIds); n++)
         CustomRectIds[n] = -1;
+    PackContext = PackNodes = NULL;
+    PackPage = 0;
+    DynamicFrameCount = 0;
 }
 
 ImFontAtlas::~ImFontAtlas()
@@ -1398,6 +1525,7 @@ void    ImFontAtlas::ClearInputData()
             Fonts[i]->ConfigData = NULL;
             Fonts[i]->ConfigDataCount = 0;
         }
+    ImFontAtlasBuildClearParsedFonts(this);
     ConfigData.clear();
     CustomRects.clear();
     for (int n = 0; n < IM_ARRAYSIZE(CustomRectIds); n++)
@@ -1412,6 +1540,12 @@ void    ImFontAtlas::ClearTexData()
         ImGui::MemFree(TexPixelsRGBA32);
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
+    if (PackContext)
+        ImGui::MemFree(PackContext);
+    if (PackNodes)
+        ImGui::MemFree(PackNodes);
+    PackContext = PackNodes = NULL;
+    PackPage = 0;
 }
 
 void    ImFontAtlas::ClearFonts()
@@ -1419,6 +1553,9 @@ void    ImFontAtlas::ClearFonts()
     for (int i = 0; i < Fonts.Size; i++)
         IM_DELETE(Fonts[i]);
     Fonts.clear();
+    DynamicPages.clear();
+    DynamicRequests.clear();
+    DynamicRequested.Clear();
 }
 
 void    ImFontAtlas::Clear()
@@ -1470,7 +1607,7 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
 
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
-    IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
+    IM_ASSERT((font_cfg->FontData != NULL && font_cfg->FontDataSize > 0) || font_cfg->FontDataCompressedBase85 != NULL);
     IM_ASSERT(font_cfg->SizePixels > 0.0f);
 
     // Create new font
@@ -1483,7 +1620,7 @@ ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
     ImFontConfig& new_font_cfg = ConfigData.back();
     if (!new_font_cfg.DstFont)
         new_font_cfg.DstFont = Fonts.back();
-    if (!new_font_cfg.FontDataOwnedByAtlas)
+    if (!new_font_cfg.FontDataOwnedByAtlas && new_font_cfg.FontData != NULL)
     {
         new_font_cfg.FontData = ImGui::MemAlloc(new_font_cfg.FontDataSize);
         new_font_cfg.FontDataOwnedByAtlas = true;
@@ -1523,8 +1660,12 @@ ImFont* ImFontAtlas::AddFontDefault(const ImFontConfig* font_cfg_template)
     if (font_cfg.Name[0] == '\0') strcpy(font_cfg.Name, "ProggyClean.ttf, 13px");
     if (font_cfg.SizePixels <= 0.0f) font_cfg.SizePixels = 13.0f;
 
-    const char* ttf_compressed_base85 = GetDefaultCompressedFontDataTTFBase85();
-    ImFont* font = AddFontFromMemoryCompressedBase85TTF(ttf_compressed_base85, font_cfg.SizePixels, &font_cfg, GetGlyphRangesDefault());
+    // Decompressed by Build(), unless the atlas is loaded from CacheFilename
+    IM_ASSERT(font_cfg.FontData == NULL);
+    font_cfg.FontDataCompressedBase85 = GetDefaultCompressedFontDataTTFBase85();
+    font_cfg.FontDataOwnedByAtlas = true;
+    font_cfg.GlyphRanges = GetGlyphRangesDefault();
+    ImFont* font = AddFont(&font_cfg);
     font->DisplayOffset.y = 1.0f;
     return font;
 }
@@ -1584,6 +1725,25 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed
     return font;
 }
 
+// Decompress the embedded fonts added by AddFontDefault() which weren't needed yet
+static void ImFontAtlasBuildDecompressFontData(ImFontAtlas* atlas)
+{
+    for (int i = 0; i < atlas->ConfigData.Size; i++)
+    {
+        ImFontConfig& cfg = atlas->ConfigData[i];
+        if (cfg.FontData != NULL || cfg.FontDataCompressedBase85 == NULL)
+            continue;
+        const int compressed_ttf_size = (((int)strlen(cfg.FontDataCompressedBase85) + 4) / 5) * 4;
+        unsigned char* compressed_ttf = (unsigned char*)ImGui::MemAlloc((size_t)compressed_ttf_size);
+        Decode85((const unsigned char*)cfg.FontDataCompressedBase85, compressed_ttf);
+        cfg.FontDataSize = (int)stb_decompress_length(compressed_ttf);
+        cfg.FontData = ImGui::MemAlloc((size_t)cfg.FontDataSize);
+        cfg.FontDataOwnedByAtlas = true;
+        stb_decompress((unsigned char*)cfg.FontData, compressed_ttf, (unsigned int)compressed_ttf_size);
+        ImGui::MemFree(compressed_ttf);
+    }
+}
+
 int ImFontAtlas::AddCustomRectRegular(unsigned int id, int width, int height)
 {
     IM_ASSERT(id >= 0x10000);
@@ -1594,6 +1754,8 @@ int ImFontAtlas::AddCustomRectRegular(unsigned int id, int width, int height)
     r.Width = (unsigned short)width;
     r.Height = (unsigned short)height;
     CustomRects.push_back(r);
+    if (PackContext)
+        ImFontAtlasBuildInsertCustomRect(this, CustomRects.Size - 1);
     return CustomRects.Size - 1; // Return index
 }
 
@@ -1610,9 +1772,24 @@ int ImFontAtlas::AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int
     r.GlyphOffset = offset;
     r.Font = font;
     CustomRects.push_back(r);
+    if (PackContext)
+        ImFontAtlasBuildInsertCustomRect(this, CustomRects.Size - 1);
     return CustomRects.Size - 1; // Return index
 }
 
+void ImFontAtlas::SetTexPageID(int page, ImTextureID id)
+{
+    IM_ASSERT(page >= 0 && page < TexPagesCount);
+    if (page == 0)
+    {
+        TexID = id;
+        return;
+    }
+    if (TexPageIDs.Size < page)
+        TexPageIDs.resize(page, NULL);
+    TexPageIDs[page - 1] = id;
+}
+
 void ImFontAtlas::CalcCustomRectUV(const CustomRect* rect, ImVec2* out_uv_min, ImVec2* out_uv_max)
 {
     IM_ASSERT(TexWidth > 0 && TexHeight > 0);   // Font atlas needs to be built before we can calculate UV coordinates
@@ -1644,7 +1821,27 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 
 bool    ImFontAtlas::Build()
 {
-    return ImFontAtlasBuildWithStbTruetype(this);
+    // The cache only holds the output of the build, atlases with glyphs rasterized on demand are always built from the fonts
+    bool use_cache = (CacheFilename != NULL);
+    for (int i = 0; i < ConfigData.Size; i++)
+        if (ConfigData[i].DynamicGlyphs)
+            use_cache = false;
+
+    if (use_cache && ImFontAtlasBuildLoadCache(this, CacheFilename))
+        return true;
+    if (!ImFontAtlasBuildWithStbTruetype(this))
+        return false;
+    if (use_cache)
+        ImFontAtlasBuildSaveCache(this, CacheFilename);
+    return true;
+}
+
+bool    ImFontAtlas::UpdateDynamicGlyphs()
+{
+    DynamicFrameCount++;
+    if (DynamicRequests.empty())
+        return false;
+    return ImFontAtlasBuildDynamicGlyphs(this);
 }
 
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
@@ -1664,17 +1861,464 @@ void    ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsig
             data[i] = table[data[i]];
 }
 
+// Signed distance field glyphs (ImFontConfig::DistanceField): alpha is 128 on the glyph outline and changes by 32 per pixel, reaching 0 and 255 at IM_FONT_SDF_PADDING pixels away from it.
+#define IM_FONT_SDF_PADDING             4
+#define IM_FONT_SDF_ONEDGE_VALUE        128
+#define IM_FONT_SDF_PIXEL_DIST_SCALE    (128.0f / IM_FONT_SDF_PADDING)
+
+static void ImFontAtlasBuildCalcGlyphSizeSDF(const stbtt_fontinfo& font_info, float scale, int glyph_index, int* out_w, int* out_h)
+{
+    // Matches the size of the bitmap returned by stbtt_GetGlyphSDF()
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBoxSubpixel(&font_info, glyph_index, scale, scale, 0.0f, 0.0f, &x0, &y0, &x1, &y1);
+    const bool empty = (x0 == x1 || y0 == y1);
+    *out_w = empty ? 0 : x1 - x0 + IM_FONT_SDF_PADDING * 2;
+    *out_h = empty ? 0 : y1 - y0 + IM_FONT_SDF_PADDING * 2;
+}
+
+// Render into 'pixels', return glyph offset. Empty glyphs don't write anything.
+static void ImFontAtlasBuildRenderGlyphSDF(const stbtt_fontinfo& font_info, float scale, int glyph_index, unsigned char* pixels, int stride, int* out_xoff, int* out_yoff)
+{
+    int w = 0, h = 0;
+    *out_xoff = *out_yoff = 0;
+    unsigned char* sdf = stbtt_GetGlyphSDF(&font_info, scale, glyph_index, IM_FONT_SDF_PADDING, IM_FONT_SDF_ONEDGE_VALUE, IM_FONT_SDF_PIXEL_DIST_SCALE, &w, &h, out_xoff, out_yoff);
+    if (!sdf)
+        return;
+    for (int y = 0; y < h; y++)
+        memcpy(pixels + y * stride, sdf + y * w, (size_t)w);
+    stbtt_FreeSDF(sdf, font_info.userdata);
+}
+
+// A font file parsed once for every ImFontConfig using it (the same font added at several sizes, or merged into several fonts).
+// stbtt_FindGlyphIndex() binary searches the cmap and stbtt_GetGlyphShape() decodes the outline on every call, instead the cmap is decoded
+// into a two-level table when the font is parsed, and each outline is decoded once and reused for every size and oversampling level.
+struct ImFontParsedData
+{
+    struct GlyphShape
+    {
+        int                     VerticesOffset;     // Offset in ShapesVertices, -1 when not decoded yet
+        int                     VerticesCount;
+    };
+
+    const void*                 FontData;           // Data of the first ImFontConfig using the font
+    int                         FontDataSize;
+    int                         FontNo;
+    stbtt_fontinfo              FontInfo;
+    bool                        CmapDecoded;        // False for cmap subtables formats we don't decode, FindGlyphIndex() then uses stbtt_FindGlyphIndex()
+    ImVector<unsigned short>    CmapPageMap;        // Offset in CmapPages of the glyph indices of codepoints [n*256, n*256+255], divided by 256. Pages without glyphs map to the empty page 0.
+    ImVector<unsigned short>    CmapPages;          // Glyph indices, 256 per page
+    ImVector<GlyphShape>        Shapes;             // Indexed by glyph index
+    ImVector<stbtt_vertex>      ShapesVertices;
+
+    bool    Init(const ImFontConfig& cfg);
+    void    DecodeCmap(const unsigned char* data_end);
+    void    SetGlyphIndex(unsigned int codepoint, unsigned int glyph_index);
+    int     FindGlyphIndex(unsigned int codepoint) const
+    {
+        if (!CmapDecoded)
+            return stbtt_FindGlyphIndex(&FontInfo, (int)codepoint);
+        return ((codepoint >> 8) < (unsigned int)CmapPageMap.Size) ? CmapPages.Data[CmapPageMap.Data[codepoint >> 8] * 256 + (codepoint & 0xFF)] : 0;
+    }
+    void    DecodeGlyphShape(int glyph_index);
+    void    ClearShapes() { Shapes.clear(); ShapesVertices.clear(); }
+    void    MakeGlyphBitmap(unsigned char* output, int out_w, int out_h, int out_stride, float scale_x, float scale_y, int glyph_index) const;
+};
+
+static inline unsigned int ImFontReadU16(const unsigned char* p) { return ((unsigned int)p[0] << 8) | p[1]; }
+static inline unsigned int ImFontReadU32(const unsigned char* p) { return ((unsigned int)p[0] << 24) | ((unsigned int)p[1] << 16) | ((unsigned int)p[2] << 8) | p[3]; }
+
+bool ImFontParsedData::Init(const ImFontConfig& cfg)
+{
+    FontData = cfg.FontData;
+    FontDataSize = cfg.FontDataSize;
+    FontNo = cfg.FontNo;
+    const int font_offset = stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo);
+    if (font_offset < 0 || !stbtt_InitFont(&FontInfo, (unsigned char*)cfg.FontData, font_offset))
+        return false;
+    FontInfo.userdata = NULL;
+    DecodeCmap((const unsigned char*)cfg.FontData + cfg.FontDataSize);
+    return true;
+}
+
+// Same mapping as stbtt_FindGlyphIndex() with the subtable selected by stbtt_InitFont(). Subtables not fitting in the font data are left to stbtt.
+void ImFontParsedData::DecodeCmap(const unsigned char* data_end)
+{
+    const unsigned char* cmap = FontInfo.data + FontInfo.index_map;
+    const unsigned int format = ImFontReadU16(cmap);
+    CmapDecoded = false;
+    CmapPageMap.clear();
+    CmapPages.resize(256);
+    memset(CmapPages.Data, 0, 256 * sizeof(unsigned short));
+    if (format == 0 && cmap + 6 + 256 <= data_end)
+    {
+        const int count = ImMin((int)ImFontReadU16(cmap + 2) - 6, 256);
+        for (int c = 0; c < count; c++)
+            SetGlyphIndex((unsigned int)c, cmap[6 + c]);
+    }
+    else if (format == 6 && cmap + 10 + ImFontReadU16(cmap + 8) * 2 <= data_end)
+    {
+        const unsigned int first = ImFontReadU16(cmap + 6), count = ImFontReadU16(cmap + 8);
+        for (unsigned int n = 0; n < count; n++)
+            SetGlyphIndex(first + n, ImFontReadU16(cmap + 10 + n * 2));
+    }
+    else if (format == 4 && cmap + 16 + (ImFontReadU16(cmap + 6) >> 1) * 8 <= data_end)
+    {
+        const unsigned int segments_count = ImFontReadU16(cmap + 6) >> 1;
+        const unsigned char* end_codes = cmap + 14;
+        const unsigned char* start_codes = end_codes + segments_count * 2 + 2;
+        const unsigned char* id_deltas = start_codes + segments_count * 2;
+        const unsigned char* id_range_offsets = id_deltas + segments_count * 2;
+        for (unsigned int seg = 0; seg < segments_count; seg++)
+        {
+            const unsigned int start = ImFontReadU16(start_codes + seg * 2), end = ImFontReadU16(end_codes + seg * 2);
+            const unsigned int id_delta = ImFontReadU16(id_deltas + seg * 2), id_range_offset = ImFontReadU16(id_range_offsets + seg * 2);
+            for (unsigned int c = start; c <= end; c++)
+            {
+                // Like stbtt, idDelta is only applied to segments without a glyph index array
+                const unsigned char* glyph_index = id_range_offsets + seg * 2 + id_range_offset + (c - start) * 2;
+                if (id_range_offset == 0)
+                    SetGlyphIndex(c, (c + id_delta) & 0xFFFF);
+                else if (glyph_index + 2 <= data_end)
+                    SetGlyphIndex(c, ImFontReadU16(glyph_index));
+            }
+        }
+    }
+    else if ((format == 12 || format == 13) && cmap + 16 + (size_t)ImFontReadU32(cmap + 12) * 12 <= data_end)
+    {
+        const unsigned int groups_count = ImFontReadU32(cmap + 12);
+        for (unsigned int group = 0; group < groups_count; group++)
+        {
+            const unsigned char* p = cmap + 16 + group * 12;
+            const unsigned int start = ImFontReadU32(p), start_glyph = ImFontReadU32(p + 8);
+            const unsigned int end = (ImFontReadU32(p + 4) < IM_UNICODE_CODEPOINT_MAX) ? ImFontReadU32(p + 4) : IM_UNICODE_CODEPOINT_MAX;
+            for (unsigned int c = start; c <= end; c++)
+                SetGlyphIndex(c, (format == 12) ? start_glyph + (c - start) : start_glyph);
+        }
+    }
+    else
+    {
+        return;
+    }
+    CmapDecoded = true;
+}
+
+void ImFontParsedData::SetGlyphIndex(unsigned int codepoint, unsigned int glyph_index)
+{
+    if (glyph_index == 0 || glyph_index > 0xFFFF || codepoint > IM_UNICODE_CODEPOINT_MAX)
+        return;
+    const int page_n = (int)(codepoint >> 8);
+    if (page_n >= CmapPageMap.Size)
+    {
+        const int old_size = CmapPageMap.Size;
+        CmapPageMap.resize(page_n + 1);
+        memset(CmapPageMap.Data + old_size, 0, (size_t)(CmapPageMap.Size - old_size) * sizeof(unsigned short));
+    }
+    if (CmapPageMap[page_n] == 0)
+    {
+        CmapPageMap[page_n] = (unsigned short)(CmapPages.Size / 256);
+        CmapPages.resize(CmapPages.Size + 256);
+        memset(CmapPages.Data + CmapPages.Size - 256, 0, 256 * sizeof(unsigned short));
+    }
+    CmapPages[CmapPageMap[page_n] * 256 + (codepoint & 0xFF)] = (unsigned short)glyph_index;
+}
+
+void ImFontParsedData::DecodeGlyphShape(int glyph_index)
+{
+    if (glyph_index >= Shapes.Size)
+    {
+        const int old_size = Shapes.Size;
+        Shapes.resize(ImMax(glyph_index + 1, FontInfo.numGlyphs));
+        for (int n = old_size; n < Shapes.Size; n++)
+            Shapes[n].VerticesOffset = -1;
+    }
+    GlyphShape& shape = Shapes[glyph_index];
+    if (shape.VerticesOffset >= 0)
+        return;
+    stbtt_vertex* vertices = NULL;
+    shape.VerticesCount = stbtt_GetGlyphShape(&FontInfo, glyph_index, &vertices);
+    shape.VerticesOffset = ShapesVertices.Size;
+    if (shape.VerticesCount > 0)
+    {
+        ShapesVertices.resize(ShapesVertices.Size + shape.VerticesCount);
+        memcpy(ShapesVertices.Data + shape.VerticesOffset, vertices, (size_t)shape.VerticesCount * sizeof(stbtt_vertex));
+    }
+    stbtt_FreeShape(&FontInfo, vertices);
+}
+
+// Same as stbtt_MakeGlyphBitmapSubpixel() with no shift, from the outline decoded by DecodeGlyphShape(). Doesn't modify the parsed font so rasterization jobs can share it.
+void ImFontParsedData::MakeGlyphBitmap(unsigned char* output, int out_w, int out_h, int out_stride, float scale_x, float scale_y, int glyph_index) const
+{
+    IM_ASSERT(glyph_index < Shapes.Size && Shapes[glyph_index].VerticesOffset >= 0);
+    const GlyphShape& shape = Shapes[glyph_index];
+    int ix0, iy0;
+    stbtt_GetGlyphBitmapBoxSubpixel(&FontInfo, glyph_index, scale_x, scale_y, 0.0f, 0.0f, &ix0, &iy0, NULL, NULL);
+    stbtt__bitmap gbm;
+    gbm.pixels = output;
+    gbm.w = out_w;
+    gbm.h = out_h;
+    gbm.stride = out_stride;
+    if (gbm.w && gbm.h)
+        stbtt_Rasterize(&gbm, 0.35f, (stbtt_vertex*)ShapesVertices.Data + shape.VerticesOffset, shape.VerticesCount, scale_x, scale_y, 0.0f, 0.0f, ix0, iy0, 1, FontInfo.userdata);
+}
+
+static ImFontParsedData* ImFontAtlasBuildGetParsedFont(ImFontAtlas* atlas, const ImFontConfig& cfg)
+{
+    // The same file loaded once per size has distinct copies of the data, compare their contents
+    for (int i = 0; i < atlas->ParsedFonts.Size; i++)
+    {
+        ImFontParsedData* font = atlas->ParsedFonts[i];
+        if (font->FontNo == cfg.FontNo && font->FontDataSize == cfg.FontDataSize && (font->FontData == cfg.FontData || memcmp(font->FontData, cfg.FontData, (size_t)cfg.FontDataSize) == 0))
+            return font;
+    }
+    ImFontParsedData* font = IM_NEW(ImFontParsedData);
+    if (!font->Init(cfg))
+    {
+        IM_DELETE(font);
+        return NULL;
+    }
+    atlas->ParsedFonts.push_back(font);
+    return font;
+}
+
+void ImFontAtlasBuildClearParsedFonts(ImFontAtlas* atlas)
+{
+    for (int i = 0; i < atlas->ParsedFonts.Size; i++)
+        IM_DELETE(atlas->ParsedFonts[i]);
+    atlas->ParsedFonts.clear();
+}
+
+struct ImFontTempBuildData
+{
+    ImFontParsedData*   Font;
+    stbrp_rect*         Rects;
+    int                 RectsCount;
+    stbtt_pack_range*   Ranges;
+    int                 RangesCount;
+};
+
+// Pixels of the texture page holding a packed rectangle. Rectangles are packed in page coordinates, with their page stored in stbrp_rect::id.
+static inline unsigned char* ImFontAtlasBuildGetPagePixels(const stbtt_pack_context& spc, const stbrp_rect& r)
+{
+    return spc.pixels + (size_t)r.id * spc.height * spc.stride_in_bytes;
+}
+
+// A slice of a packed range, rasterized independently from the others. Each glyph owns its rectangle in the texture so jobs may run in any order (or concurrently) and still produce the same pixels.
+struct ImFontBuildRasterJob
+{
+    const ImFontConfig*     Cfg;
+    ImFontTempBuildData*    Tmp;
+    stbtt_pack_range        Range;
+    stbrp_rect*             Rects;
+};
+
+// Equivalent of stbtt_PackFontRangesGatherRects(). Also decodes the outline of every glyph, so rasterization jobs only read the parsed font.
+static int ImFontAtlasBuildGatherRects(const stbtt_pack_context& spc, ImFontTempBuildData& tmp)
+{
+    ImFontParsedData& font = *tmp.Font;
+    int k = 0;
+    for (int i = 0; i < tmp.RangesCount; i++)
+    {
+        stbtt_pack_range& range = tmp.Ranges[i];
+        const float scale = stbtt_ScaleForPixelHeight(&font.FontInfo, range.font_size);
+        range.h_oversample = (unsigned char)spc.h_oversample;
+        range.v_oversample = (unsigned char)spc.v_oversample;
+        for (int j = 0; j < range.num_chars; j++, k++)
+        {
+            const int glyph_index = font.FindGlyphIndex(range.first_unicode_codepoint_in_range + j);
+            int x0, y0, x1, y1;
+            stbtt_GetGlyphBitmapBoxSubpixel(&font.FontInfo, glyph_index, scale * spc.h_oversample, scale * spc.v_oversample, 0.0f, 0.0f, &x0, &y0, &x1, &y1);
+            tmp.Rects[k].w = (stbrp_coord)(x1 - x0 + spc.padding + spc.h_oversample - 1);
+            tmp.Rects[k].h = (stbrp_coord)(y1 - y0 + spc.padding + spc.v_oversample - 1);
+            font.DecodeGlyphShape(glyph_index);
+        }
+    }
+    return k;
+}
+
+// Equivalent of stbtt_PackFontRangesRenderIntoRects(), with the outlines decoded by ImFontAtlasBuildGatherRects(). Like stbtt, the padding is removed from the rectangles.
+static void ImFontAtlasBuildRenderRange(const stbtt_pack_context& spc, const ImFontParsedData& font, stbtt_pack_range& range, stbrp_rect* rects)
+{
+    const float scale = stbtt_ScaleForPixelHeight(&font.FontInfo, range.font_size);
+    const int oversample_h = range.h_oversample, oversample_v = range.v_oversample;
+    const float recip_h = 1.0f / oversample_h, recip_v = 1.0f / oversample_v;
+    const float sub_x = stbtt__oversample_shift(oversample_h), sub_y = stbtt__oversample_shift(oversample_v);
+    for (int j = 0; j < range.num_chars; j++)
+    {
+        stbrp_rect& r = rects[j];
+        if (!r.was_packed)
+            continue;
+        const int glyph_index = font.FindGlyphIndex(range.first_unicode_codepoint_in_range + j);
+        r.x += (stbrp_coord)spc.padding;
+        r.y += (stbrp_coord)spc.padding;
+        r.w -= (stbrp_coord)spc.padding;
+        r.h -= (stbrp_coord)spc.padding;
+        int advance, lsb, x0, y0, x1, y1;
+        stbtt_GetGlyphHMetrics(&font.FontInfo, glyph_index, &advance, &lsb);
+        stbtt_GetGlyphBitmapBox(&font.FontInfo, glyph_index, scale * oversample_h, scale * oversample_v, &x0, &y0, &x1, &y1);
+        unsigned char* pixels = ImFontAtlasBuildGetPagePixels(spc, r) + r.x + r.y * spc.stride_in_bytes;
+        font.MakeGlyphBitmap(pixels, r.w - oversample_h + 1, r.h - oversample_v + 1, spc.stride_in_bytes, scale * oversample_h, scale * oversample_v, glyph_index);
+        if (oversample_h > 1)
+            stbtt__h_prefilter(pixels, r.w, r.h, spc.stride_in_bytes, oversample_h);
+        if (oversample_v > 1)
+            stbtt__v_prefilter(pixels, r.w, r.h, spc.stride_in_bytes, oversample_v);
+        stbtt_packedchar& bc = range.chardata_for_range[j];
+        bc.x0 = (unsigned short)r.x;
+        bc.y0 = (unsigned short)r.y;
+        bc.x1 = (unsigned short)(r.x + r.w);
+        bc.y1 = (unsigned short)(r.y + r.h);
+        bc.xadvance = scale * advance;
+        bc.xoff = (float)x0 * recip_h + sub_x;
+        bc.yoff = (float)y0 * recip_v + sub_y;
+        bc.xoff2 = (x0 + r.w) * recip_h + sub_x;
+        bc.yoff2 = (y0 + r.h) * recip_v + sub_y;
+    }
+}
+
+// Equivalent of stbtt_PackFontRangesGatherRects() for signed distance field glyphs. Oversampling doesn't apply to them.
+static int ImFontAtlasBuildGatherRectsSDF(const stbtt_pack_context& spc, ImFontTempBuildData& tmp)
+{
+    int k = 0;
+    for (int i = 0; i < tmp.RangesCount; i++)
+    {
+        stbtt_pack_range& range = tmp.Ranges[i];
+        const float scale = stbtt_ScaleForPixelHeight(&tmp.Font->FontInfo, range.font_size);
+        range.h_oversample = range.v_oversample = 1;
+        for (int j = 0; j < range.num_chars; j++, k++)
+        {
+            int w, h;
+            ImFontAtlasBuildCalcGlyphSizeSDF(tmp.Font->FontInfo, scale, tmp.Font->FindGlyphIndex(range.first_unicode_codepoint_in_range + j), &w, &h);
+            tmp.Rects[k].w = (stbrp_coord)(w + spc.padding);
+            tmp.Rects[k].h = (stbrp_coord)(h + spc.padding);
+        }
+    }
+    return k;
+}
+
+// Equivalent of stbtt_PackFontRangesRenderIntoRects() for signed distance field glyphs
+static void ImFontAtlasBuildRenderRangeSDF(const stbtt_pack_context& spc, const ImFontParsedData& font, stbtt_pack_range& range, stbrp_rect* rects)
+{
+    const stbtt_fontinfo& font_info = font.FontInfo;
+    const float scale = stbtt_ScaleForPixelHeight(&font_info, range.font_size);
+    for (int j = 0; j < range.num_chars; j++)
+    {
+        stbrp_rect& r = rects[j];
+        if (!r.was_packed)
+            continue;
+        const int glyph_index = font.FindGlyphIndex(range.first_unicode_codepoint_in_range + j);
+        const int x = r.x + spc.padding, y = r.y + spc.padding, w = r.w - spc.padding, h = r.h - spc.padding;
+        int advance, lsb, xoff, yoff;
+        stbtt_GetGlyphHMetrics(&font_info, glyph_index, &advance, &lsb);
+        ImFontAtlasBuildRenderGlyphSDF(font_info, scale, glyph_index, ImFontAtlasBuildGetPagePixels(spc, r) + x + y * spc.stride_in_bytes, spc.stride_in_bytes, &xoff, &yoff);
+        stbtt_packedchar& bc = range.chardata_for_range[j];
+        bc.x0 = (unsigned short)x;
+        bc.y0 = (unsigned short)y;
+        bc.x1 = (unsigned short)(x + w);
+        bc.y1 = (unsigned short)(y + h);
+        bc.xadvance = scale * advance;
+        bc.xoff = (float)xoff;
+        bc.yoff = (float)yoff;
+        bc.xoff2 = (float)(xoff + w);
+        bc.yoff2 = (float)(yoff + h);
+    }
+}
+
+static void ImFontAtlasBuildRasterizeJob(const stbtt_pack_context& spc, ImFontBuildRasterJob& job)
+{
+    if (job.Cfg->DistanceField)
+    {
+        ImFontAtlasBuildRenderRangeSDF(spc, *job.Tmp->Font, job.Range, job.Rects);
+        return;
+    }
+    ImFontAtlasBuildRenderRange(spc, *job.Tmp->Font, job.Range, job.Rects);
+    if (job.Cfg->RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, job.Cfg->RasterizerMultiply);
+        for (const stbrp_rect* r = job.Rects; r != job.Rects + job.Range.num_chars; r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, ImFontAtlasBuildGetPagePixels(spc, *r), r->x, r->y, r->w, r->h, spc.stride_in_bytes);
+    }
+}
+
+// Skyline of a texture page, allocated like stbtt_PackBegin() does
+struct ImFontAtlasBuildPackPage
+{
+    stbrp_context*  Context;
+    stbrp_node*     Nodes;
+};
+
+static void ImFontAtlasBuildInitPackPage(ImFontAtlasBuildPackPage& page, int width, int height, int padding)
+{
+    stbrp_init_target(page.Context, width - padding, height - padding, page.Nodes, width - padding);
+}
+
+// Pack rectangles into the last page, then into new pages for those which didn't fit (when using texture pages).
+// Rectangles larger than a page are left unpacked. The page of each packed rectangle is stored in its 'id' field.
+static void ImFontAtlasBuildPackRects(ImVector<ImFontAtlasBuildPackPage>& pages, bool multiple_pages, int width, int height, int padding, stbrp_rect* rects, int rects_count)
+{
+    stbrp_pack_rects(pages.back().Context, rects, rects_count);
+    for (int i = 0; i < rects_count; i++)
+        rects[i].id = pages.Size - 1;
+    if (!multiple_pages)
+        return;
+
+    ImVector<stbrp_rect> page_rects;
+    for (;;)
+    {
+        page_rects.resize(0);
+        for (int i = 0; i < rects_count; i++)
+            if (!rects[i].was_packed && rects[i].w <= width - padding && rects[i].h <= height - padding)
+            {
+                page_rects.push_back(rects[i]);
+                page_rects.back().id = i;
+            }
+        if (page_rects.empty())
+            break;
+
+        ImFontAtlasBuildPackPage page;
+        page.Context = (stbrp_context*)ImGui::MemAlloc(sizeof(stbrp_context));
+        page.Nodes = (stbrp_node*)ImGui::MemAlloc(sizeof(stbrp_node) * (width - padding));
+        ImFontAtlasBuildInitPackPage(page, width, height, padding);
+        pages.push_back(page);
+        stbrp_pack_rects(page.Context, page_rects.Data, page_rects.Size);
+        for (int n = 0; n < page_rects.Size; n++)
+            if (page_rects[n].was_packed)
+            {
+                stbrp_rect& r = rects[page_rects[n].id];
+                r.x = page_rects[n].x;
+                r.y = page_rects[n].y;
+                r.was_packed = 1;
+                r.id = pages.Size - 1;
+            }
+    }
+}
+
+// Move a row to the start of the next texture page when a band of 'height' rows starting at it would straddle two pages
+static inline int ImFontAtlasBuildAlignToPage(int y, int height, int page_height)
+{
+    if (page_height <= 0 || y % page_height + height <= page_height)
+        return y;
+    return (y / page_height + 1) * page_height;
+}
+
 bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
-
-    ImFontAtlasBuildRegisterDefaultCustomRects(atlas);
+    ImFontAtlasBuildDecompressFontData(atlas);
 
     atlas->TexID = NULL;
+    atlas->TexPageIDs.clear();
     atlas->TexWidth = atlas->TexHeight = 0;
+    atlas->TexPagesCount = 0;
     atlas->TexUvScale = ImVec2(0.0f, 0.0f);
     atlas->TexUvWhitePixel = ImVec2(0.0f, 0.0f);
     atlas->ClearTexData();
+    atlas->ClearTexDirty();
+
+    ImFontAtlasBuildRegisterDefaultCustomRects(atlas);
+    atlas->DynamicPages.clear();
+    atlas->DynamicRequests.clear();
+    atlas->DynamicRequested.Clear();
 
     // Count glyphs/ranges
     int total_glyphs_count = 0;
@@ -1693,25 +2337,25 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     atlas->TexWidth = (atlas->TexDesiredWidth > 0) ? atlas->TexDesiredWidth : (total_glyphs_count > 4000) ? 4096 : (total_glyphs_count > 2000) ? 2048 : (total_glyphs_count > 1000) ? 1024 : 512;
     atlas->TexHeight = 0;
 
-    // Start packing
+    // Start packing. With texture pages, each page has its own skyline and rectangles are packed in page coordinates.
     const int max_tex_height = 1024*32;
+    const bool use_pages = (atlas->TexPageHeight > 0);
+    const int page_height = use_pages ? atlas->TexPageHeight : max_tex_height;
     stbtt_pack_context spc = {};
-    if (!stbtt_PackBegin(&spc, NULL, atlas->TexWidth, max_tex_height, 0, atlas->TexGlyphPadding, NULL))
+    if (!stbtt_PackBegin(&spc, NULL, atlas->TexWidth, page_height, 0, atlas->TexGlyphPadding, NULL))
         return false;
     stbtt_PackSetOversampling(&spc, 1, 1);
+    ImVector<ImFontAtlasBuildPackPage> pack_pages;
+    pack_pages.resize(1);
+    pack_pages[0].Context = (stbrp_context*)spc.pack_info;
+    pack_pages[0].Nodes = (stbrp_node*)spc.nodes;
+    spc.pack_info = NULL;
+    spc.nodes = NULL;
 
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
-    ImFontAtlasBuildPackCustomRects(atlas, spc.pack_info);
+    ImFontAtlasBuildPackCustomRects(atlas, pack_pages[0].Context);
 
-    // Initialize font information (so we can error without any cleanup)
-    struct ImFontTempBuildData
-    {
-        stbtt_fontinfo      FontInfo;
-        stbrp_rect*         Rects;
-        int                 RectsCount;
-        stbtt_pack_range*   Ranges;
-        int                 RangesCount;
-    };
+    // Initialize font information (so we can error without any cleanup). Configs using the same font data share its parsed font.
     ImFontTempBuildData* tmp_array = (ImFontTempBuildData*)ImGui::MemAlloc((size_t)atlas->ConfigData.Size * sizeof(ImFontTempBuildData));
     for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
     {
@@ -1719,11 +2363,13 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         ImFontTempBuildData& tmp = tmp_array[input_i];
         IM_ASSERT(cfg.DstFont && (!cfg.DstFont->IsLoaded() || cfg.DstFont->ContainerAtlas == atlas));
 
-        const int font_offset = stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo);
-        IM_ASSERT(font_offset >= 0);
-        if (!stbtt_InitFont(&tmp.FontInfo, (unsigned char*)cfg.FontData, font_offset))
+        IM_ASSERT(stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo) >= 0);
+        tmp.Font = ImFontAtlasBuildGetParsedFont(atlas, cfg);
+        if (tmp.Font == NULL)
         {
             atlas->TexWidth = atlas->TexHeight = 0; // Reset output on failure
+            ImGui::MemFree(pack_pages[0].Context);
+            ImGui::MemFree(pack_pages[0].Nodes);
             ImGui::MemFree(tmp_array);
             return false;
         }
@@ -1768,49 +2414,142 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         tmp.RectsCount = font_glyphs_count;
         buf_rects_n += font_glyphs_count;
         stbtt_PackSetOversampling(&spc, cfg.OversampleH, cfg.OversampleV);
-        int n = stbtt_PackFontRangesGatherRects(&spc, &tmp.FontInfo, tmp.Ranges, tmp.RangesCount, tmp.Rects);
+        int n = cfg.DistanceField ? ImFontAtlasBuildGatherRectsSDF(spc, tmp) : ImFontAtlasBuildGatherRects(spc, tmp);
         IM_ASSERT(n == font_glyphs_count);
-        stbrp_pack_rects((stbrp_context*)spc.pack_info, tmp.Rects, n);
+        ImFontAtlasBuildPackRects(pack_pages, use_pages, atlas->TexWidth, page_height, spc.padding, tmp.Rects, n);
 
         // Extend texture height
         for (int i = 0; i < n; i++)
             if (tmp.Rects[i].was_packed)
-                atlas->TexHeight = ImMax(atlas->TexHeight, tmp.Rects[i].y + tmp.Rects[i].h);
+                atlas->TexHeight = ImMax(atlas->TexHeight, tmp.Rects[i].id * page_height + tmp.Rects[i].y + tmp.Rects[i].h);
     }
     IM_ASSERT(buf_rects_n == total_glyphs_count);
     IM_ASSERT(buf_packedchars_n == total_glyphs_count);
     IM_ASSERT(buf_ranges_n == total_ranges_count);
 
+    // Reserve pages below the packed glyphs for glyphs rasterized on demand.
+    // Pages are sized to hold a few rows of the tallest dynamic font, any space left by rounding the height up is used for more pages.
+    // With texture pages, a page of dynamic glyphs never straddles two texture pages.
+    int dynamic_page_height = 0;
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+        if (atlas->ConfigData[input_i].DynamicGlyphs)
+        {
+            const ImFontConfig& cfg = atlas->ConfigData[input_i];
+            const int glyph_height = cfg.DistanceField ? (int)(cfg.SizePixels * 1.5f) + IM_FONT_SDF_PADDING * 2 : (int)(cfg.SizePixels * 1.5f) * cfg.OversampleV;
+            dynamic_page_height = ImMin(ImMax(dynamic_page_height, (glyph_height + atlas->TexGlyphPadding) * 4), page_height);
+        }
+    const int tex_page_align = use_pages ? page_height : 0;
+    const int dynamic_pages_y = ImFontAtlasBuildAlignToPage(atlas->TexHeight + atlas->TexGlyphPadding, dynamic_page_height, tex_page_align);
+    if (dynamic_page_height > 0)
+    {
+        const int dynamic_pages_count = ImMax(4, atlas->DynamicGlyphsBudget / (atlas->TexWidth * dynamic_page_height));
+        atlas->TexHeight = dynamic_pages_y;
+        for (int n = 0; n < dynamic_pages_count; n++)
+            atlas->TexHeight = ImFontAtlasBuildAlignToPage(atlas->TexHeight, dynamic_page_height, tex_page_align) + dynamic_page_height;
+    }
+
     // Create texture
-    atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
-    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+    if (use_pages)
+    {
+        atlas->TexPagesCount = (atlas->TexHeight + page_height - 1) / page_height;
+        atlas->TexHeight = atlas->TexPagesCount * page_height;
+    }
+    else
+    {
+        atlas->TexPagesCount = 1;
+        atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
+    }
+    const int tex_page_height = atlas->GetTexPageHeight();
+
+    // Keep the skyline of the last page for rectangles added after the build, limited to the texture rows above the dynamic glyph pages
+    const int pack_page_y = (pack_pages.Size - 1) * page_height;
+    pack_pages.back().Context->height = ImMin((dynamic_page_height > 0 ? dynamic_pages_y : atlas->TexHeight) - pack_page_y, tex_page_height) - spc.padding;
+    for (int page_y = dynamic_pages_y; dynamic_page_height > 0 && page_y + dynamic_page_height <= atlas->TexHeight; page_y = ImFontAtlasBuildAlignToPage(page_y + dynamic_page_height, dynamic_page_height, tex_page_align))
+    {
+        ImFontAtlas::DynamicGlyphPage page;
+        memset(&page, 0, sizeof(page));
+        page.Y = page_y;
+        page.Height = dynamic_page_height;
+        atlas->DynamicPages.push_back(page);
+    }
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / tex_page_height);
     atlas->TexPixelsAlpha8 = (unsigned char*)ImGui::MemAlloc(atlas->TexWidth * atlas->TexHeight);
     memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
     spc.pixels = atlas->TexPixelsAlpha8;
-    spc.height = atlas->TexHeight;
+    spc.height = tex_page_height;
 
     // Second pass: render font characters
+    // Glyphs are independent once packed, so we split the ranges into jobs of up to 64 glyphs which can be spread over worker threads.
+    const int glyphs_per_job = 64;
+    ImVector<ImFontBuildRasterJob> jobs;
     for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
     {
         ImFontConfig& cfg = atlas->ConfigData[input_i];
         ImFontTempBuildData& tmp = tmp_array[input_i];
-        stbtt_PackSetOversampling(&spc, cfg.OversampleH, cfg.OversampleV);
-        stbtt_PackFontRangesRenderIntoRects(&spc, &tmp.FontInfo, tmp.Ranges, tmp.RangesCount, tmp.Rects);
-        if (cfg.RasterizerMultiply != 1.0f)
+        stbrp_rect* rects = tmp.Rects;
+        for (int range_i = 0; range_i < tmp.RangesCount; range_i++)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            for (const stbrp_rect* r = tmp.Rects; r != tmp.Rects + tmp.RectsCount; r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, spc.pixels, r->x, r->y, r->w, r->h, spc.stride_in_bytes);
+            const stbtt_pack_range& range = tmp.Ranges[range_i];
+            for (int char_idx = 0; char_idx < range.num_chars; char_idx += glyphs_per_job)
+            {
+                ImFontBuildRasterJob job;
+                job.Cfg = &cfg;
+                job.Tmp = &tmp;
+                job.Range = range;
+                job.Range.first_unicode_codepoint_in_range = range.first_unicode_codepoint_in_range + char_idx;
+                job.Range.chardata_for_range = range.chardata_for_range + char_idx;
+                job.Range.num_chars = ImMin(glyphs_per_job, range.num_chars - char_idx);
+                job.Rects = rects;
+                rects += job.Range.num_chars;
+                jobs.push_back(job);
+            }
         }
-        tmp.Rects = NULL;
+        IM_ASSERT(rects == tmp.Rects + tmp.RectsCount);
+    }
+
+#ifdef IMGUI_ENABLE_FONT_ATLAS_BUILD_THREADS
+    const int threads_count = ImMin(ImMin(atlas->BuildThreadsCount > 0 ? atlas->BuildThreadsCount : (int)std::thread::hardware_concurrency(), jobs.Size), 32);
+    if (threads_count > 1)
+    {
+        std::mutex alloc_mutex;
+        for (int i = 0; i < atlas->ParsedFonts.Size; i++)
+            atlas->ParsedFonts[i]->FontInfo.userdata = &alloc_mutex;
+
+        std::atomic<int> next_job(0);
+        auto worker_func = [&]() { for (int job_i = next_job++; job_i < jobs.Size; job_i = next_job++) ImFontAtlasBuildRasterizeJob(spc, jobs[job_i]); };
+        std::thread workers[32];
+        for (int thread_i = 1; thread_i < threads_count; thread_i++)
+            workers[thread_i] = std::thread(worker_func);
+        worker_func();
+        for (int thread_i = 1; thread_i < threads_count; thread_i++)
+            workers[thread_i].join();
+
+        for (int i = 0; i < atlas->ParsedFonts.Size; i++)
+            atlas->ParsedFonts[i]->FontInfo.userdata = NULL;
+    }
+    else
+#endif
+    {
+        for (int job_i = 0; job_i < jobs.Size; job_i++)
+            ImFontAtlasBuildRasterizeJob(spc, jobs[job_i]);
     }
+    jobs.clear();
+
+    // Outlines are only reused within a build, glyphs rasterized on demand decode theirs again
+    for (int i = 0; i < atlas->ParsedFonts.Size; i++)
+        atlas->ParsedFonts[i]->ClearShapes();
 
-    // End packing
+    // End packing, the atlas takes ownership of the skyline of the last page
+    atlas->PackContext = pack_pages.back().Context;
+    atlas->PackNodes = pack_pages.back().Nodes;
+    atlas->PackPage = pack_pages.Size - 1;
+    for (int i = 0; i < pack_pages.Size - 1; i++)
+    {
+        ImGui::MemFree(pack_pages[i].Context);
+        ImGui::MemFree(pack_pages[i].Nodes);
+    }
+    pack_pages.clear();
     stbtt_PackEnd(&spc);
-    ImGui::MemFree(buf_rects);
-    buf_rects = NULL;
 
     // Third pass: setup ImFont and glyphs for runtime
     for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
@@ -1821,9 +2560,9 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         if (cfg.MergeMode)
             dst_font->BuildLookupTable();
 
-        const float font_scale = stbtt_ScaleForPixelHeight(&tmp.FontInfo, cfg.SizePixels);
+        const float font_scale = stbtt_ScaleForPixelHeight(&tmp.Font->FontInfo, cfg.SizePixels);
         int unscaled_ascent, unscaled_descent, unscaled_line_gap;
-        stbtt_GetFontVMetrics(&tmp.FontInfo, &unscaled_ascent, &unscaled_descent, &unscaled_line_gap);
+        stbtt_GetFontVMetrics(&tmp.Font->FontInfo, &unscaled_ascent, &unscaled_descent, &unscaled_line_gap);
 
         const float ascent = ImFloor(unscaled_ascent * font_scale + ((unscaled_ascent > 0.0f) ? +1 : -1));
         const float descent = ImFloor(unscaled_descent * font_scale + ((unscaled_descent > 0.0f) ? +1 : -1));
@@ -1831,28 +2570,32 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         const float off_x = cfg.GlyphOffset.x;
         const float off_y = cfg.GlyphOffset.y + (float)(int)(dst_font->Ascent + 0.5f);
 
+        const stbrp_rect* rect = tmp.Rects;
         for (int i = 0; i < tmp.RangesCount; i++)
         {
             stbtt_pack_range& range = tmp.Ranges[i];
-            for (int char_idx = 0; char_idx < range.num_chars; char_idx += 1)
+            for (int char_idx = 0; char_idx < range.num_chars; char_idx += 1, rect++)
             {
                 const stbtt_packedchar& pc = range.chardata_for_range[char_idx];
                 if (!pc.x0 && !pc.x1 && !pc.y0 && !pc.y1)
                     continue;
 
                 const int codepoint = range.first_unicode_codepoint_in_range + char_idx;
-                if (cfg.MergeMode && dst_font->FindGlyph((unsigned short)codepoint))
+                if (cfg.MergeMode && dst_font->FindGlyph((ImWchar)codepoint))
                     continue;
 
                 stbtt_aligned_quad q;
                 float dummy_x = 0.0f, dummy_y = 0.0f;
-                stbtt_GetPackedQuad(range.chardata_for_range, atlas->TexWidth, atlas->TexHeight, char_idx, &dummy_x, &dummy_y, &q, 0);
+                stbtt_GetPackedQuad(range.chardata_for_range, atlas->TexWidth, tex_page_height, char_idx, &dummy_x, &dummy_y, &q, 0);
                 dst_font->AddGlyph((ImWchar)codepoint, q.x0 + off_x, q.y0 + off_y, q.x1 + off_x, q.y1 + off_y, q.s0, q.t0, q.s1, q.t1, pc.xadvance);
+                dst_font->Glyphs.back().TexPage = (unsigned short)rect->id;
             }
         }
+        IM_ASSERT(rect == tmp.Rects + tmp.RectsCount);
     }
 
     // Cleanup temporaries
+    ImGui::MemFree(buf_rects);
     ImGui::MemFree(buf_packedchars);
     ImGui::MemFree(buf_ranges);
     ImGui::MemFree(tmp_array);
@@ -1882,7 +2625,9 @@ void ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* f
         font->ContainerAtlas = atlas;
         font->Ascent = ascent;
         font->Descent = descent;
+        font->DistanceField = font_config->DistanceField;
     }
+    IM_ASSERT(font->DistanceField == font_config->DistanceField); // Can't merge distance field and regular glyphs into a same font
     font->ConfigDataCount++;
 }
 
@@ -1907,6 +2652,7 @@ void ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* pack_context_opaq
         {
             user_rects[i].X = pack_rects[i].x;
             user_rects[i].Y = pack_rects[i].y;
+            user_rects[i].TexPage = 0;
             IM_ASSERT(pack_rects[i].w == user_rects[i].Width && pack_rects[i].h == user_rects[i].Height);
             atlas->TexHeight = ImMax(atlas->TexHeight, pack_rects[i].y + pack_rects[i].h);
         }
@@ -1943,28 +2689,643 @@ static void ImFontAtlasBuildRenderDefaultTexData(ImFontAtlas* atlas)
     atlas->TexUvWhitePixel = ImVec2((r.X + 0.5f) * atlas->TexUvScale.x, (r.Y + 0.5f) * atlas->TexUvScale.y);
 }
 
-void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
+static void ImFontAtlasBuildAddCustomRectGlyph(ImFontAtlas* atlas, const ImFontAtlas::CustomRect& r)
 {
-    // Render into our custom data block
-    ImFontAtlasBuildRenderDefaultTexData(atlas);
+    IM_ASSERT(r.Font->ContainerAtlas == atlas);
+    ImVec2 uv0, uv1;
+    atlas->CalcCustomRectUV(&r, &uv0, &uv1);
+    r.Font->AddGlyph((ImWchar)r.ID, r.GlyphOffset.x, r.GlyphOffset.y, r.GlyphOffset.x + r.Width, r.GlyphOffset.y + r.Height, uv0.x, uv0.y, uv1.x, uv1.y, r.GlyphAdvanceX);
+    r.Font->Glyphs.back().TexPage = r.TexPage;
+}
 
-    // Register custom rectangle glyphs
-    for (int i = 0; i < atlas->CustomRects.Size; i++)
+// Append a cleared page at the end of the texture and continue packing rectangles added after Build() into it.
+// The new page is marked dirty so the renderer notices it and creates its texture.
+static void ImFontAtlasBuildAddTexPage(ImFontAtlas* atlas)
+{
+    IM_ASSERT(atlas->TexPageHeight > 0 && atlas->TexHeight == atlas->TexPagesCount * atlas->TexPageHeight);
+    const size_t tex_size = (size_t)atlas->TexWidth * atlas->TexHeight;
+    const size_t page_size = (size_t)atlas->TexWidth * atlas->TexPageHeight;
+    unsigned char* pixels = (unsigned char*)ImGui::MemAlloc(tex_size + page_size);
+    memcpy(pixels, atlas->TexPixelsAlpha8, tex_size);
+    memset(pixels + tex_size, 0, page_size);
+    ImGui::MemFree(atlas->TexPixelsAlpha8);
+    atlas->TexPixelsAlpha8 = pixels;
+    if (atlas->TexPixelsRGBA32)
     {
-        const ImFontAtlas::CustomRect& r = atlas->CustomRects[i];
-        if (r.Font == NULL || r.ID > 0x10000)
-            continue;
+        unsigned int* pixels_rgba32 = (unsigned int*)ImGui::MemAlloc((tex_size + page_size) * 4);
+        memcpy(pixels_rgba32, atlas->TexPixelsRGBA32, tex_size * 4);
+        for (size_t n = tex_size; n < tex_size + page_size; n++)
+            pixels_rgba32[n] = IM_COL32(255, 255, 255, 0);
+        ImGui::MemFree(atlas->TexPixelsRGBA32);
+        atlas->TexPixelsRGBA32 = pixels_rgba32;
+    }
+
+    ImFontAtlasBuildPackPage pack_page;
+    pack_page.Context = (stbrp_context*)atlas->PackContext;
+    pack_page.Nodes = (stbrp_node*)atlas->PackNodes;
+    ImFontAtlasBuildInitPackPage(pack_page, atlas->TexWidth, atlas->TexPageHeight, atlas->TexGlyphPadding);
+    atlas->PackPage = atlas->TexPagesCount++;
+    atlas->TexHeight += atlas->TexPageHeight;
+    atlas->MarkTexDirty(0, atlas->PackPage * atlas->TexPageHeight, atlas->TexWidth, atlas->TexPageHeight);
+}
 
-        IM_ASSERT(r.Font->ContainerAtlas == atlas);
-        ImVec2 uv0, uv1;
-        atlas->CalcCustomRectUV(&r, &uv0, &uv1);
-        r.Font->AddGlyph((ImWchar)r.ID, r.GlyphOffset.x, r.GlyphOffset.y, r.GlyphOffset.x + r.Width, r.GlyphOffset.y + r.Height, uv0.x, uv0.y, uv1.x, uv1.y, r.GlyphAdvanceX);
+// Pack a custom rectangle added after Build() in the free space of the skyline kept by the build, or in a new texture page. Its pixels are left cleared.
+bool ImFontAtlasBuildInsertCustomRect(ImFontAtlas* atlas, int rect_index)
+{
+    if (atlas->PackContext == NULL || atlas->TexPixelsAlpha8 == NULL)
+        return false;
+    ImFontAtlas::CustomRect& r = atlas->CustomRects[rect_index];
+    stbrp_rect pack_rect;
+    memset(&pack_rect, 0, sizeof(pack_rect));
+    pack_rect.w = r.Width;
+    pack_rect.h = r.Height;
+    stbrp_pack_rects((stbrp_context*)atlas->PackContext, &pack_rect, 1);
+    if (!pack_rect.was_packed && atlas->TexPageHeight > 0 && r.Width <= atlas->TexWidth - atlas->TexGlyphPadding && r.Height <= atlas->TexPageHeight - atlas->TexGlyphPadding)
+    {
+        ImFontAtlasBuildAddTexPage(atlas);
+        stbrp_pack_rects((stbrp_context*)atlas->PackContext, &pack_rect, 1);
+    }
+    if (!pack_rect.was_packed)
+        return false;
+    r.X = pack_rect.x;
+    r.Y = pack_rect.y;
+    r.TexPage = (unsigned short)atlas->PackPage;
+
+    if (r.Font != NULL && r.ID <= 0x10000)
+    {
+        // BuildLookupTable() appends the TAB glyph at the end of the array, remove it before adding a glyph so it doesn't get duplicated.
+        if (!r.Font->Glyphs.empty() && r.Font->Glyphs.back().Codepoint == '\t')
+            r.Font->Glyphs.pop_back();
+        ImFontAtlasBuildAddCustomRectGlyph(atlas, r);
+        r.Font->BuildLookupTable();
+    }
+    return true;
+}
+
+void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
+{
+    // Render into our custom data block
+    ImFontAtlasBuildRenderDefaultTexData(atlas);
+
+    // Register custom rectangle glyphs
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        const ImFontAtlas::CustomRect& r = atlas->CustomRects[i];
+        if (r.Font == NULL || r.ID > 0x10000)
+            continue;
+        ImFontAtlasBuildAddCustomRectGlyph(atlas, r);
     }
 
     // Build all fonts lookup tables
     for (int i = 0; i < atlas->Fonts.Size; i++)
         if (atlas->Fonts[i]->DirtyLookupTables)
             atlas->Fonts[i]->BuildLookupTable();
+
+    // Only start queuing missing glyphs once the build is done
+    for (int i = 0; i < atlas->ConfigData.Size; i++)
+        if (atlas->ConfigData[i].DynamicGlyphs && !atlas->DynamicPages.empty())
+            atlas->ConfigData[i].DstFont->DynamicGlyphs = true;
+}
+
+//-----------------------------------------------------------------------------
+// ImFontAtlas glyphs rasterized on demand
+// ImFont::RenderText() calls TouchDynamicGlyph() for fonts using ImFontConfig::DynamicGlyphs, UpdateDynamicGlyphs() rasterizes the missing glyphs at the next NewFrame().
+//-----------------------------------------------------------------------------
+
+static ImGuiID ImFontAtlasDynamicGlyphKey(const ImFont* font, ImWchar c)
+{
+    return ImHash(&font, (int)sizeof(font), (ImU32)c);
+}
+
+void    ImFontAtlas::TouchDynamicGlyph(const ImFont* font, ImWchar c)
+{
+    IM_ASSERT(font->ContainerAtlas == this);
+    if ((int)(c >> 8) < font->IndexPageMap.Size)
+    {
+        const int i = font->IndexPages.Data[font->IndexPageMap.Data[c >> 8]].GlyphIndex[c & 0xFF];
+        if (i != -1)
+        {
+            const ImFontGlyph& glyph = font->Glyphs.Data[i];
+            if (glyph.Page != 0)
+                DynamicPages[glyph.Page - 1].LastUsedFrame = DynamicFrameCount;
+            return;
+        }
+    }
+
+    // Queue the glyph, it will be rasterized by the next UpdateDynamicGlyphs(). The fallback glyph is displayed until then.
+    int* requested = DynamicRequested.GetIntRef(ImFontAtlasDynamicGlyphKey(font, c), 0);
+    if (*requested == 0)
+    {
+        *requested = 1;
+        DynamicGlyphRequest request;
+        request.Font = font;
+        request.Codepoint = c;
+        DynamicRequests.push_back(request);
+    }
+}
+
+// Number of pixels added by uploading the bounding box of two rectangles instead of each of them (negative when they overlap)
+static int ImFontAtlasDirtyRectMergeCost(const ImFontAtlas::TexDirtyRect& a, const ImFontAtlas::TexDirtyRect& b)
+{
+    const int w = ImMax(a.X + a.Width, b.X + b.Width) - ImMin(a.X, b.X);
+    const int h = ImMax(a.Y + a.Height, b.Y + b.Height) - ImMin(a.Y, b.Y);
+    return w * h - a.Width * a.Height - b.Width * b.Height;
+}
+
+static void ImFontAtlasDirtyRectMerge(ImFontAtlas::TexDirtyRect& dst, const ImFontAtlas::TexDirtyRect& src)
+{
+    const int x1 = ImMax(dst.X + dst.Width, src.X + src.Width);
+    const int y1 = ImMax(dst.Y + dst.Height, src.Y + src.Height);
+    dst.X = ImMin(dst.X, src.X);
+    dst.Y = ImMin(dst.Y, src.Y);
+    dst.Width = x1 - dst.X;
+    dst.Height = y1 - dst.Y;
+}
+
+void ImFontAtlas::MarkTexDirty(int x, int y, int w, int h)
+{
+    IM_ASSERT(x >= 0 && y >= 0 && x + w <= TexWidth && y + h <= TexHeight);
+    if (w <= 0 || h <= 0)
+        return;
+    TexDirtyRect rect = { x, y, w, h };
+
+    // Absorb the rectangles which can be merged for free (overlapping, or adjacent and aligned), repeating as the rectangle grows
+    for (int n = 0; n < TexDirtyRects.Size; )
+    {
+        if (ImFontAtlasDirtyRectMergeCost(rect, TexDirtyRects[n]) <= 0)
+        {
+            ImFontAtlasDirtyRectMerge(rect, TexDirtyRects[n]);
+            TexDirtyRects.erase(TexDirtyRects.Data + n);
+            n = 0;
+        }
+        else
+        {
+            n++;
+        }
+    }
+
+    // Past 64 rectangles, merge with the one adding the fewest pixels to keep the list and the number of uploads bounded
+    const int rects_max = 64;
+    if (TexDirtyRects.Size >= rects_max)
+    {
+        int best_n = 0;
+        for (int n = 1; n < TexDirtyRects.Size; n++)
+            if (ImFontAtlasDirtyRectMergeCost(rect, TexDirtyRects[n]) < ImFontAtlasDirtyRectMergeCost(rect, TexDirtyRects[best_n]))
+                best_n = n;
+        ImFontAtlasDirtyRectMerge(TexDirtyRects[best_n], rect);
+        return;
+    }
+    TexDirtyRects.push_back(rect);
+}
+
+// Mark pixels written by the atlas into TexPixelsAlpha8, also updating the RGBA32 copy of the texture
+static void ImFontAtlasMarkTexDirty(ImFontAtlas* atlas, int x, int y, int w, int h)
+{
+    atlas->MarkTexDirty(x, y, w, h);
+    if (atlas->TexPixelsRGBA32)
+        for (int row = y; row < y + h; row++)
+        {
+            const unsigned char* src = atlas->TexPixelsAlpha8 + row * atlas->TexWidth + x;
+            unsigned int* dst = atlas->TexPixelsRGBA32 + row * atlas->TexWidth + x;
+            for (int n = w; n > 0; n--)
+                *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+        }
+}
+
+// Shelf packing: glyphs are placed left to right in rows, a new row starts below the tallest glyph of the current one.
+static bool ImFontAtlasDynamicPageAlloc(ImFontAtlas* atlas, ImFontAtlas::DynamicGlyphPage& page, int w, int h, int* out_x, int* out_y)
+{
+    if (w > atlas->TexWidth)
+        return false;
+    if (page.CursorX + w > atlas->TexWidth)
+    {
+        if (page.CursorY + page.RowHeight + h > page.Height)
+            return false;
+        page.CursorX = 0;
+        page.CursorY += page.RowHeight;
+        page.RowHeight = 0;
+    }
+    if (page.CursorY + h > page.Height)
+        return false;
+    *out_x = page.CursorX;
+    *out_y = page.Y + page.CursorY;
+    page.CursorX += w;
+    page.RowHeight = ImMax(page.RowHeight, h);
+    return true;
+}
+
+static void ImFontAtlasDynamicPageEvict(ImFontAtlas* atlas, int page_n)
+{
+    ImFontAtlas::DynamicGlyphPage& page = atlas->DynamicPages[page_n];
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        ImFont* font = atlas->Fonts[font_i];
+        if (!font->DynamicGlyphs)
+            continue;
+        int dst_n = 0;
+        for (int src_n = 0; src_n < font->Glyphs.Size; src_n++)
+        {
+            const ImFontGlyph& glyph = font->Glyphs[src_n];
+            if (glyph.Page == page_n + 1)
+                atlas->DynamicRequested.SetInt(ImFontAtlasDynamicGlyphKey(font, glyph.Codepoint), 0);
+            else
+                font->Glyphs[dst_n++] = glyph;
+        }
+        if (dst_n < font->Glyphs.Size)
+        {
+            font->Glyphs.resize(dst_n);
+            font->BuildLookupTable();
+        }
+    }
+    memset(atlas->TexPixelsAlpha8 + page.Y * atlas->TexWidth, 0, (size_t)(page.Height * atlas->TexWidth));
+    ImFontAtlasMarkTexDirty(atlas, 0, page.Y, atlas->TexWidth, page.Height);
+    page.CursorX = page.CursorY = page.RowHeight = 0;
+    page.GlyphsCount = 0;
+}
+
+static bool ImFontAtlasBuildDynamicGlyph(ImFontAtlas* atlas, ImFont* font, const ImFontConfig& cfg, ImFontParsedData& parsed_font, ImWchar codepoint, int glyph_index)
+{
+    const stbtt_fontinfo& font_info = parsed_font.FontInfo;
+    // Same layout as stbtt_PackFontRangesGatherRects() + stbtt_PackFontRangesRenderIntoRects() (or their distance field equivalents), so dynamic glyphs look exactly like baked ones
+    const float scale = stbtt_ScaleForPixelHeight(&font_info, cfg.SizePixels);
+    const int oversample_h = cfg.DistanceField ? 1 : cfg.OversampleH, oversample_v = cfg.DistanceField ? 1 : cfg.OversampleV;
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBoxSubpixel(&font_info, glyph_index, scale * oversample_h, scale * oversample_v, 0, 0, &x0, &y0, &x1, &y1);
+    const bool empty = (x1 <= x0 || y1 <= y0);
+    int w = x1 - x0 + oversample_h - 1;
+    int h = y1 - y0 + oversample_v - 1;
+    if (cfg.DistanceField && !empty)
+    {
+        x0 -= IM_FONT_SDF_PADDING;
+        y0 -= IM_FONT_SDF_PADDING;
+        w += IM_FONT_SDF_PADDING * 2;
+        h += IM_FONT_SDF_PADDING * 2;
+    }
+    int advance, lsb;
+    stbtt_GetGlyphHMetrics(&font_info, glyph_index, &advance, &lsb);
+    const float off_x = cfg.GlyphOffset.x;
+    const float off_y = cfg.GlyphOffset.y + (float)(int)(font->Ascent + 0.5f);
+
+    // Empty glyphs (e.g. spaces) don't use texture space
+    // BuildLookupTable() appends the TAB glyph at the end of the array, remove it before adding a glyph so it doesn't get duplicated.
+    if (empty)
+    {
+        if (!font->Glyphs.empty() && font->Glyphs.back().Codepoint == '\t')
+            font->Glyphs.pop_back();
+        font->AddGlyph(codepoint, 0.0f, 0.0f, 0.0f, 0.0f, atlas->TexUvWhitePixel.x, atlas->TexUvWhitePixel.y, atlas->TexUvWhitePixel.x, atlas->TexUvWhitePixel.y, advance * scale);
+        return true;
+    }
+
+    // Find space in a page, else recycle the least recently used page. Pages used during the last frame are never recycled: retry next frame.
+    const int pad = atlas->TexGlyphPadding;
+    int page_n = -1, x = 0, y = 0;
+    for (int n = 0; n < atlas->DynamicPages.Size && page_n == -1; n++)
+        if (ImFontAtlasDynamicPageAlloc(atlas, atlas->DynamicPages[n], w + pad, h + pad, &x, &y))
+            page_n = n;
+    if (page_n == -1)
+    {
+        int lru_n = -1;
+        for (int n = 0; n < atlas->DynamicPages.Size; n++)
+            if (atlas->DynamicPages[n].LastUsedFrame < atlas->DynamicFrameCount - 1 && (lru_n == -1 || atlas->DynamicPages[n].LastUsedFrame < atlas->DynamicPages[lru_n].LastUsedFrame))
+                lru_n = n;
+        if (lru_n == -1)
+        {
+            atlas->DynamicRequested.SetInt(ImFontAtlasDynamicGlyphKey(font, codepoint), 0);
+            return false;
+        }
+        ImFontAtlasDynamicPageEvict(atlas, lru_n);
+        if (!ImFontAtlasDynamicPageAlloc(atlas, atlas->DynamicPages[lru_n], w + pad, h + pad, &x, &y))
+            return false; // Glyph larger than a page
+        page_n = lru_n;
+    }
+    x += pad;
+    y += pad;
+
+    // Render
+    unsigned char* pixels = atlas->TexPixelsAlpha8 + x + y * atlas->TexWidth;
+    if (cfg.DistanceField)
+    {
+        int xoff, yoff;
+        ImFontAtlasBuildRenderGlyphSDF(font_info, scale, glyph_index, pixels, atlas->TexWidth, &xoff, &yoff);
+        IM_ASSERT(xoff == x0 && yoff == y0);
+    }
+    else
+    {
+        parsed_font.DecodeGlyphShape(glyph_index);
+        parsed_font.MakeGlyphBitmap(pixels, w - oversample_h + 1, h - oversample_v + 1, atlas->TexWidth, scale * oversample_h, scale * oversample_v, glyph_index);
+        if (oversample_h > 1)
+            stbtt__h_prefilter(pixels, w, h, atlas->TexWidth, oversample_h);
+        if (oversample_v > 1)
+            stbtt__v_prefilter(pixels, w, h, atlas->TexWidth, oversample_v);
+        if (cfg.RasterizerMultiply != 1.0f)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+            ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, x, y, w, h, atlas->TexWidth);
+        }
+    }
+    ImFontAtlasMarkTexDirty(atlas, x, y, w, h);
+
+    // Register glyph, as stbtt_GetPackedQuad() would. Pages of dynamic glyphs never straddle two texture pages.
+    if (!font->Glyphs.empty() && font->Glyphs.back().Codepoint == '\t')
+        font->Glyphs.pop_back();
+    const float recip_h = 1.0f / oversample_h, recip_v = 1.0f / oversample_v;
+    const float sub_x = stbtt__oversample_shift(oversample_h), sub_y = stbtt__oversample_shift(oversample_v);
+    const int tex_page = y / atlas->GetTexPageHeight();
+    const int tex_page_y = y - tex_page * atlas->GetTexPageHeight();
+    font->AddGlyph(codepoint,
+        x0 * recip_h + sub_x + off_x, y0 * recip_v + sub_y + off_y, (x0 + w) * recip_h + sub_x + off_x, (y0 + h) * recip_v + sub_y + off_y,
+        x * atlas->TexUvScale.x, tex_page_y * atlas->TexUvScale.y, (x + w) * atlas->TexUvScale.x, (tex_page_y + h) * atlas->TexUvScale.y,
+        advance * scale);
+    font->Glyphs.back().Page = (unsigned short)(page_n + 1);
+    font->Glyphs.back().TexPage = (unsigned short)tex_page;
+    ImFontAtlas::DynamicGlyphPage& page = atlas->DynamicPages[page_n];
+    page.GlyphsCount++;
+    page.LastUsedFrame = atlas->DynamicFrameCount;
+    return true;
+}
+
+bool ImFontAtlasBuildDynamicGlyphs(ImFontAtlas* atlas)
+{
+    if (atlas->TexPixelsAlpha8 == NULL || atlas->DynamicPages.empty())
+    {
+        atlas->DynamicRequests.clear();
+        return false;
+    }
+
+    bool changed = false;
+    for (int request_n = 0; request_n < atlas->DynamicRequests.Size; request_n++)
+    {
+        const ImFont* font = atlas->DynamicRequests[request_n].Font;
+        const ImWchar codepoint = atlas->DynamicRequests[request_n].Codepoint;
+        for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+        {
+            const ImFontConfig& cfg = atlas->ConfigData[input_i];
+            if (cfg.DstFont != font || !cfg.DynamicGlyphs || cfg.FontData == NULL)
+                continue;
+            ImFontParsedData* parsed_font = ImFontAtlasBuildGetParsedFont(atlas, cfg);
+            if (parsed_font == NULL)
+                continue;
+            const int glyph_index = parsed_font->FindGlyphIndex(codepoint);
+            if (glyph_index == 0)
+                continue;
+            if (ImFontAtlasBuildDynamicGlyph(atlas, cfg.DstFont, cfg, *parsed_font, codepoint, glyph_index))
+                changed = true;
+            break;
+        }
+    }
+    atlas->DynamicRequests.clear();
+
+    for (int i = 0; i < atlas->Fonts.Size; i++)
+        if (atlas->Fonts[i]->DirtyLookupTables)
+            atlas->Fonts[i]->BuildLookupTable();
+    return changed;
+}
+
+//-----------------------------------------------------------------------------
+// ImFontAtlas on-disk cache
+// The file stores the output of a build (alpha texture, custom rectangles positions, fonts metrics, glyphs and lookup tables)
+// along with a 64-bit key computed from every input of the build. A cache file is only used when its key matches.
+// The key hashes all the font data, so a modified font never loads a stale atlas. Fonts added by AddFontDefault() are hashed in their compressed form and only decompressed when building.
+//-----------------------------------------------------------------------------
+
+#define IM_FONT_ATLAS_CACHE_VERSION     6
+
+struct ImFontAtlasCacheHeader
+{
+    char    Magic[4];           // "IMFA"
+    int     Version;            // IM_FONT_ATLAS_CACHE_VERSION
+    ImU32   Key[2];
+    int     TexWidth, TexHeight;
+    ImVec2  TexUvWhitePixel;
+    int     FontsCount;
+    int     CustomRectsCount;
+};
+
+struct ImFontAtlasCacheFont
+{
+    float   FontSize, Ascent, Descent;
+    int     GlyphsCount;        // Lookup tables are rebuilt from the glyphs on load
+};
+
+static void ImFontAtlasCacheHashData(ImU32 key[2], const void* data, int data_size)
+{
+    if (data_size <= 0) // ImHash() would treat 0 as a zero-terminated string
+        return;
+    key[0] = ImHash(data, data_size, key[0]);
+    key[1] = ImHash(data, data_size, key[1] ^ 0x9E3779B9);
+}
+
+template<typename T>
+static void ImFontAtlasCacheHashValue(ImU32 key[2], const T& value) { ImFontAtlasCacheHashData(key, &value, (int)sizeof(T)); }
+
+// Embedded fonts are always hashed in their compressed form, whether a build already decompressed them or not
+static void ImFontAtlasCacheHashFontData(ImU32 key[2], const ImFontConfig& cfg)
+{
+    if (cfg.FontDataCompressedBase85 != NULL)
+    {
+        const int len = (int)strlen(cfg.FontDataCompressedBase85);
+        ImFontAtlasCacheHashValue(key, len);
+        ImFontAtlasCacheHashData(key, cfg.FontDataCompressedBase85, len);
+        return;
+    }
+    ImFontAtlasCacheHashValue(key, cfg.FontDataSize);
+    ImFontAtlasCacheHashData(key, cfg.FontData, cfg.FontDataSize);
+}
+
+static int ImFontAtlasCacheFindFontIndex(const ImFontAtlas* atlas, const ImFont* font)
+{
+    for (int i = 0; i < atlas->Fonts.Size; i++)
+        if (atlas->Fonts[i] == font)
+            return i;
+    return -1;
+}
+
+// Hash fields one by one so struct padding and pointers never leak into the key
+static void ImFontAtlasCacheCalcKey(ImFontAtlas* atlas, ImU32 out_key[2])
+{
+    out_key[0] = out_key[1] = 0;
+    ImFontAtlasCacheHashData(out_key, IMGUI_VERSION, (int)strlen(IMGUI_VERSION));
+    ImFontAtlasCacheHashValue(out_key, (int)IM_FONT_ATLAS_CACHE_VERSION);
+    ImFontAtlasCacheHashValue(out_key, (int)sizeof(ImFontGlyph)); // Differs with IMGUI_USE_WCHAR32
+    ImFontAtlasCacheHashValue(out_key, atlas->Flags);
+    ImFontAtlasCacheHashValue(out_key, atlas->TexDesiredWidth);
+    ImFontAtlasCacheHashValue(out_key, atlas->TexGlyphPadding);
+    ImFontAtlasCacheHashValue(out_key, atlas->TexPageHeight);
+    ImFontAtlasCacheHashValue(out_key, atlas->Fonts.Size);
+    for (int i = 0; i < atlas->Fonts.Size; i++)
+        ImFontAtlasCacheHashValue(out_key, atlas->Fonts[i]->FallbackChar);
+    for (int i = 0; i < atlas->ConfigData.Size; i++)
+    {
+        ImFontConfig& cfg = atlas->ConfigData[i];
+        if (!cfg.GlyphRanges)
+            cfg.GlyphRanges = atlas->GetGlyphRangesDefault();
+        ImFontAtlasCacheHashFontData(out_key, cfg);
+        ImFontAtlasCacheHashValue(out_key, cfg.FontNo);
+        ImFontAtlasCacheHashValue(out_key, cfg.SizePixels);
+        ImFontAtlasCacheHashValue(out_key, cfg.OversampleH);
+        ImFontAtlasCacheHashValue(out_key, cfg.OversampleV);
+        ImFontAtlasCacheHashValue(out_key, cfg.PixelSnapH);
+        ImFontAtlasCacheHashValue(out_key, cfg.GlyphExtraSpacing.x);
+        ImFontAtlasCacheHashValue(out_key, cfg.GlyphExtraSpacing.y);
+        ImFontAtlasCacheHashValue(out_key, cfg.GlyphOffset.x);
+        ImFontAtlasCacheHashValue(out_key, cfg.GlyphOffset.y);
+        int ranges_size = 0;
+        while (cfg.GlyphRanges[ranges_size] && cfg.GlyphRanges[ranges_size + 1])
+            ranges_size += 2;
+        ImFontAtlasCacheHashValue(out_key, ranges_size);
+        ImFontAtlasCacheHashData(out_key, cfg.GlyphRanges, ranges_size * (int)sizeof(ImWchar));
+        ImFontAtlasCacheHashValue(out_key, cfg.MergeMode);
+        ImFontAtlasCacheHashValue(out_key, cfg.RasterizerFlags);
+        ImFontAtlasCacheHashValue(out_key, cfg.RasterizerMultiply);
+        ImFontAtlasCacheHashValue(out_key, cfg.DistanceField);
+        ImFontAtlasCacheHashValue(out_key, ImFontAtlasCacheFindFontIndex(atlas, cfg.DstFont));
+    }
+    ImFontAtlasCacheHashValue(out_key, atlas->CustomRects.Size);
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        const ImFontAtlas::CustomRect& r = atlas->CustomRects[i];
+        ImFontAtlasCacheHashValue(out_key, r.ID);
+        ImFontAtlasCacheHashValue(out_key, r.Width);
+        ImFontAtlasCacheHashValue(out_key, r.Height);
+        ImFontAtlasCacheHashValue(out_key, r.GlyphAdvanceX);
+        ImFontAtlasCacheHashValue(out_key, r.GlyphOffset.x);
+        ImFontAtlasCacheHashValue(out_key, r.GlyphOffset.y);
+        ImFontAtlasCacheHashValue(out_key, ImFontAtlasCacheFindFontIndex(atlas, r.Font));
+    }
+}
+
+// Read helper, fail (return NULL) instead of reading past the end of the file
+static const void* ImFontAtlasCacheRead(const char** p, const char* p_end, size_t size)
+{
+    if ((size_t)(p_end - *p) < size)
+        return NULL;
+    const void* data = *p;
+    *p += size;
+    return data;
+}
+
+bool ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, const char* filename)
+{
+    IM_ASSERT(atlas->ConfigData.Size > 0);
+    ImFontAtlasBuildRegisterDefaultCustomRects(atlas);
+
+    int file_size = 0;
+    char* file_data = (char*)ImFileLoadToMemory(filename, "rb", &file_size);
+    if (!file_data)
+        return false;
+
+    ImU32 key[2];
+    ImFontAtlasCacheCalcKey(atlas, key);
+
+    // Validate everything before touching the atlas, so a stale or truncated file leaves it untouched
+    const char* p = file_data;
+    const char* p_end = file_data + file_size;
+    const ImFontAtlasCacheHeader* header = (const ImFontAtlasCacheHeader*)ImFontAtlasCacheRead(&p, p_end, sizeof(ImFontAtlasCacheHeader));
+    bool valid = header && memcmp(header->Magic, "IMFA", 4) == 0 && header->Version == IM_FONT_ATLAS_CACHE_VERSION && header->Key[0] == key[0] && header->Key[1] == key[1];
+    valid = valid && header->FontsCount == atlas->Fonts.Size && header->CustomRectsCount == atlas->CustomRects.Size && header->TexWidth > 0 && header->TexHeight > 0;
+    valid = valid && (atlas->TexPageHeight <= 0 || header->TexHeight % atlas->TexPageHeight == 0);
+    const unsigned short* rects_pos = valid ? (const unsigned short*)ImFontAtlasCacheRead(&p, p_end, sizeof(unsigned short) * 4 * header->CustomRectsCount) : NULL;
+    const char* fonts_data = p;
+    for (int font_i = 0; valid && font_i < header->FontsCount; font_i++)
+    {
+        const ImFontAtlasCacheFont* font_header = (const ImFontAtlasCacheFont*)ImFontAtlasCacheRead(&p, p_end, sizeof(ImFontAtlasCacheFont));
+        valid = font_header && font_header->GlyphsCount >= 0;
+        valid = valid && ImFontAtlasCacheRead(&p, p_end, sizeof(ImFontGlyph) * font_header->GlyphsCount) != NULL;
+    }
+    const unsigned char* pixels = valid ? (const unsigned char*)ImFontAtlasCacheRead(&p, p_end, (size_t)header->TexWidth * header->TexHeight) : NULL;
+    if (!valid || (header->CustomRectsCount > 0 && !rects_pos) || !pixels)
+    {
+        ImGui::MemFree(file_data);
+        return false;
+    }
+
+    // Texture
+    atlas->TexID = NULL;
+    atlas->TexPageIDs.clear();
+    atlas->ClearTexData();
+    atlas->TexWidth = header->TexWidth;
+    atlas->TexHeight = header->TexHeight;
+    atlas->TexPagesCount = (atlas->TexPageHeight > 0) ? atlas->TexHeight / atlas->TexPageHeight : 1;
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->GetTexPageHeight());
+    atlas->TexUvWhitePixel = header->TexUvWhitePixel;
+    atlas->TexPixelsAlpha8 = (unsigned char*)ImGui::MemAlloc((size_t)atlas->TexWidth * atlas->TexHeight);
+    memcpy(atlas->TexPixelsAlpha8, pixels, (size_t)atlas->TexWidth * atlas->TexHeight);
+
+    // Custom rectangles
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        atlas->CustomRects[i].X = rects_pos[i * 4 + 0];
+        atlas->CustomRects[i].Y = rects_pos[i * 4 + 1];
+        atlas->CustomRects[i].TexPage = rects_pos[i * 4 + 2];
+    }
+
+    // Fonts
+    for (int i = 0; i < atlas->ConfigData.Size; i++)
+        ImFontAtlasBuildSetupFont(atlas, atlas->ConfigData[i].DstFont, &atlas->ConfigData[i], 0.0f, 0.0f);
+    p = fonts_data;
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        ImFont* font = atlas->Fonts[font_i];
+        const ImFontAtlasCacheFont* font_header = (const ImFontAtlasCacheFont*)ImFontAtlasCacheRead(&p, p_end, sizeof(ImFontAtlasCacheFont));
+        font->FontSize = font_header->FontSize;
+        font->Ascent = font_header->Ascent;
+        font->Descent = font_header->Descent;
+        font->Glyphs.resize(font_header->GlyphsCount);
+        if (font_header->GlyphsCount > 0)
+            memcpy(font->Glyphs.Data, ImFontAtlasCacheRead(&p, p_end, sizeof(ImFontGlyph) * font_header->GlyphsCount), sizeof(ImFontGlyph) * font_header->GlyphsCount);
+        font->BuildLookupTable();
+    }
+
+    ImGui::MemFree(file_data);
+    return true;
+}
+
+// Write to "<filename>.tmp" then replace the cache file, so an interrupted save or a concurrent load never sees a partial file
+bool ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, const char* filename)
+{
+    IM_ASSERT(atlas->TexPixelsAlpha8 != NULL);
+    const int filename_len = (int)strlen(filename);
+    ImVector<char> tmp_filename;
+    tmp_filename.resize(filename_len + 5);
+    memcpy(tmp_filename.Data, filename, (size_t)filename_len);
+    memcpy(tmp_filename.Data + filename_len, ".tmp", 5);
+    FILE* f = ImFileOpen(tmp_filename.Data, "wb");
+    if (!f)
+        return false;
+
+    ImFontAtlasCacheHeader header = ImFontAtlasCacheHeader(); // Zero padding bytes too, they end up in the file
+    memcpy(header.Magic, "IMFA", 4);
+    header.Version = IM_FONT_ATLAS_CACHE_VERSION;
+    ImFontAtlasCacheCalcKey(atlas, header.Key);
+    header.TexWidth = atlas->TexWidth;
+    header.TexHeight = atlas->TexHeight;
+    header.TexUvWhitePixel = atlas->TexUvWhitePixel;
+    header.FontsCount = atlas->Fonts.Size;
+    header.CustomRectsCount = atlas->CustomRects.Size;
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    for (int i = 0; ok && i < atlas->CustomRects.Size; i++)
+    {
+        const unsigned short pos[4] = { atlas->CustomRects[i].X, atlas->CustomRects[i].Y, atlas->CustomRects[i].TexPage, 0 }; // Padded to keep the following font headers aligned
+        ok = fwrite(pos, sizeof(pos), 1, f) == 1;
+    }
+    for (int font_i = 0; ok && font_i < atlas->Fonts.Size; font_i++)
+    {
+        const ImFont* font = atlas->Fonts[font_i];
+        ImFontAtlasCacheFont font_header = ImFontAtlasCacheFont();
+        font_header.FontSize = font->FontSize;
+        font_header.Ascent = font->Ascent;
+        font_header.Descent = font->Descent;
+        font_header.GlyphsCount = font->Glyphs.Size;
+        ok = fwrite(&font_header, sizeof(font_header), 1, f) == 1;
+        ok = ok && fwrite(font->Glyphs.Data, sizeof(ImFontGlyph), (size_t)font->Glyphs.Size, f) == (size_t)font->Glyphs.Size;
+    }
+    ok = ok && fwrite(atlas->TexPixelsAlpha8, 1, (size_t)atlas->TexWidth * atlas->TexHeight, f) == (size_t)atlas->TexWidth * atlas->TexHeight;
+    ok = (fclose(f) == 0) && ok;
+    ok = ok && ImFileReplace(tmp_filename.Data, filename);
+    if (!ok)
+        remove(tmp_filename.Data);
+    return ok;
 }
 
 // Retrieve list of range (2 int per range, values are inclusive)
@@ -2053,20 +3414,22 @@ const ImWchar*  ImFontAtlas::GetGlyphRangesJapanese()
         0x31F0, 0x31FF, // Katakana Phonetic Extensions
         0xFF00, 0xFFEF, // Half-width characters
     };
-    static bool full_ranges_unpacked = false;
-    static ImWchar full_ranges[IM_ARRAYSIZE(base_ranges) + IM_ARRAYSIZE(offsets_from_0x4E00)*2 + 1];
-    if (!full_ranges_unpacked)
+    struct FullRanges
     {
-        // Unpack
-        int codepoint = 0x4e00;
-        memcpy(full_ranges, base_ranges, sizeof(base_ranges));
-        ImWchar* dst = full_ranges + IM_ARRAYSIZE(base_ranges);
-        for (int n = 0; n < IM_ARRAYSIZE(offsets_from_0x4E00); n++, dst += 2)
-            dst[0] = dst[1] = (ImWchar)(codepoint += (offsets_from_0x4E00[n] + 1));
-        dst[0] = 0;
-        full_ranges_unpacked = true;
-    }
-    return &full_ranges[0];
+        ImWchar Data[IM_ARRAYSIZE(base_ranges) + IM_ARRAYSIZE(offsets_from_0x4E00)*2 + 1];
+        FullRanges()
+        {
+            // Unpack
+            int codepoint = 0x4e00;
+            memcpy(Data, base_ranges, sizeof(base_ranges));
+            ImWchar* dst = Data + IM_ARRAYSIZE(base_ranges);
+            for (int n = 0; n < IM_ARRAYSIZE(offsets_from_0x4E00); n++, dst += 2)
+                dst[0] = dst[1] = (ImWchar)(codepoint += (offsets_from_0x4E00[n] + 1));
+            dst[0] = 0;
+        }
+    };
+    static const FullRanges full_ranges; // Unpacked on first use. Initialization of local statics is thread-safe in C++11 (VS2015 and later, required by IMGUI_ENABLE_THREAD_LOCAL_CONTEXT) so contexts on different threads can call this concurrently.
+    return &full_ranges.Data[0];
 }
 
 const ImWchar*  ImFontAtlas::GetGlyphRangesCyrillic()
@@ -2107,7 +3470,7 @@ void ImFontAtlas::GlyphRangesBuilder::AddText(const char* text, const char* text
         text += c_len;
         if (c_len == 0)
             break;
-        if (c < 0x10000)
+        if (c <= IM_UNICODE_CODEPOINT_MAX)
             AddChar((ImWchar)c);
     }
 }
@@ -2115,17 +3478,17 @@ void ImFontAtlas::GlyphRangesBuilder::AddText(const char* text, const char* text
 void ImFontAtlas::GlyphRangesBuilder::AddRanges(const ImWchar* ranges)
 {
     for (; ranges[0]; ranges += 2)
-        for (ImWchar c = ranges[0]; c <= ranges[1]; c++)
-            AddChar(c);
+        for (unsigned int c = ranges[0]; c <= ranges[1]; c++)
+            AddChar((ImWchar)c);
 }
 
 void ImFontAtlas::GlyphRangesBuilder::BuildRanges(ImVector<ImWchar>* out_ranges)
 {
-    for (int n = 0; n < 0x10000; n++)
+    for (int n = 0; n <= IM_UNICODE_CODEPOINT_MAX; n++)
         if (GetBit(n))
         {
             out_ranges->push_back((ImWchar)n);
-            while (n < 0x10000 && GetBit(n + 1))
+            while (n < IM_UNICODE_CODEPOINT_MAX && GetBit(n + 1))
                 n++;
             out_ranges->push_back((ImWchar)n);
         }
@@ -2161,8 +3524,8 @@ void    ImFont::ClearOutputData()
 {
     FontSize = 0.0f;
     Glyphs.clear();
-    IndexAdvanceX.clear();
-    IndexLookup.clear();
+    IndexPageMap.clear();
+    IndexPages.clear();
     FallbackGlyph = NULL;
     FallbackAdvanceX = 0.0f;
     ConfigDataCount = 0;
@@ -2170,6 +3533,8 @@ void    ImFont::ClearOutputData()
     ContainerAtlas = NULL;
     Ascent = Descent = 0.0f;
     DirtyLookupTables = true;
+    DynamicGlyphs = false;
+    DistanceField = false;
     MetricsTotalSurface = 0;
 }
 
@@ -2179,38 +3544,48 @@ void ImFont::BuildLookupTable()
     for (int i = 0; i != Glyphs.Size; i++)
         max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
 
-    IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
-    IndexAdvanceX.clear();
-    IndexLookup.clear();
+    // Page 0 is shared by all the ranges of 256 codepoints without any glyph. Missing glyphs are marked with a negative AdvanceX until we know FallbackAdvanceX.
+    IndexPageMap.clear();
+    IndexPages.clear();
     DirtyLookupTables = false;
-    GrowIndex(max_codepoint + 1);
+    FallbackAdvanceX = -1.0f;
+    IndexPageMap.resize((max_codepoint >> 8) + 1, 0);
+    IndexPages.resize(1);
+    for (int n = 0; n < 256; n++)
+    {
+        IndexPages[0].AdvanceX[n] = -1.0f;
+        IndexPages[0].GlyphIndex[n] = -1;
+    }
     for (int i = 0; i < Glyphs.Size; i++)
     {
-        int codepoint = (int)Glyphs[i].Codepoint;
-        IndexAdvanceX[codepoint] = Glyphs[i].AdvanceX;
-        IndexLookup[codepoint] = (unsigned short)i;
+        const ImWchar codepoint = Glyphs[i].Codepoint;
+        ImFontIndexPage& page = GetOrAddIndexPage(codepoint);
+        page.AdvanceX[codepoint & 0xFF] = Glyphs[i].AdvanceX;
+        page.GlyphIndex[codepoint & 0xFF] = i;
     }
 
     // Create a glyph to handle TAB
     // FIXME: Needs proper TAB handling but it needs to be contextualized (or we could arbitrary say that each string starts at "column 0" ?)
-    if (FindGlyph((unsigned short)' '))
+    if (FindGlyph((ImWchar)' '))
     {
         if (Glyphs.back().Codepoint != '\t')   // So we can call this function multiple times
             Glyphs.resize(Glyphs.Size + 1);
         ImFontGlyph& tab_glyph = Glyphs.back();
-        tab_glyph = *FindGlyph((unsigned short)' ');
+        tab_glyph = *FindGlyph((ImWchar)' ');
         tab_glyph.Codepoint = '\t';
         tab_glyph.AdvanceX *= 4;
-        IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
-        IndexLookup[(int)tab_glyph.Codepoint] = (unsigned short)(Glyphs.Size-1);
+        ImFontIndexPage& page = GetOrAddIndexPage(tab_glyph.Codepoint);
+        page.AdvanceX[tab_glyph.Codepoint & 0xFF] = (float)tab_glyph.AdvanceX;
+        page.GlyphIndex[tab_glyph.Codepoint & 0xFF] = Glyphs.Size-1;
     }
 
     FallbackGlyph = NULL;
     FallbackGlyph = FindGlyph(FallbackChar);
     FallbackAdvanceX = FallbackGlyph ? FallbackGlyph->AdvanceX : 0.0f;
-    for (int i = 0; i < max_codepoint + 1; i++)
-        if (IndexAdvanceX[i] < 0.0f)
-            IndexAdvanceX[i] = FallbackAdvanceX;
+    for (int page_n = 0; page_n < IndexPages.Size; page_n++)
+        for (int n = 0; n < 256; n++)
+            if (IndexPages[page_n].AdvanceX[n] < 0.0f)
+                IndexPages[page_n].AdvanceX[n] = FallbackAdvanceX;
 }
 
 void ImFont::SetFallbackChar(ImWchar c)
@@ -2219,13 +3594,27 @@ void ImFont::SetFallbackChar(ImWchar c)
     BuildLookupTable();
 }
 
-void ImFont::GrowIndex(int new_size)
+// Return the lookup table page covering codepoint 'c', allocating it if it was mapped to the shared empty page.
+// The reference is invalidated by the next call, as IndexPages[] may be reallocated.
+ImFontIndexPage& ImFont::GetOrAddIndexPage(ImWchar c)
 {
-    IM_ASSERT(IndexAdvanceX.Size == IndexLookup.Size);
-    if (new_size <= IndexLookup.Size)
-        return;
-    IndexAdvanceX.resize(new_size, -1.0f);
-    IndexLookup.resize(new_size, (unsigned short)-1);
+    IM_ASSERT(IndexPages.Size > 0);
+    const int page_n = (int)(c >> 8);
+    if (page_n >= IndexPageMap.Size)
+        IndexPageMap.resize(page_n + 1, 0);
+    if (IndexPageMap[page_n] == 0)
+    {
+        IM_ASSERT(IndexPages.Size <= 0xFFFF);
+        IndexPageMap[page_n] = (unsigned short)IndexPages.Size;
+        IndexPages.resize(IndexPages.Size + 1);
+        ImFontIndexPage& page = IndexPages.back();
+        for (int n = 0; n < 256; n++)
+        {
+            page.AdvanceX[n] = FallbackAdvanceX;
+            page.GlyphIndex[n] = -1;
+        }
+    }
+    return IndexPages[IndexPageMap[page_n]];
 }
 
 void ImFont::AddGlyph(ImWchar codepoint, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x)
@@ -2233,6 +3622,8 @@ void ImFont::AddGlyph(ImWchar codepoint, float x0, float y0, float x1, float y1,
     Glyphs.resize(Glyphs.Size + 1);
     ImFontGlyph& glyph = Glyphs.back();
     glyph.Codepoint = (ImWchar)codepoint;
+    glyph.Page = 0;
+    glyph.TexPage = 0;
     glyph.X0 = x0; 
     glyph.Y0 = y0; 
     glyph.X1 = x1; 
@@ -2248,30 +3639,32 @@ void ImFont::AddGlyph(ImWchar codepoint, float x0, float y0, float x1, float y1,
     
     // Compute rough surface usage metrics (+1 to account for average padding, +0.99 to round)
     DirtyLookupTables = true;
-    MetricsTotalSurface += (int)((glyph.U1 - glyph.U0) * ContainerAtlas->TexWidth + 1.99f) * (int)((glyph.V1 - glyph.V0) * ContainerAtlas->TexHeight + 1.99f);
+    MetricsTotalSurface += (int)((glyph.U1 - glyph.U0) * ContainerAtlas->TexWidth + 1.99f) * (int)((glyph.V1 - glyph.V0) * ContainerAtlas->GetTexPageHeight() + 1.99f);
 }
 
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
-    IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
-    int index_size = IndexLookup.Size;
+    IM_ASSERT(IndexPages.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
+    const int src_index = ((int)(src >> 8) < IndexPageMap.Size) ? IndexPages[IndexPageMap[src >> 8]].GlyphIndex[src & 0xFF] : -1;
+    const int dst_index = ((int)(dst >> 8) < IndexPageMap.Size) ? IndexPages[IndexPageMap[dst >> 8]].GlyphIndex[dst & 0xFF] : -1;
 
-    if (dst < index_size && IndexLookup.Data[dst] == (unsigned short)-1 && !overwrite_dst) // 'dst' already exists
+    if (dst_index != -1 && !overwrite_dst) // 'dst' already exists
         return;
-    if (src >= index_size && dst >= index_size) // both 'dst' and 'src' don't exist -> no-op
+    if (src_index == -1 && dst_index == -1) // both 'dst' and 'src' don't exist -> no-op
         return;
 
-    GrowIndex(dst + 1);
-    IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (unsigned short)-1;
-    IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    const float src_advance_x = GetCharAdvance(src);
+    ImFontIndexPage& page = GetOrAddIndexPage(dst);
+    page.GlyphIndex[dst & 0xFF] = src_index;
+    page.AdvanceX[dst & 0xFF] = src_advance_x;
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
-    if (c < IndexLookup.Size)
+    if ((int)(c >> 8) < IndexPageMap.Size)
     {
-        const unsigned short i = IndexLookup[c];
-        if (i != (unsigned short)-1)
+        const int i = IndexPages.Data[IndexPageMap.Data[c >> 8]].GlyphIndex[c & 0xFF];
+        if (i != -1)
             return &Glyphs.Data[i];
     }
     return FallbackGlyph;
@@ -2302,10 +3695,34 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     const char* word_end = text;
     const char* prev_word_end = NULL;
     bool inside_word = true;
+    const float* ascii_advance_x = (IndexPageMap.Size > 0) ? IndexPages.Data[IndexPageMap.Data[0]].AdvanceX : NULL;
 
     const char* s = text;
     while (s < text_end)
     {
+        // Fast path for the rest of a word made of printable ASCII characters: only the word width grows.
+        // Stop on blanks and punctuations (they change the wrapping state) and let the generic path handle them.
+        if (inside_word && ascii_advance_x && (unsigned char)*s > ' ' && (unsigned char)*s < 0x80)
+        {
+            // Words are short: test the characters as we go instead of scanning the whole ASCII run first, which would read the rest of the line for every word.
+            for (; s < text_end; s++)
+            {
+                const unsigned int c = (unsigned char)*s;
+                if (c <= ' ' || c >= 0x80 || c == '.' || c == ',' || c == ';' || c == '!' || c == '?' || c == '\"')
+                    break;
+                word_width += ascii_advance_x[c];
+                word_end = s + 1;
+                if (line_width + word_width >= wrap_width)
+                {
+                    if (word_width < wrap_width)
+                        s = prev_word_end ? prev_word_end : word_end;
+                    return s;
+                }
+            }
+            if (s >= text_end)
+                break;
+        }
+
         unsigned int c = (unsigned int)*s;
         const char* next_s;
         if (c < 0x80)
@@ -2331,7 +3748,7 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
             }
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX[(int)c] : FallbackAdvanceX);
+        const float char_width = GetCharAdvance((ImWchar)c);
         if (ImCharIsSpace(c))
         {
             if (inside_word)
@@ -2421,6 +3838,24 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        // Fast path for runs of printable ASCII characters: no decoding and no control characters.
+        // Widths are accumulated one by one in the same order as below so the result is identical.
+        if ((unsigned char)*s >= 0x20 && (unsigned char)*s < 0x80 && IndexPageMap.Size > 0)
+        {
+            const float* ascii_advance_x = IndexPages.Data[IndexPageMap.Data[0]].AdvanceX;
+            const char* run_end = s + ImTextCountPrintableAscii(s, word_wrap_eol ? word_wrap_eol : text_end);
+            for (; s < run_end; s++)
+            {
+                const float char_width = ascii_advance_x[(unsigned char)*s] * scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+            }
+            if (s < run_end)
+                break;
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -2448,7 +3883,7 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 continue;
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX[(int)c] : FallbackAdvanceX) * scale;
+        const float char_width = GetCharAdvance((ImWchar)c) * scale;
         if (line_width + char_width >= max_width)
         {
             s = prev_s;
@@ -2470,18 +3905,95 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     return text_size;
 }
 
-void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, unsigned short c) const
+void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, ImWchar c) const
 {
     if (c == ' ' || c == '\t' || c == '\n' || c == '\r') // Match behavior of RenderText(), those 4 codepoints are hard-coded.
         return;
+    if (DynamicGlyphs)
+        ContainerAtlas->TouchDynamicGlyph(this, c);
     if (const ImFontGlyph* glyph = FindGlyph(c))
     {
         float scale = (size >= 0.0f) ? (size / FontSize) : 1.0f;
         pos.x = (float)(int)pos.x + DisplayOffset.x;
         pos.y = (float)(int)pos.y + DisplayOffset.y;
+        if (glyph->TexPage != 0)
+            draw_list->PushTextureID(ContainerAtlas->GetTexPageID(glyph->TexPage));
+        if (DistanceField)
+            draw_list->PrimBeginDistanceField();
         draw_list->PrimReserve(6, 4);
         draw_list->PrimRectUV(ImVec2(pos.x + glyph->X0 * scale, pos.y + glyph->Y0 * scale), ImVec2(pos.x + glyph->X1 * scale, pos.y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
+        if (DistanceField)
+            draw_list->PrimEndDistanceField();
+        if (glyph->TexPage != 0)
+            draw_list->PopTextureID();
+    }
+}
+
+// Switch the texture of the glyphs emitted by RenderText() to another atlas page: the current draw command ends at idx_write and the rest of the indices reserved up to idx_expected_size continue in a new one.
+static void ImFontRenderTextSetTexture(ImDrawList* draw_list, ImTextureID tex_id, const ImDrawIdx* idx_write, int idx_expected_size)
+{
+    ImDrawCmd* draw_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size-1];
+    const unsigned int idx_reserved_left = (unsigned int)(idx_expected_size - (idx_write - draw_list->IdxBuffer.Data));
+    draw_cmd->ElemCount -= idx_reserved_left;
+    if (draw_cmd->ElemCount != 0)
+    {
+        const bool distance_field = draw_cmd->DistanceField;
+        draw_list->AddDrawCmd();
+        draw_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size-1];
+        draw_cmd->DistanceField = distance_field;
+    }
+    draw_cmd->TextureId = tex_id;
+    draw_cmd->ElemCount += idx_reserved_left;
+}
+
+// Count the characters of [s, text_end) which may be rendered as a quad: anything but blanks, line returns and UTF-8 continuation bytes.
+static int ImFontCountGlyphQuadsInText(const char* s, const char* text_end)
+{
+    int count = 0;
+#ifdef IMGUI_ENABLE_SSE
+    // Sum the 0/1 bytes of each block of 16 characters with _mm_sad_epu8(). Continuation bytes 0x80..0xBF are the ones lower than -64 as signed chars.
+    const __m128i space = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t'), lf = _mm_set1_epi8('\n'), cr = _mm_set1_epi8('\r');
+    const __m128i continuation_max = _mm_set1_epi8(-64);
+    const __m128i ones = _mm_set1_epi8(1);
+    __m128i sums = _mm_setzero_si128();
+    for (; text_end - s >= 16; s += 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)s);
+        __m128i skipped = _mm_or_si128(_mm_cmpeq_epi8(chars, space), _mm_cmpeq_epi8(chars, tab));
+        skipped = _mm_or_si128(skipped, _mm_or_si128(_mm_cmpeq_epi8(chars, lf), _mm_cmpeq_epi8(chars, cr)));
+        skipped = _mm_or_si128(skipped, _mm_cmplt_epi8(chars, continuation_max));
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(_mm_andnot_si128(skipped, ones), _mm_setzero_si128()));
+    }
+    count += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+#endif
+    for (; s < text_end; s++)
+    {
+        const unsigned char c = (unsigned char)*s;
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r' && (c < 0x80 || c >= 0xC0))
+            count++;
+    }
+    return count;
+}
+
+// Upper bound of the number of quads emitted by RenderText(), counting only the lines it doesn't skip as above or below the clipping rectangle.
+static int ImFontCountGlyphQuads(const char* s, const char* text_end, float y, float line_height, const ImVec4& clip_rect, bool word_wrap_enabled)
+{
+    if (word_wrap_enabled)
+        return ImFontCountGlyphQuadsInText(s, text_end);
+    int count = 0;
+    while (s < text_end)
+    {
+        const char* line_end = (const char*)memchr(s, '\n', (size_t)(text_end - s));
+        if (!line_end)
+            line_end = text_end;
+        if (y + line_height >= clip_rect.y)
+            count += ImFontCountGlyphQuadsInText(s, line_end);
+        y += line_height;
+        if (y > clip_rect.w)
+            break;
+        s = line_end + 1;
     }
+    return count;
 }
 
 void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
@@ -2505,18 +4017,35 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     // Skip non-visible lines
     const char* s = text_begin;
     if (!word_wrap_enabled && y + line_height < clip_rect.y)
-        while (s < text_end && *s != '\n')  // Fast-forward to next line
-            s++;
+    {
+        s = (const char*)memchr(s, '\n', (size_t)(text_end - s));  // Fast-forward to next line
+        s = s ? s : text_end;
+    }
 
-    // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
-    const int vtx_count_max = (int)(text_end - s) * 4;
-    const int idx_count_max = (int)(text_end - s) * 6;
+    // Reserve vertices for the worst case: all characters of the visible lines rendered, except blanks.
+    // Short texts (most labels) reserve one quad per byte instead, counting would cost more than the few vertices given back below.
+    const int quads_count_max = (text_end - s <= 64) ? (int)(text_end - s) : ImFontCountGlyphQuads(s, text_end, y, line_height, clip_rect, word_wrap_enabled);
+    if (quads_count_max == 0)
+        return;
+    const int vtx_count_max = quads_count_max * 4;
+    const int idx_count_max = quads_count_max * 6;
     const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
+    if (DistanceField)
+        draw_list->PrimBeginDistanceField();
     draw_list->PrimReserve(idx_count_max, vtx_count_max);
 
     ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
     ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
     unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+    unsigned int tex_page = 0; // The draw list is using the texture of the first atlas page, see ImDrawList::AddText()
+
+    // Glyphs of printable ASCII characters can be read directly from the first lookup table page, see the fast path below.
+    // Dynamic glyphs take the slow path, which calls TouchDynamicGlyph() to keep track of the pages in use.
+    const ImFontIndexPage* ascii_page = (!cpu_fine_clip && !DynamicGlyphs && IndexPageMap.Size > 0) ? &IndexPages.Data[IndexPageMap.Data[0]] : NULL;
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+    const __m128 scale_4 = _mm_set1_ps(scale);
+    const __m128 col_4 = _mm_castsi128_ps(_mm_set1_epi32((int)col));
+#endif
 
     while (s < text_end)
     {
@@ -2546,6 +4075,61 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             }
         }
 
+        // Fast path for runs of printable ASCII characters without fine clipping: no decoding, no control characters, no glyph lookup call.
+        // This emits exactly the same vertices as the generic path below.
+        if (ascii_page && (unsigned char)*s >= 0x20 && (unsigned char)*s < 0x80)
+        {
+            const char* run_end = s + ImTextCountPrintableAscii(s, word_wrap_eol ? word_wrap_eol : text_end);
+            for (; s < run_end; s++)
+            {
+                const unsigned int c = (unsigned int)*s;
+                const int glyph_index = ascii_page->GlyphIndex[c];
+                const ImFontGlyph* glyph = (glyph_index != -1) ? &Glyphs.Data[glyph_index] : FallbackGlyph;
+                if (!glyph)
+                    continue;
+                if (c != ' ')
+                {
+                    const float x1 = x + glyph->X0 * scale;
+                    const float x2 = x + glyph->X1 * scale;
+                    if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+                    {
+                        if (glyph->TexPage != tex_page)
+                        {
+                            tex_page = glyph->TexPage;
+                            ImFontRenderTextSetTexture(draw_list, ContainerAtlas->GetTexPageID(tex_page), idx_write, idx_expected_size);
+                        }
+                        idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+                        idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+                        // Write the 4 vertices (80 bytes: pos, uv, col) with 5 unaligned stores
+                        const __m128 p = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&glyph->X0), scale_4), _mm_setr_ps(x, y, x, y));    // x1 y1 x2 y2
+                        const __m128 t = _mm_loadu_ps(&glyph->U0);                                                              // u1 v1 u2 v2
+                        const __m128 p_col = _mm_shuffle_ps(p, col_4, _MM_SHUFFLE(0, 0, 3, 2));                                 // x2 y2 col col
+                        const __m128 t_col = _mm_shuffle_ps(t, col_4, _MM_SHUFFLE(0, 0, 3, 2));                                 // u2 v2 col col
+                        float* dst = (float*)vtx_write;
+                        _mm_storeu_ps(dst + 0, _mm_movelh_ps(p, t));                                                             // x1 y1 u1 v1
+                        _mm_storeu_ps(dst + 4, _mm_shuffle_ps(_mm_shuffle_ps(col_4, p, _MM_SHUFFLE(2, 2, 0, 0)), _mm_shuffle_ps(p, t, _MM_SHUFFLE(2, 2, 1, 1)), _MM_SHUFFLE(2, 0, 2, 0))); // col x2 y1 u2
+                        _mm_storeu_ps(dst + 8, _mm_shuffle_ps(_mm_shuffle_ps(t, col_4, _MM_SHUFFLE(0, 0, 1, 1)), p, _MM_SHUFFLE(3, 2, 2, 0)));                                   // v1 col x2 y2
+                        _mm_storeu_ps(dst + 12, _mm_shuffle_ps(t_col, _mm_shuffle_ps(col_4, p, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));                              // u2 v2 col x1
+                        _mm_storeu_ps(dst + 16, _mm_shuffle_ps(_mm_shuffle_ps(p_col, t, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(t, col_4, _MM_SHUFFLE(0, 0, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0))); // y2 u1 v2 col
+#else
+                        const float y1 = y + glyph->Y0 * scale;
+                        const float y2 = y + glyph->Y1 * scale;
+                        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = glyph->U0; vtx_write[0].uv.y = glyph->V0;
+                        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = glyph->U1; vtx_write[1].uv.y = glyph->V0;
+                        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = glyph->U1; vtx_write[2].uv.y = glyph->V1;
+                        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = glyph->U0; vtx_write[3].uv.y = glyph->V1;
+#endif
+                        vtx_write += 4;
+                        vtx_current_idx += 4;
+                        idx_write += 6;
+                    }
+                }
+                x += glyph->AdvanceX * scale;
+            }
+            continue;
+        }
+
         // Decode and advance source
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
@@ -2569,8 +4153,10 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                 if (y > clip_rect.w)
                     break;
                 if (!word_wrap_enabled && y + line_height < clip_rect.y)
-                    while (s < text_end && *s != '\n')  // Fast-forward to next line
-                        s++;
+                {
+                    s = (const char*)memchr(s, '\n', (size_t)(text_end - s));  // Fast-forward to next line
+                    s = s ? s : text_end;
+                }
                 continue;
             }
             if (c == '\r')
@@ -2578,7 +4164,9 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
         }
 
         float char_width = 0.0f;
-        if (const ImFontGlyph* glyph = FindGlyph((unsigned short)c))
+        if (DynamicGlyphs)
+            ContainerAtlas->TouchDynamicGlyph(this, (ImWchar)c);
+        if (const ImFontGlyph* glyph = FindGlyph((ImWchar)c))
         {
             char_width = glyph->AdvanceX * scale;
 
@@ -2628,6 +4216,12 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                         }
                     }
 
+                    if (glyph->TexPage != tex_page)
+                    {
+                        tex_page = glyph->TexPage;
+                        ImFontRenderTextSetTexture(draw_list, ContainerAtlas->GetTexPageID(tex_page), idx_write, idx_expected_size);
+                    }
+
                     // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
                     {
                         idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
@@ -2648,12 +4242,17 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     }
 
     // Give back unused vertices
+    IM_ASSERT(idx_write - draw_list->IdxBuffer.Data <= idx_expected_size);
     draw_list->VtxBuffer.resize((int)(vtx_write - draw_list->VtxBuffer.Data));
     draw_list->IdxBuffer.resize((int)(idx_write - draw_list->IdxBuffer.Data));
     draw_list->CmdBuffer[draw_list->CmdBuffer.Size-1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
     draw_list->_VtxWritePtr = vtx_write;
     draw_list->_IdxWritePtr = idx_write;
     draw_list->_VtxCurrentIdx = (unsigned int)draw_list->VtxBuffer.Size;
+    if (DistanceField)
+        draw_list->PrimEndDistanceField();
+    if (tex_page != 0)
+        draw_list->UpdateTextureID();
 }
 
 //-----------------------------------------------------------------------------
@@ -2741,43 +4340,48 @@ static unsigned int stb_decompress_length(unsigned char *input)
     return (input[8] << 24) + (input[9] << 16) + (input[10] << 8) + input[11];
 }
 
-static unsigned char *stb__barrier, *stb__barrier2, *stb__barrier3, *stb__barrier4;
-static unsigned char *stb__dout;
-static void stb__match(unsigned char *data, unsigned int length)
+// [ImGui] decompression state is passed around instead of being kept in globals, so fonts can be loaded from several threads
+struct stb__decompress_state
+{
+    unsigned char *barrier, *barrier2, *barrier3, *barrier4;
+    unsigned char *dout;
+};
+
+static void stb__match(stb__decompress_state *s, unsigned char *data, unsigned int length)
 {
     // INVERSE of memmove... write each byte before copying the next...
-    IM_ASSERT (stb__dout + length <= stb__barrier);
-    if (stb__dout + length > stb__barrier) { stb__dout += length; return; }
-    if (data < stb__barrier4) { stb__dout = stb__barrier+1; return; }
-    while (length--) *stb__dout++ = *data++;
+    IM_ASSERT (s->dout + length <= s->barrier);
+    if (s->dout + length > s->barrier) { s->dout += length; return; }
+    if (data < s->barrier4) { s->dout = s->barrier+1; return; }
+    while (length--) *s->dout++ = *data++;
 }
 
-static void stb__lit(unsigned char *data, unsigned int length)
+static void stb__lit(stb__decompress_state *s, unsigned char *data, unsigned int length)
 {
-    IM_ASSERT (stb__dout + length <= stb__barrier);
-    if (stb__dout + length > stb__barrier) { stb__dout += length; return; }
-    if (data < stb__barrier2) { stb__dout = stb__barrier+1; return; }
-    memcpy(stb__dout, data, length);
-    stb__dout += length;
+    IM_ASSERT (s->dout + length <= s->barrier);
+    if (s->dout + length > s->barrier) { s->dout += length; return; }
+    if (data < s->barrier2) { s->dout = s->barrier+1; return; }
+    memcpy(s->dout, data, length);
+    s->dout += length;
 }
 
 #define stb__in2(x)   ((i[x] << 8) + i[(x)+1])
 #define stb__in3(x)   ((i[x] << 16) + stb__in2((x)+1))
 #define stb__in4(x)   ((i[x] << 24) + stb__in3((x)+1))
 
-static unsigned char *stb_decompress_token(unsigned char *i)
+static unsigned char *stb_decompress_token(stb__decompress_state *s, unsigned char *i)
 {
     if (*i >= 0x20) { // use fewer if's for cases that expand small
-        if (*i >= 0x80)       stb__match(stb__dout-i[1]-1, i[0] - 0x80 + 1), i += 2;
-        else if (*i >= 0x40)  stb__match(stb__dout-(stb__in2(0) - 0x4000 + 1), i[2]+1), i += 3;
-        else /* *i >= 0x20 */ stb__lit(i+1, i[0] - 0x20 + 1), i += 1 + (i[0] - 0x20 + 1);
+        if (*i >= 0x80)       stb__match(s, s->dout-i[1]-1, i[0] - 0x80 + 1), i += 2;
+        else if (*i >= 0x40)  stb__match(s, s->dout-(stb__in2(0) - 0x4000 + 1), i[2]+1), i += 3;
+        else /* *i >= 0x20 */ stb__lit(s, i+1, i[0] - 0x20 + 1), i += 1 + (i[0] - 0x20 + 1);
     } else { // more ifs for cases that expand large, since overhead is amortized
-        if (*i >= 0x18)       stb__match(stb__dout-(stb__in3(0) - 0x180000 + 1), i[3]+1), i += 4;
-        else if (*i >= 0x10)  stb__match(stb__dout-(stb__in3(0) - 0x100000 + 1), stb__in2(3)+1), i += 5;
-        else if (*i >= 0x08)  stb__lit(i+2, stb__in2(0) - 0x0800 + 1), i += 2 + (stb__in2(0) - 0x0800 + 1);
-        else if (*i == 0x07)  stb__lit(i+3, stb__in2(1) + 1), i += 3 + (stb__in2(1) + 1);
-        else if (*i == 0x06)  stb__match(stb__dout-(stb__in3(1)+1), i[4]+1), i += 5;
-        else if (*i == 0x04)  stb__match(stb__dout-(stb__in3(1)+1), stb__in2(4)+1), i += 6;
+        if (*i >= 0x18)       stb__match(s, s->dout-(stb__in3(0) - 0x180000 + 1), i[3]+1), i += 4;
+        else if (*i >= 0x10)  stb__match(s, s->dout-(stb__in3(0) - 0x100000 + 1), stb__in2(3)+1), i += 5;
+        else if (*i >= 0x08)  stb__lit(s, i+2, stb__in2(0) - 0x0800 + 1), i += 2 + (stb__in2(0) - 0x0800 + 1);
+        else if (*i == 0x07)  stb__lit(s, i+3, stb__in2(1) + 1), i += 3 + (stb__in2(1) + 1);
+        else if (*i == 0x06)  stb__match(s, s->dout-(stb__in3(1)+1), i[4]+1), i += 5;
+        else if (*i == 0x04)  stb__match(s, s->dout-(stb__in3(1)+1), stb__in2(4)+1), i += 6;
     }
     return i;
 }
@@ -2815,24 +4419,26 @@ static unsigned int stb_adler32(unsigned int adler32, unsigned char *buffer, uns
 
 static unsigned int stb_decompress(unsigned char *output, unsigned char *i, unsigned int length)
 {
+    stb__decompress_state state;
+    stb__decompress_state *s = &state;
     unsigned int olen;
     if (stb__in4(0) != 0x57bC0000) return 0;
     if (stb__in4(4) != 0)          return 0; // error! stream is > 4GB
     olen = stb_decompress_length(i);
-    stb__barrier2 = i;
-    stb__barrier3 = i+length;
-    stb__barrier = output + olen;
-    stb__barrier4 = output;
+    s->barrier2 = i;
+    s->barrier3 = i+length;
+    s->barrier = output + olen;
+    s->barrier4 = output;
     i += 16;
 
-    stb__dout = output;
+    s->dout = output;
     for (;;) {
         unsigned char *old_i = i;
-        i = stb_decompress_token(i);
+        i = stb_decompress_token(s, i);
         if (i == old_i) {
             if (*i == 0x05 && i[1] == 0xfa) {
-                IM_ASSERT(stb__dout == output + olen);
-                if (stb__dout != output + olen) return 0;
+                IM_ASSERT(s->dout == output + olen);
+                if (s->dout != output + olen) return 0;
                 if (stb_adler32(1, output, olen) != (unsigned int) stb__in4(2))
                     return 0;
                 return olen;
@@ -2841,8 +4447,8 @@ static unsigned int stb_decompress(unsigned char *output, unsigned char *i, unsi
                 return 0;
             }
         }
-        IM_ASSERT(stb__dout <= output + olen);
-        if (stb__dout > output + olen)
+        IM_ASSERT(s->dout <= output + olen);
+        if (s->dout > output + olen)
             return 0;
     }
 }
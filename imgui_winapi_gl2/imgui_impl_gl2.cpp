@@ -2,6 +2,8 @@
 
 // Implemented features:
 //  [X] User texture binding. Cast 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID in imgui.cpp.
+//  [X] Analytic shapes (ImDrawCmd::ShapeType), evaluated by a GLSL 1.10 program when the driver supports OpenGL 2.0. Sets ImGuiConfigFlags_RendererHasAnalyticShapes.
+//  [X] Signed distance field text (ImDrawCmd::DistanceField), thresholded by texture combiners when the driver supports OpenGL 1.3.
 
 // **DO NOT USE THIS CODE IF YOUR CODE/ENGINE IS USING MODERN OPENGL (SHADERS, VBO, VAO, etc.)**
 // **Prefer using the code in the opengl3_example/ folder**
@@ -18,24 +20,106 @@
 #include "windows.h"
 #include "GL/gl.h"
 #include "imgui.h"
+#include "imgui_internal.h"   // IM_NEW, IM_DELETE
 #include "imgui_impl_gl2.h"
 
 // TODO: Add cursor support
 
-// WinAPI data
-static HWND          g_Window;
-static double        g_RcpQueryPerformanceFrequency;
-static LARGE_INTEGER g_QueryPerformanceCounterStart;
-static double        g_Time;
-
-// OpenGL data
-static GLuint   g_FontTexture = 0;
+// OpenGL 1.3 and 2.0 entry points and enums, which the Windows SDK headers (OpenGL 1.1) don't declare. Loaded with wglGetProcAddress() when the device objects are created.
+#ifndef GL_COMBINE
+#define GL_TEXTURE0                       0x84C0
+#define GL_TEXTURE1                       0x84C1
+#define GL_COMBINE                        0x8570
+#define GL_COMBINE_RGB                    0x8571
+#define GL_COMBINE_ALPHA                  0x8572
+#define GL_ADD_SIGNED                     0x8574
+#define GL_CONSTANT                       0x8576
+#define GL_PRIMARY_COLOR                  0x8577
+#define GL_PREVIOUS                       0x8578
+#define GL_SOURCE0_RGB                    0x8580
+#define GL_SOURCE1_RGB                    0x8581
+#define GL_SOURCE0_ALPHA                  0x8588
+#define GL_SOURCE1_ALPHA                  0x8589
+#define GL_OPERAND0_RGB                   0x8590
+#define GL_OPERAND1_RGB                   0x8591
+#define GL_OPERAND0_ALPHA                 0x8598
+#define GL_OPERAND1_ALPHA                 0x8599
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER                0x8B30
+#define GL_VERTEX_SHADER                  0x8B31
+#define GL_COMPILE_STATUS                 0x8B81
+#define GL_LINK_STATUS                    0x8B82
+#define GL_CURRENT_PROGRAM                0x8B8D
+#endif
+typedef void    (APIENTRY *ImGui_PFNGLACTIVETEXTUREPROC)(GLenum texture);
+typedef GLuint  (APIENTRY *ImGui_PFNGLCREATESHADERPROC)(GLenum type);
+typedef void    (APIENTRY *ImGui_PFNGLSHADERSOURCEPROC)(GLuint shader, GLsizei count, const char* const* string, const GLint* length);
+typedef void    (APIENTRY *ImGui_PFNGLCOMPILESHADERPROC)(GLuint shader);
+typedef void    (APIENTRY *ImGui_PFNGLGETSHADERIVPROC)(GLuint shader, GLenum pname, GLint* params);
+typedef void    (APIENTRY *ImGui_PFNGLDELETESHADERPROC)(GLuint shader);
+typedef GLuint  (APIENTRY *ImGui_PFNGLCREATEPROGRAMPROC)();
+typedef void    (APIENTRY *ImGui_PFNGLATTACHSHADERPROC)(GLuint program, GLuint shader);
+typedef void    (APIENTRY *ImGui_PFNGLLINKPROGRAMPROC)(GLuint program);
+typedef void    (APIENTRY *ImGui_PFNGLGETPROGRAMIVPROC)(GLuint program, GLenum pname, GLint* params);
+typedef void    (APIENTRY *ImGui_PFNGLDELETEPROGRAMPROC)(GLuint program);
+typedef void    (APIENTRY *ImGui_PFNGLUSEPROGRAMPROC)(GLuint program);
+typedef GLint   (APIENTRY *ImGui_PFNGLGETUNIFORMLOCATIONPROC)(GLuint program, const char* name);
+typedef void    (APIENTRY *ImGui_PFNGLUNIFORM1FPROC)(GLint location, GLfloat v0);
+typedef void    (APIENTRY *ImGui_PFNGLUNIFORM4FPROC)(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+
+struct ImGui_ImplGL2_Functions
+{
+	ImGui_PFNGLACTIVETEXTUREPROC        ActiveTexture;
+	ImGui_PFNGLCREATESHADERPROC         CreateShader;
+	ImGui_PFNGLSHADERSOURCEPROC         ShaderSource;
+	ImGui_PFNGLCOMPILESHADERPROC        CompileShader;
+	ImGui_PFNGLGETSHADERIVPROC          GetShaderiv;
+	ImGui_PFNGLDELETESHADERPROC         DeleteShader;
+	ImGui_PFNGLCREATEPROGRAMPROC        CreateProgram;
+	ImGui_PFNGLATTACHSHADERPROC         AttachShader;
+	ImGui_PFNGLLINKPROGRAMPROC          LinkProgram;
+	ImGui_PFNGLGETPROGRAMIVPROC         GetProgramiv;
+	ImGui_PFNGLDELETEPROGRAMPROC        DeleteProgram;
+	ImGui_PFNGLUSEPROGRAMPROC           UseProgram;
+	ImGui_PFNGLGETUNIFORMLOCATIONPROC   GetUniformLocation;
+	ImGui_PFNGLUNIFORM1FPROC            Uniform1f;
+	ImGui_PFNGLUNIFORM4FPROC            Uniform4f;
+};
+
+// Binding data, one instance per ImGui context (stored in io.BindingUserData) so each window can run its own context, possibly on its own thread.
+struct ImGui_ImplGL2_Data
+{
+	// WinAPI data
+	HWND            Window;
+	double          RcpQueryPerformanceFrequency;
+	LARGE_INTEGER   QueryPerformanceCounterStart;
+	double          Time;
+	unsigned short  HighSurrogate;      // First half of a codepoint sent as two WM_CHAR messages
+	ImVector<char>  ClipboardText;      // Text returned by ImGui_ImplGL2_GetClipboardText()
+
+	// OpenGL data
+	ImVector<GLuint> FontTextures;      // One texture per page of the font atlas
+	int             FontUploadBudget;   // Bytes of modified font texture uploaded per frame, the rest is uploaded during the next frames
+	ImGui_ImplGL2_Functions GL;         // OpenGL 1.3 and 2.0 entry points, NULL when not supported
+	GLuint          ShapeProgram;       // Evaluates ImDrawCmd::ShapeType per pixel, 0 when OpenGL 2.0 is not supported
+	GLint           ShapeUniformRect, ShapeUniformRadii, ShapeUniformThickness, ShapeUniformFramebufferHeight;
+
+	ImGui_ImplGL2_Data() { Window = NULL; RcpQueryPerformanceFrequency = 0.0; QueryPerformanceCounterStart.QuadPart = 0; Time = 0.0; HighSurrogate = 0; FontUploadBudget = 256 * 1024; memset(&GL, 0, sizeof(GL)); ShapeProgram = 0; ShapeUniformRect = ShapeUniformRadii = ShapeUniformThickness = ShapeUniformFramebufferHeight = -1; }
+};
+
+static ImGui_ImplGL2_Data* ImGui_ImplGL2_GetData()
+{
+	return ImGui::GetCurrentContext() ? (ImGui_ImplGL2_Data*)ImGui::GetIO().BindingUserData : NULL;
+}
 
 // OpenGL2 Render function.
 // (this used to be set in io.RenderDrawListsFn and called by ImGui::Render(), but you can now call this directly from your main loop)
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly, in order to be able to run within any OpenGL engine that doesn't do so. 
 void ImGui_ImplGL2_RenderDrawData(ImDrawData* draw_data)
 {
+	ImGui_ImplGL2_Data* bd = ImGui_ImplGL2_GetData();
+
 	// Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
 	ImGuiIO& io = ImGui::GetIO();
 	int fb_width = (int)(io.DisplaySize.x * io.DisplayFramebufferScale.x);
@@ -45,12 +129,12 @@ void ImGui_ImplGL2_RenderDrawData(ImDrawData* draw_data)
 	draw_data->ScaleClipRects(io.DisplayFramebufferScale);
 
 	// We are using the OpenGL fixed pipeline to make the example code simpler to read!
-	// Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, vertex/texcoord/color pointers, polygon fill.
+	// Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, vertex/texcoord/color pointers, polygon fill. Texture combiners are enabled for distance field commands only.
 	GLint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
 	GLint last_polygon_mode[2]; glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
 	GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
 	GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box); 
-	glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TRANSFORM_BIT);
+	glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TRANSFORM_BIT | GL_TEXTURE_BIT);
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	glDisable(GL_CULL_FACE);
@@ -61,7 +145,46 @@ void ImGui_ImplGL2_RenderDrawData(ImDrawData* draw_data)
 	glEnableClientState(GL_COLOR_ARRAY);
 	glEnable(GL_TEXTURE_2D);
 	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-	//glUseProgram(0); // You may want this if using this code in an OpenGL 3+ context where shaders may be bound
+	GLint last_program = 0;
+	if (bd->ShapeProgram)
+	{
+		glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
+		bd->GL.UseProgram(0);
+	}
+	bool shape_program_bound = false;
+	if (bd->GL.ActiveTexture)
+	{
+		// Signed distance field text, only used while GL_TEXTURE_ENV_MODE is GL_COMBINE:
+		// - unit 0: rgb = texture * color, alpha = clamp(4 * (texture - 0.5) + 0.5) which turns the distance (0.5 on the outline) into coverage, over about 2 texels of the baked glyph.
+		// - unit 1: rgb = unit 0, alpha = unit 0 * color. The vertex alpha is applied after the threshold, so faded text fades instead of disappearing.
+		const GLfloat threshold_bias[4] = { 0.0f, 0.0f, 0.0f, 0.125f };
+		bd->GL.ActiveTexture(GL_TEXTURE0);
+		glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, threshold_bias);
+		glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_MODULATE);
+		glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_RGB, GL_TEXTURE);
+		glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_RGB, GL_SRC_COLOR);
+		glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE1_RGB, GL_PRIMARY_COLOR);
+		glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND1_RGB, GL_SRC_COLOR);
+		glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_ALPHA, GL_ADD_SIGNED);
+		glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_ALPHA, GL_TEXTURE);
+		glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_ALPHA, GL_SRC_ALPHA);
+		glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE1_ALPHA, GL_CONSTANT);
+		glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND1_ALPHA, GL_SRC_ALPHA);
+		glTexEnvf(GL_TEXTURE_ENV, GL_ALPHA_SCALE, 4.0f);
+		bd->GL.ActiveTexture(GL_TEXTURE1);
+		glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
+		glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_REPLACE);
+		glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_RGB, GL_PREVIOUS);
+		glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_RGB, GL_SRC_COLOR);
+		glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_ALPHA, GL_MODULATE);
+		glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_ALPHA, GL_PREVIOUS);
+		glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_ALPHA, GL_SRC_ALPHA);
+		glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE1_ALPHA, GL_PRIMARY_COLOR);
+		glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND1_ALPHA, GL_SRC_ALPHA);
+		glTexEnvf(GL_TEXTURE_ENV, GL_ALPHA_SCALE, 1.0f);
+		glDisable(GL_TEXTURE_2D);
+		bd->GL.ActiveTexture(GL_TEXTURE0);
+	}
 
 	// Setup viewport, orthographic projection matrix
 	glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height);
@@ -94,13 +217,57 @@ void ImGui_ImplGL2_RenderDrawData(ImDrawData* draw_data)
 			{
 				glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
 				glScissor((int)pcmd->ClipRect.x, (int)(fb_height - pcmd->ClipRect.w), (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
+				if ((pcmd->ShapeType != ImDrawShape_None) != shape_program_bound)
+				{
+					shape_program_bound = !shape_program_bound;
+					bd->GL.UseProgram(shape_program_bound ? bd->ShapeProgram : 0);
+					if (shape_program_bound)
+						bd->GL.Uniform1f(bd->ShapeUniformFramebufferHeight, (float)fb_height);
+				}
+				if (shape_program_bound)
+				{
+					// Shape fields were scaled to framebuffer pixels by ScaleClipRects()
+					const float r = pcmd->ShapeRounding;
+					const int f = pcmd->ShapeCornerFlags;
+					bd->GL.Uniform4f(bd->ShapeUniformRect, pcmd->ShapeRect.x, pcmd->ShapeRect.y, pcmd->ShapeRect.z, pcmd->ShapeRect.w);
+					bd->GL.Uniform4f(bd->ShapeUniformRadii, (f & ImDrawCornerFlags_TopLeft) ? r : 0.0f, (f & ImDrawCornerFlags_TopRight) ? r : 0.0f, (f & ImDrawCornerFlags_BotRight) ? r : 0.0f, (f & ImDrawCornerFlags_BotLeft) ? r : 0.0f);
+					bd->GL.Uniform1f(bd->ShapeUniformThickness, pcmd->ShapeThickness);
+				}
+				if (pcmd->DistanceField && bd->GL.ActiveTexture)
+				{
+					// Unit 1 doesn't sample its texture, but a unit is skipped unless it has one enabled
+					bd->GL.ActiveTexture(GL_TEXTURE1);
+					glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
+					glEnable(GL_TEXTURE_2D);
+					bd->GL.ActiveTexture(GL_TEXTURE0);
+					glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
+				}
+				else if (pcmd->DistanceField)
+				{
+					// Without OpenGL 1.3, only keep the pixels inside the glyph outline. The alpha is tested after it is multiplied by the vertex color, so text faded below 0.5 disappears.
+					glEnable(GL_ALPHA_TEST);
+					glAlphaFunc(GL_GEQUAL, 0.5f);
+				}
 				glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer);
+				if (pcmd->DistanceField && bd->GL.ActiveTexture)
+				{
+					glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+					bd->GL.ActiveTexture(GL_TEXTURE1);
+					glDisable(GL_TEXTURE_2D);
+					bd->GL.ActiveTexture(GL_TEXTURE0);
+				}
+				else if (pcmd->DistanceField)
+				{
+					glDisable(GL_ALPHA_TEST);
+				}
 			}
 			idx_buffer += pcmd->ElemCount;
 		}
 	}
 
 	// Restore modified state
+	if (bd->ShapeProgram)
+		bd->GL.UseProgram((GLuint)last_program);
 	glDisableClientState(GL_COLOR_ARRAY);
 	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
 	glDisableClientState(GL_VERTEX_ARRAY);
@@ -117,14 +284,21 @@ void ImGui_ImplGL2_RenderDrawData(ImDrawData* draw_data)
 
 static const char* ImGui_ImplGL2_GetClipboardText(void* /*user_data*/)
 {
-	static char buffer[65536];
+	ImGui_ImplGL2_Data* bd = ImGui_ImplGL2_GetData();
+	bd->ClipboardText.resize(0);
 	if (OpenClipboard(NULL))
 	{
-		const char* text = (const char*)GetClipboardData(CF_TEXT);
-		strncpy_s(buffer, text, sizeof(buffer));
+		HANDLE handle = GetClipboardData(CF_TEXT);
+		if (const char* text = handle ? (const char*)GlobalLock(handle) : NULL)
+		{
+			const int len = (int)strlen(text);
+			bd->ClipboardText.resize(len + 1);
+			memcpy(bd->ClipboardText.Data, text, (size_t)len + 1);
+			GlobalUnlock(handle);
+		}
 		CloseClipboard();
 	}
-	return buffer;
+	return bd->ClipboardText.empty() ? "" : bd->ClipboardText.Data;
 }
 
 static void ImGui_ImplGL2_SetClipboardText(void* /*user_data*/, const char* text)
@@ -144,48 +318,229 @@ static void ImGui_ImplGL2_SetClipboardText(void* /*user_data*/, const char* text
 	}
 }
 
-bool ImGui_ImplGL2_CreateDeviceObjects()
+// Create a texture for each page of the font atlas which doesn't have one yet (all of them at startup, then the pages added after Build())
+static void ImGui_ImplGL2_CreateFontsTextures()
 {
-	// Build texture atlas
+	ImGui_ImplGL2_Data* bd = ImGui_ImplGL2_GetData();
 	ImGuiIO& io = ImGui::GetIO();
 	unsigned char* pixels;
 	int width, height;
 	io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height); // Load as RGBA 32-bits (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+	const int page_height = io.Fonts->GetTexPageHeight();
 
-	// Upload texture to graphics system
+	// Upload textures to graphics system
 	GLint last_texture;
 	glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
-	glGenTextures(1, &g_FontTexture);
-	glBindTexture(GL_TEXTURE_2D, g_FontTexture);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
-
-	// Store our identifier
-	io.Fonts->TexID = (void *)(intptr_t)g_FontTexture;
+	while (bd->FontTextures.Size < io.Fonts->TexPagesCount)
+	{
+		const int page = bd->FontTextures.Size;
+		GLuint texture;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, page_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (size_t)page * page_height * width * 4);
+
+		// Store our identifier
+		bd->FontTextures.push_back(texture);
+		io.Fonts->SetTexPageID(page, (void *)(intptr_t)texture);
+	}
 
 	// Restore state
 	glBindTexture(GL_TEXTURE_2D, last_texture);
+}
+
+// Signed distance to the rounded rectangle outline (negative inside), coverage as documented in ImDrawShape_. Circles are rectangles rounded by their radius.
+static const char* ImGui_ImplGL2_ShapeVertexShader =
+	"#version 110\n"
+	"void main()\n"
+	"{\n"
+	"    gl_FrontColor = gl_Color;\n"
+	"    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+	"}\n";
+static const char* ImGui_ImplGL2_ShapeFragmentShader =
+	"#version 110\n"
+	"uniform vec4 ShapeRect;\n"            // x1, y1, x2, y2 in framebuffer pixels
+	"uniform vec4 ShapeRadii;\n"           // Corner radius: top-left, top-right, bottom-right, bottom-left
+	"uniform float ShapeThickness;\n"      // 0.0 for filled shapes
+	"uniform float FramebufferHeight;\n"
+	"void main()\n"
+	"{\n"
+	"    vec2 p = vec2(gl_FragCoord.x, FramebufferHeight - gl_FragCoord.y) - (ShapeRect.xy + ShapeRect.zw) * 0.5;\n"
+	"    float r = p.x < 0.0 ? (p.y < 0.0 ? ShapeRadii.x : ShapeRadii.w) : (p.y < 0.0 ? ShapeRadii.y : ShapeRadii.z);\n"
+	"    vec2 q = abs(p) - (ShapeRect.zw - ShapeRect.xy) * 0.5 + vec2(r);\n"
+	"    float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;\n"
+	"    float coverage = ShapeThickness > 0.0 ? clamp(0.5 * ShapeThickness + 0.5 - abs(d), 0.0, 1.0) : clamp(0.5 - d, 0.0, 1.0);\n"
+	"    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * coverage);\n"
+	"}\n";
+
+static GLuint ImGui_ImplGL2_CompileShader(const ImGui_ImplGL2_Functions& gl, GLenum type, const char* source)
+{
+	GLuint shader = gl.CreateShader(type);
+	gl.ShaderSource(shader, 1, &source, NULL);
+	gl.CompileShader(shader);
+	GLint status = 0;
+	gl.GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	if (!status)
+	{
+		gl.DeleteShader(shader);
+		return 0;
+	}
+	return shader;
+}
+
+static void* ImGui_ImplGL2_GetProcAddress(const char* name)
+{
+	// Some drivers return small values instead of NULL for missing functions
+	void* p = (void*)wglGetProcAddress(name);
+	return ((intptr_t)p >= -1 && (intptr_t)p <= 3) ? NULL : p;
+}
+
+// Load the OpenGL 2.0 entry points and build the analytic shape program. Leaves bd->ShapeProgram to 0 when the driver doesn't support them, shapes are then tessellated.
+static void ImGui_ImplGL2_CreateShapeProgram()
+{
+	ImGui_ImplGL2_Data* bd = ImGui_ImplGL2_GetData();
+	ImGui_ImplGL2_Functions& gl = bd->GL;
+	gl.CreateShader = (ImGui_PFNGLCREATESHADERPROC)ImGui_ImplGL2_GetProcAddress("glCreateShader");
+	gl.ShaderSource = (ImGui_PFNGLSHADERSOURCEPROC)ImGui_ImplGL2_GetProcAddress("glShaderSource");
+	gl.CompileShader = (ImGui_PFNGLCOMPILESHADERPROC)ImGui_ImplGL2_GetProcAddress("glCompileShader");
+	gl.GetShaderiv = (ImGui_PFNGLGETSHADERIVPROC)ImGui_ImplGL2_GetProcAddress("glGetShaderiv");
+	gl.DeleteShader = (ImGui_PFNGLDELETESHADERPROC)ImGui_ImplGL2_GetProcAddress("glDeleteShader");
+	gl.CreateProgram = (ImGui_PFNGLCREATEPROGRAMPROC)ImGui_ImplGL2_GetProcAddress("glCreateProgram");
+	gl.AttachShader = (ImGui_PFNGLATTACHSHADERPROC)ImGui_ImplGL2_GetProcAddress("glAttachShader");
+	gl.LinkProgram = (ImGui_PFNGLLINKPROGRAMPROC)ImGui_ImplGL2_GetProcAddress("glLinkProgram");
+	gl.GetProgramiv = (ImGui_PFNGLGETPROGRAMIVPROC)ImGui_ImplGL2_GetProcAddress("glGetProgramiv");
+	gl.DeleteProgram = (ImGui_PFNGLDELETEPROGRAMPROC)ImGui_ImplGL2_GetProcAddress("glDeleteProgram");
+	gl.UseProgram = (ImGui_PFNGLUSEPROGRAMPROC)ImGui_ImplGL2_GetProcAddress("glUseProgram");
+	gl.GetUniformLocation = (ImGui_PFNGLGETUNIFORMLOCATIONPROC)ImGui_ImplGL2_GetProcAddress("glGetUniformLocation");
+	gl.Uniform1f = (ImGui_PFNGLUNIFORM1FPROC)ImGui_ImplGL2_GetProcAddress("glUniform1f");
+	gl.Uniform4f = (ImGui_PFNGLUNIFORM4FPROC)ImGui_ImplGL2_GetProcAddress("glUniform4f");
+	if (!gl.CreateShader || !gl.ShaderSource || !gl.CompileShader || !gl.GetShaderiv || !gl.DeleteShader || !gl.CreateProgram || !gl.AttachShader || !gl.LinkProgram ||
+		!gl.GetProgramiv || !gl.DeleteProgram || !gl.UseProgram || !gl.GetUniformLocation || !gl.Uniform1f || !gl.Uniform4f)
+		return;
+
+	GLuint vert_shader = ImGui_ImplGL2_CompileShader(gl, GL_VERTEX_SHADER, ImGui_ImplGL2_ShapeVertexShader);
+	GLuint frag_shader = ImGui_ImplGL2_CompileShader(gl, GL_FRAGMENT_SHADER, ImGui_ImplGL2_ShapeFragmentShader);
+	if (vert_shader && frag_shader)
+	{
+		GLuint program = gl.CreateProgram();
+		gl.AttachShader(program, vert_shader);
+		gl.AttachShader(program, frag_shader);
+		gl.LinkProgram(program);
+		GLint status = 0;
+		gl.GetProgramiv(program, GL_LINK_STATUS, &status);
+		if (status)
+			bd->ShapeProgram = program;
+		else
+			gl.DeleteProgram(program);
+	}
+	if (vert_shader)
+		gl.DeleteShader(vert_shader);
+	if (frag_shader)
+		gl.DeleteShader(frag_shader);
+	if (!bd->ShapeProgram)
+		return;
+
+	bd->ShapeUniformRect = gl.GetUniformLocation(bd->ShapeProgram, "ShapeRect");
+	bd->ShapeUniformRadii = gl.GetUniformLocation(bd->ShapeProgram, "ShapeRadii");
+	bd->ShapeUniformThickness = gl.GetUniformLocation(bd->ShapeProgram, "ShapeThickness");
+	bd->ShapeUniformFramebufferHeight = gl.GetUniformLocation(bd->ShapeProgram, "FramebufferHeight");
+	ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_RendererHasAnalyticShapes;
+}
+
+bool ImGui_ImplGL2_CreateDeviceObjects()
+{
+	// Build texture atlas
+	ImGui_ImplGL2_CreateFontsTextures();
+	ImGui::GetIO().Fonts->ClearTexDirty();
 
+	// Distance field text
+	ImGui_ImplGL2_Data* bd = ImGui_ImplGL2_GetData();
+	bd->GL.ActiveTexture = (ImGui_PFNGLACTIVETEXTUREPROC)ImGui_ImplGL2_GetProcAddress("glActiveTexture");
+
+	// Analytic shapes
+	if (bd->ShapeProgram == 0)
+		ImGui_ImplGL2_CreateShapeProgram();
 	return true;
 }
 
+// Upload the rectangles of the font texture modified after it was created (glyphs rasterized on demand, custom rectangles added after Build()).
+// At most FontUploadBudget bytes are uploaded per frame (but at least one row), the rectangles left are kept dirty for the next frames.
+static void ImGui_ImplGL2_UpdateFontsTexture()
+{
+	ImGui_ImplGL2_Data* bd = ImGui_ImplGL2_GetData();
+	ImGuiIO& io = ImGui::GetIO();
+	unsigned char* pixels;
+	int width, height;
+	io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+	const int page_height = io.Fonts->GetTexPageHeight();
+	ImVector<ImFontAtlas::TexDirtyRect>& rects = io.Fonts->TexDirtyRects;
+
+	// Pages added since the last update are created with their current pixels, their rectangles don't need another upload
+	const int new_pages_y = bd->FontTextures.Size * page_height;
+	ImGui_ImplGL2_CreateFontsTextures();
+	for (int n = rects.Size - 1; n >= 0; n--)
+		if (rects[n].Y >= new_pages_y)
+			rects.erase(rects.Data + n);
+
+	GLint last_texture;
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+	int rects_done = 0;
+	for (int budget = bd->FontUploadBudget; rects_done < rects.Size && budget > 0; )
+	{
+		// Upload whole rows of the rectangle, within a single texture page
+		ImFontAtlas::TexDirtyRect& r = rects[rects_done];
+		const int page = r.Y / page_height;
+		const int page_end = (page + 1) * page_height;
+		int h = budget / (r.Width * 4);
+		if (h < 1)
+			h = 1;
+		if (h > r.Height)
+			h = r.Height;
+		if (r.Y + h > page_end)
+			h = page_end - r.Y;
+		glBindTexture(GL_TEXTURE_2D, bd->FontTextures[page]);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, r.X, r.Y - page * page_height, r.Width, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels + ((size_t)r.Y * width + r.X) * 4);
+		budget -= r.Width * h * 4;
+		r.Y += h;
+		r.Height -= h;
+		if (r.Height == 0)
+			rects_done++;
+	}
+	rects.erase(rects.Data, rects.Data + rects_done);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glBindTexture(GL_TEXTURE_2D, last_texture);
+}
+
 void ImGui_ImplGL2_InvalidateDeviceObjects()
 {
-	if (g_FontTexture)
+	ImGui_ImplGL2_Data* bd = ImGui_ImplGL2_GetData();
+	if (!bd->FontTextures.empty())
 	{
-		glDeleteTextures(1, &g_FontTexture);
+		glDeleteTextures(bd->FontTextures.Size, bd->FontTextures.Data);
 		ImGui::GetIO().Fonts->TexID = 0;
-		g_FontTexture = 0;
+		ImGui::GetIO().Fonts->TexPageIDs.clear();
+		bd->FontTextures.clear();
+	}
+	if (bd->ShapeProgram)
+	{
+		bd->GL.DeleteProgram(bd->ShapeProgram);
+		bd->ShapeProgram = 0;
+		ImGui::GetIO().ConfigFlags &= ~ImGuiConfigFlags_RendererHasAnalyticShapes;
 	}
 }
 
+// Initialize the binding for the current context. Call once per context, e.g. once per window each owning an ImGui context and a GL context.
 bool ImGui_ImplGL2_Init(HWND window)
 {
-	g_Window = window;
-
 	ImGuiIO& io = ImGui::GetIO();
+	IM_ASSERT(io.BindingUserData == NULL && "Already initialized a binding for this context!");
+	ImGui_ImplGL2_Data* bd = IM_NEW(ImGui_ImplGL2_Data)();
+	bd->Window = window;
+	io.BindingUserData = bd;
+
 	io.KeyMap[ImGuiKey_Tab] = VK_TAB; // Keyboard mapping. ImGui will use those indices to peek into the io.KeyDown[] array that we will update during the application lifetime.
 	io.KeyMap[ImGuiKey_LeftArrow] = VK_LEFT;
 	io.KeyMap[ImGuiKey_RightArrow] = VK_RIGHT;
@@ -213,8 +568,11 @@ bool ImGui_ImplGL2_Init(HWND window)
 
 	LARGE_INTEGER qpf;
 	QueryPerformanceFrequency(&qpf);
-	g_RcpQueryPerformanceFrequency = 1.0 / (double)qpf.QuadPart;
-	QueryPerformanceCounter(&g_QueryPerformanceCounterStart);
+	bd->RcpQueryPerformanceFrequency = 1.0 / (double)qpf.QuadPart;
+	QueryPerformanceCounter(&bd->QueryPerformanceCounterStart);
+
+	// Read the .ini file while the application keeps initializing (set io.IniFilename before calling this function)
+	ImGui::PreloadIniSettings();
 
 	return true;
 }
@@ -223,11 +581,17 @@ void ImGui_ImplGL2_Shutdown()
 {
 	// Destroy OpenGL objects
 	ImGui_ImplGL2_InvalidateDeviceObjects();
+
+	ImGuiIO& io = ImGui::GetIO();
+	ImGui_ImplGL2_Data* bd = (ImGui_ImplGL2_Data*)io.BindingUserData;
+	IM_DELETE(bd);
+	io.BindingUserData = NULL;
 }
 
 bool ImGui_ImplGL2_Handle_Message(UINT msg, WPARAM wparam, LPARAM lparam)
 {
-	if (!ImGui::GetCurrentContext())
+	ImGui_ImplGL2_Data* bd = ImGui_ImplGL2_GetData();
+	if (!bd)
 		return false;
 
 	ImGuiIO& io = ImGui::GetIO();
@@ -248,6 +612,22 @@ bool ImGui_ImplGL2_Handle_Message(UINT msg, WPARAM wparam, LPARAM lparam)
 		case WM_CHAR:
 		{
 			unsigned short ch = (unsigned short)wparam;
+#ifdef IMGUI_USE_WCHAR32
+			// WM_CHAR sends codepoints beyond the Basic Multilingual Plane as two UTF-16 surrogates
+			if (ch >= 0xD800 && ch < 0xDC00)
+			{
+				bd->HighSurrogate = ch;
+				return true;
+			}
+			if (ch >= 0xDC00 && ch < 0xE000)
+			{
+				if (bd->HighSurrogate != 0)
+					io.AddInputCharacter((ImWchar)(0x10000 + ((bd->HighSurrogate - 0xD800) << 10) + (ch - 0xDC00)));
+				bd->HighSurrogate = 0;
+				return true;
+			}
+			bd->HighSurrogate = 0;
+#endif
 			if (ch > 0 && ch < 0x10000)
 			{
 				io.AddInputCharacter(ch);
@@ -278,7 +658,7 @@ bool ImGui_ImplGL2_Handle_Message(UINT msg, WPARAM wparam, LPARAM lparam)
 			if (msg == WM_RBUTTONDOWN) button = 1;
 			if (msg == WM_MBUTTONDOWN) button = 2;
 			io.MouseDown[button] = true;
-			SetCapture(g_Window);
+			SetCapture(bd->Window);
 			return true;
 		} break;
 
@@ -315,10 +695,15 @@ bool ImGui_ImplGL2_Handle_Message(UINT msg, WPARAM wparam, LPARAM lparam)
 
 void ImGui_ImplGL2_NewFrame(int w, int h, int display_w, int display_h)
 {
-	if (!g_FontTexture)
-		ImGui_ImplGL2_CreateDeviceObjects();
-
+	// Create the font textures at startup, create them again when the font atlas was built again (Build() clears TexID)
+	ImGui_ImplGL2_Data* bd = ImGui_ImplGL2_GetData();
+	IM_ASSERT(bd != NULL && "Did you call ImGui_ImplGL2_Init() for the current context?");
 	ImGuiIO& io = ImGui::GetIO();
+	if (bd->FontTextures.empty() || io.Fonts->TexID == NULL)
+	{
+		ImGui_ImplGL2_InvalidateDeviceObjects();
+		ImGui_ImplGL2_CreateDeviceObjects();
+	}
 
 	io.KeyCtrl = (GetKeyState(VK_CONTROL) & 0x8000) != 0;
 	io.KeyShift = (GetKeyState(VK_SHIFT) & 0x8000) != 0;
@@ -332,10 +717,14 @@ void ImGui_ImplGL2_NewFrame(int w, int h, int display_w, int display_h)
 	// Setup time step
 	LARGE_INTEGER qpc;
 	QueryPerformanceCounter(&qpc);
-	double current_time = (double)(qpc.QuadPart - g_QueryPerformanceCounterStart.QuadPart) * g_RcpQueryPerformanceFrequency;
-	io.DeltaTime = g_Time > 0.0 ? (float)(current_time - g_Time) : (float)(1.0f/60.0f);
-	g_Time = current_time;
+	double current_time = (double)(qpc.QuadPart - bd->QueryPerformanceCounterStart.QuadPart) * bd->RcpQueryPerformanceFrequency;
+	io.DeltaTime = bd->Time > 0.0 ? (float)(current_time - bd->Time) : (float)(1.0f/60.0f);
+	bd->Time = current_time;
 
 	// Start the frame. This call will update the io.WantCaptureMouse, io.WantCaptureKeyboard flag that you can use to dispatch inputs (or not) to your application.
 	ImGui::NewFrame();
+
+	// Upload glyphs rasterized by NewFrame()
+	if (io.Fonts->IsTexDirty())
+		ImGui_ImplGL2_UpdateFontsTexture();
 }
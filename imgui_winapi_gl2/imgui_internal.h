@@ -16,6 +16,12 @@
 #include <math.h>       // sqrtf, fabsf, fmodf, powf, floorf, ceilf, cosf, sinf
 #include <limits.h>     // INT_MIN, INT_MAX
 
+// Enable SSE2 intrinsics for some text processing fast paths (see IMGUI_DISABLE_SSE in imconfig.h)
+#if (defined __SSE2__ || defined __x86_64__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)) && !defined(IMGUI_DISABLE_SSE)
+#define IMGUI_ENABLE_SSE
+#include <emmintrin.h>
+#endif
+
 #ifdef _MSC_VER
 #pragma warning (push)
 #pragma warning (disable: 4251) // class 'xxx' needs to have dll-interface to be used by clients of struct 'xxx' // when IMGUI_API is set to__declspec(dllexport)
@@ -40,6 +46,9 @@ struct ImGuiMenuColumns;
 struct ImGuiDrawContext;
 struct ImGuiTextEditState;
 struct ImGuiPopupRef;
+struct ImGuiSettingsThread;
+struct ImGuiLogWriter;
+struct ImGuiTextFilterWorkers;
 struct ImGuiWindow;
 struct ImGuiWindowSettings;
 
@@ -51,6 +60,7 @@ typedef int ImGuiNavHighlightFlags; // flags: for RenderNavHighlight()
 typedef int ImGuiNavDirSourceFlags; // flags: for GetNavInputAmount2d()         // enum ImGuiNavDirSourceFlags_
 typedef int ImGuiSeparatorFlags;    // flags: for Separator() - internal        // enum ImGuiSeparatorFlags_
 typedef int ImGuiSliderFlags;       // flags: for SliderBehavior()              // enum ImGuiSliderFlags_
+typedef int ImGuiAllocCategory;     // enum: for IM_ALLOC_CATEGORY()            // enum ImGuiAllocCategory_
 
 //-------------------------------------------------------------------------
 // STB libraries
@@ -73,8 +83,15 @@ namespace ImGuiStb
 //-----------------------------------------------------------------------------
 
 #ifndef GImGui
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#error IMGUI_ENABLE_THREAD_LOCAL_CONTEXT requires VS2015 or later (thread_local, thread-safe initialization of local statics)
+#endif
+extern IMGUI_API thread_local ImGuiContext* GImGui;  // Current implicit ImGui context pointer, one per thread
+#else
 extern IMGUI_API ImGuiContext* GImGui;  // Current implicit ImGui context pointer
 #endif
+#endif
 
 //-----------------------------------------------------------------------------
 // Helpers
@@ -94,10 +111,38 @@ IMGUI_API int           ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char
 IMGUI_API int           ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end);                            // return number of UTF-8 code-points (NOT bytes count)
 IMGUI_API int           ImTextCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end);                   // return number of bytes to express string as UTF-8 code-points
 
+// Helpers: UTF-8 <> UTF-16 for the Win32 wide character functions (wchar_t is 16-bit on Windows, ImWchar can be 32-bit, see IMGUI_USE_WCHAR32)
+IMGUI_API int           ImTextStrToUtf16(wchar_t* buf, int buf_size, const char* in_text, const char* in_text_end);         // return output UTF-16 units count
+IMGUI_API int           ImTextCountUtf16UnitsFromUtf8(const char* in_text, const char* in_text_end);                       // return number of UTF-16 units, 2 for codepoints above 0xFFFF
+IMGUI_API int           ImTextStrFromUtf16(char* buf, int buf_size, const wchar_t* in_text, const wchar_t* in_text_end);    // return output UTF-8 bytes count
+IMGUI_API int           ImTextCountUtf8BytesFromUtf16(const wchar_t* in_text, const wchar_t* in_text_end);                 // return number of bytes to express string as UTF-8
+
+// Helpers: Text fast paths
+// Return the number of leading bytes in the 0x20..0x7F range: printable ASCII characters map 1:1 to codepoints and don't need any special handling when measuring or wrapping text
+static inline int ImTextCountPrintableAscii(const char* in_text, const char* in_text_end)
+{
+    const char* p = in_text;
+#ifdef IMGUI_ENABLE_SSE
+    // 0x20..0x7F are the only bytes greater than 0x1F when compared as signed chars
+    const __m128i control_max = _mm_set1_epi8(0x1F);
+    while (in_text_end - p >= 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)p);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(chars, control_max)) != 0xFFFF)
+            break;
+        p += 16;
+    }
+#endif
+    while (p < in_text_end && (unsigned char)*p >= 0x20 && (unsigned char)*p < 0x80)
+        p++;
+    return (int)(p - in_text);
+}
+
 // Helpers: Misc
 IMGUI_API ImU32         ImHash(const void* data, int data_size, ImU32 seed = 0);    // Pass data_size==0 for zero-terminated strings
 IMGUI_API void*         ImFileLoadToMemory(const char* filename, const char* file_open_mode, int* out_file_size = NULL, int padding_bytes = 0);
 IMGUI_API FILE*         ImFileOpen(const char* filename, const char* file_open_mode);
+IMGUI_API bool          ImFileReplace(const char* src_filename, const char* dst_filename);    // Rename 'src_filename', atomically replacing 'dst_filename' if it exists
 static inline bool      ImCharIsSpace(int c)            { return c == ' ' || c == '\t' || c == 0x3000; }
 static inline bool      ImIsPowerOfTwo(int v)           { return v != 0 && (v & (v - 1)) == 0; }
 static inline int       ImUpperPowerOfTwo(int v)        { v--; v |= v >> 1; v |= v >> 2; v |= v >> 4; v |= v >> 8; v |= v >> 16; v++; return v; }
@@ -174,6 +219,46 @@ inline void  operator   delete(void*, ImNewPlacementDummy, void*)   {} // This i
 #define IM_NEW(_TYPE)                       new(ImNewPlacementDummy(), ImGui::MemAlloc(sizeof(_TYPE))) _TYPE
 template <typename T> void IM_DELETE(T*& p) { if (p) { p->~T(); ImGui::MemFree(p); p = NULL; } }
 
+// Categories of memory allocations counted with IMGUI_ENABLE_ALLOCATION_STATS.
+// IM_ALLOC_CATEGORY() attributes the allocations made until the end of the current scope, the innermost scope wins.
+enum ImGuiAllocCategory_
+{
+    ImGuiAllocCategory_Misc,
+    ImGuiAllocCategory_DrawList,
+    ImGuiAllocCategory_Storage,
+    ImGuiAllocCategory_Text,
+    ImGuiAllocCategory_Window,
+    ImGuiAllocCategory_COUNT
+};
+
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+// Counters of memory allocations. Process-wide like the allocator functions, so they include the allocations of every context and thread.
+struct ImGuiAllocStats
+{
+    size_t  Count[ImGuiAllocCategory_COUNT];        // Allocations made
+    size_t  Bytes[ImGuiAllocCategory_COUNT];        // Bytes allocated
+    size_t  LiveBytes[ImGuiAllocCategory_COUNT];    // Bytes allocated and not freed yet
+    size_t  PeakLiveBytes;                          // Highest sum of LiveBytes[]
+    ImGuiAllocStats() { memset(this, 0, sizeof(*this)); }
+};
+
+namespace ImGui
+{
+    IMGUI_API ImGuiAllocCategory SetAllocCategory(ImGuiAllocCategory category);   // Return the previous category. Per thread when threads may allocate.
+    IMGUI_API void          GetAllocStats(ImGuiAllocStats* out_stats);          // Counters since startup. PeakLiveBytes is the peak since the last NewFrame() of any context.
+}
+
+struct ImGuiAllocCategoryScope
+{
+    ImGuiAllocCategory BackupCategory;
+    ImGuiAllocCategoryScope(ImGuiAllocCategory category)    { BackupCategory = ImGui::SetAllocCategory(category); }
+    ~ImGuiAllocCategoryScope()                              { ImGui::SetAllocCategory(BackupCategory); }
+};
+#define IM_ALLOC_CATEGORY(_CATEGORY)        ImGuiAllocCategoryScope im_alloc_category_scope(_CATEGORY)
+#else
+#define IM_ALLOC_CATEGORY(_CATEGORY)
+#endif
+
 //-----------------------------------------------------------------------------
 // Types
 //-----------------------------------------------------------------------------
@@ -384,12 +469,24 @@ struct IMGUI_API ImGuiMenuColumns
 };
 
 // Internal state of the currently focused/edited text input box
+// Line of the text being edited, see ImGuiTextEditState::Lines
+struct ImGuiTextEditLine
+{
+    int                 StartW;                     // offset of the first character in Text
+    int                 StartA;                     // offset of the first character in TextA
+    float               Width;                      // width of the line without its '\n', < 0.0f when not measured yet
+};
+
 struct IMGUI_API ImGuiTextEditState
 {
     ImGuiID             Id;                         // widget id owning the text state
     ImVector<ImWchar>   Text;                       // edit buffer, we need to persist but can't guarantee the persistence of the user-provided buffer. so we copy into own buffer.
+    ImVector<char>      TextA;                      // UTF-8 copy of Text, kept in sync by every insertion/deletion (displayed and copied back to the user buffer)
     ImVector<char>      InitialText;                // backup of end-user buffer at the time of focus (in UTF-8, unaltered)
     ImVector<char>      TempTextBuffer;
+    ImVector<ImGuiTextEditLine> Lines;              // line index, kept in sync by every insertion/deletion so we never rescan the whole text to locate the cursor or the visible lines
+    ImFont*             LinesFont;                  // font and size Lines[].Width were measured with
+    float               LinesFontSize;
     int                 CurLenA, CurLenW;           // we need to maintain our buffer length in both UTF-8 and wchar format.
     int                 BufSizeA;                   // end-user buffer size
     float               ScrollX;
@@ -397,6 +494,7 @@ struct IMGUI_API ImGuiTextEditState
     float               CursorAnim;
     bool                CursorFollow;
     bool                SelectedAllMouseLock;
+    bool                TextAIsDirty;               // TextA changed since it was last copied back to the user buffer
 
     ImGuiTextEditState()                            { memset(this, 0, sizeof(*this)); }
     void                CursorAnimReset()           { CursorAnim = -0.30f; }                                   // After a user-input the cursor stays on for a while without blinking
@@ -405,6 +503,10 @@ struct IMGUI_API ImGuiTextEditState
     void                ClearSelection()            { StbState.select_start = StbState.select_end = StbState.cursor; }
     void                SelectAll()                 { StbState.select_start = 0; StbState.cursor = StbState.select_end = CurLenW; StbState.has_preferred_x = false; }
     void                OnKeyPressed(int key);
+    void                SetText(const char* text);                  // Replace Text/TextA and rebuild Lines, O(N)
+    int                 FindLine(int pos_w) const;                  // Index of the line holding character 'pos_w', O(log N)
+    int                 GetOffsetA(int pos_w) const;                // Offset in TextA of character 'pos_w' in Text
+    int                 GetOffsetW(int pos_a) const;                // Offset in Text of byte 'pos_a' in TextA
 };
 
 // Data saved in imgui.ini file
@@ -423,8 +525,8 @@ struct ImGuiSettingsHandler
 {
     const char* TypeName;   // Short description stored in .ini file. Disallowed characters: '[' ']'  
     ImGuiID     TypeHash;   // == ImHash(TypeName, 0, 0)
-    void*       (*ReadOpenFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, const char* name);
-    void        (*ReadLineFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, void* entry, const char* line);
+    void*       (*ReadOpenFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, const char* name, const char* name_end);           // Strings point into the .ini data and are NOT zero-terminated
+    void        (*ReadLineFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, void* entry, const char* line, const char* line_end);
     void        (*WriteAllFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* out_buf);
     void*       UserData;
 
@@ -677,19 +779,26 @@ struct ImGuiContext
     float                   DragSpeedScaleFast;
     ImVec2                  ScrollbarClickDeltaToGrabCenter;    // Distance between mouse and center of grab box, normalized in parent space. Use storage?
     int                     TooltipOverrideCount;
-    ImVector<char>          PrivateClipboard;                   // If no custom clipboard handler is defined
+    ImVector<char>          PrivateClipboard;                   // If no custom clipboard handler is defined. Also holds the text returned by the default Win32 handler.
     ImVec2                  OsImePosRequest, OsImePosSet;       // Cursor position request & last passed to the OS Input Method Editor
+    ImGuiTextFilterWorkers* TextFilterWorkers;                  // Worker threads of ImGuiTextFilter::PassFilterArray() (IMGUI_ENABLE_TEXT_FILTER_THREADS), created on first use
 
     // Settings
     bool                           SettingsLoaded;
     float                          SettingsDirtyTimer;          // Save .ini Settings on disk when time reaches zero
     ImVector<ImGuiWindowSettings>  SettingsWindows;             // .ini settings for ImGuiWindow
+    ImGuiStorage                   SettingsWindowsById;         // Id -> index+1 in SettingsWindows
     ImVector<ImGuiSettingsHandler> SettingsHandlers;            // List of .ini settings handlers
+    ImGuiSettingsThread*           SettingsThread;              // Background .ini reader/writer (IMGUI_ENABLE_INI_SETTINGS_THREAD), created on first use
 
     // Logging
     bool                    LogEnabled;
     FILE*                   LogFile;                            // If != NULL log to stdout/ file
-    ImGuiTextBuffer*        LogClipboard;                       // Else log to clipboard. This is pointer so our GImGui static constructor doesn't call heap allocators.
+    ImGuiTextBuffer*        LogClipboard;                       // Else log to clipboard. Also buffers the output for LogFile, written in chunks of IMGUI_LOG_FILE_CHUNK_SIZE bytes. This is pointer so our GImGui static constructor doesn't call heap allocators.
+    ImGuiLogWriter*         LogWriter;                          // Background writer of LogFile (IMGUI_ENABLE_LOG_FILE_THREAD)
+    ImU64                   LogBytesWritten;                    // Bytes passed to LogFile (or to its writer thread) since the context was created
+    ImU64                   LogBytesDropped;                    // Bytes discarded by io.LogFileOverflow
+    int                     LogChunksDropped;
     int                     LogStartDepth;
     int                     LogAutoExpandMaxDepth;
 
@@ -700,6 +809,15 @@ struct ImGuiContext
     int                     WantCaptureMouseNextFrame;          // explicit capture via CaptureInputs() sets those flags
     int                     WantCaptureKeyboardNextFrame;
     int                     WantTextInputNextFrame;
+    bool                    MetricsShowClipRects;               // ShowMetricsWindow() option, kept here rather than in a static so contexts on different threads don't share it
+    size_t                  AllocsCount;                        // Allocations made while this context was current, not counting the settings and log writer threads
+    size_t                  FrameAllocsStart;                   // AllocsCount when the frame began, for io.MetricsFrameAllocs
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+    ImGuiAllocStats         AllocStats;                         // Count[] and Bytes[] of the allocations counted in AllocsCount
+    ImGuiAllocStats         AllocStatsFrameStart;               // AllocStats when the frame began
+    ImGuiAllocStats         AllocStatsLastFrame;                // Allocations made with this context during the last frame. LiveBytes at its end and PeakLiveBytes during it are process-wide.
+    size_t                  AllocStatsPeakFrameStart;           // Frame of the process-wide peak history started by the last NewFrame() of this context
+#endif
     char                    TempBuffer[1024*3+1];               // temporary text buffer
 
     ImGuiContext(ImFontAtlas* shared_font_atlas) : OverlayDrawList(NULL)
@@ -783,13 +901,18 @@ struct ImGuiContext
         ScrollbarClickDeltaToGrabCenter = ImVec2(0.0f, 0.0f);
         TooltipOverrideCount = 0;
         OsImePosRequest = OsImePosSet = ImVec2(-1.0f, -1.0f);
+        TextFilterWorkers = NULL;
 
         SettingsLoaded = false;
         SettingsDirtyTimer = 0.0f;
+        SettingsThread = NULL;
 
         LogEnabled = false;
         LogFile = NULL;
         LogClipboard = NULL;
+        LogWriter = NULL;
+        LogBytesWritten = LogBytesDropped = 0;
+        LogChunksDropped = 0;
         LogStartDepth = 0;
         LogAutoExpandMaxDepth = 2;
 
@@ -797,6 +920,11 @@ struct ImGuiContext
         FramerateSecPerFrameIdx = 0;
         FramerateSecPerFrameAccum = 0.0f;
         WantCaptureMouseNextFrame = WantCaptureKeyboardNextFrame = WantTextInputNextFrame = -1;
+        MetricsShowClipRects = true;
+        AllocsCount = FrameAllocsStart = 0;
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+        AllocStatsPeakFrameStart = 0;
+#endif
         memset(TempBuffer, 0, sizeof(TempBuffer));
     }
 };
@@ -1028,6 +1156,7 @@ namespace ImGui
     IMGUI_API void                  MarkIniSettingsDirty();
     IMGUI_API ImGuiSettingsHandler* FindSettingsHandler(const char* type_name);
     IMGUI_API ImGuiWindowSettings*  FindWindowSettings(ImGuiID id);
+    IMGUI_API void                  LoadIniSettingsFromMemory(const char* buf, const char* buf_end = NULL); // The buffer is only read (e.g. a memory-mapped file). Call before the first NewFrame() to replace loading io.IniFilename.
 
     IMGUI_API void          SetActiveID(ImGuiID id, ImGuiWindow* window);
     IMGUI_API ImGuiID       GetActiveID();
@@ -1138,7 +1267,12 @@ IMGUI_API bool              ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildRegisterDefaultCustomRects(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent); 
 IMGUI_API void              ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* spc);
+IMGUI_API bool              ImFontAtlasBuildInsertCustomRect(ImFontAtlas* atlas, int rect_index);
 IMGUI_API void              ImFontAtlasBuildFinish(ImFontAtlas* atlas);
+IMGUI_API bool              ImFontAtlasBuildDynamicGlyphs(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasBuildClearParsedFonts(ImFontAtlas* atlas);
+IMGUI_API bool              ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, const char* filename);
+IMGUI_API bool              ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, const char* filename);
 IMGUI_API void              ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void              ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
 
@@ -3,6 +3,7 @@
 // [ImGui] - fixed a state corruption/crash bug in stb_text_redo and stb_textedit_discard_redo (#715)
 // [ImGui] - fixed a crash bug in stb_textedit_discard_redo (#681)
 // [ImGui] - fixed some minor warnings
+// [ImGui] - added optional STB_TEXTEDIT_SEEKROW_Y/STB_TEXTEDIT_SEEKROW_CHAR hooks so locating a row doesn't lay out every row above it
 
 // stb_textedit.h - v1.9  - public domain - Sean Barrett
 // Development of this library was sponsored by RAD Game Tools
@@ -166,6 +167,8 @@
 //    STB_TEXTEDIT_K_LINEEND2            secondary keyboard input to move cursor to end of line
 //    STB_TEXTEDIT_K_TEXTSTART2          secondary keyboard input to move cursor to start of text
 //    STB_TEXTEDIT_K_TEXTEND2            secondary keyboard input to move cursor to end of text
+//    STB_TEXTEDIT_SEEKROW_Y(obj,y,&i,&row_y)                 [ImGui] set i/row_y to the start/y of a row at or above the one straddling y
+//    STB_TEXTEDIT_SEEKROW_CHAR(obj,n,&i,&prev_i,&row_y)      [ImGui] set i/row_y to the start/y of the row holding char n (or a row above it), prev_i to the row before
 //
 // Todo:
 //    STB_TEXTEDIT_K_PGUP        keyboard input to move cursor up a page
@@ -399,6 +402,11 @@ static int stb_text_locate_coord(STB_TEXTEDIT_STRING *str, float x, float y)
    r.ymin = r.ymax = 0;
    r.num_chars = 0;
 
+#ifdef STB_TEXTEDIT_SEEKROW_Y
+   // [ImGui] start from a row at or above the one straddling 'y'
+   STB_TEXTEDIT_SEEKROW_Y(str, y, &i, &base_y);
+#endif
+
    // search rows to find one that straddles 'y'
    while (i < n) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
@@ -508,6 +516,13 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
          find->y = 0;
          find->x = 0;
          find->height = 1;
+#ifdef STB_TEXTEDIT_SEEKROW_CHAR
+         {
+            // [ImGui] start from the last row
+            float last_row_y;
+            STB_TEXTEDIT_SEEKROW_CHAR(str, z, &i, &prev_start, &last_row_y);
+         }
+#endif
          while (i < z) {
             STB_TEXTEDIT_LAYOUTROW(&r, str, i);
             prev_start = i;
@@ -522,6 +537,10 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
 
    // search rows to find the one that straddles character n
    find->y = 0;
+#ifdef STB_TEXTEDIT_SEEKROW_CHAR
+   // [ImGui] start from the row holding character n, or one above it
+   STB_TEXTEDIT_SEEKROW_CHAR(str, n, &i, &prev_start, &find->y);
+#endif
 
    for(;;) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
@@ -1086,6 +1086,11 @@ typedef int stbtt__test_oversample_pow2[(STBTT_MAX_OVERSAMPLE & (STBTT_MAX_OVERS
 #define STBTT_RASTERIZER_VERSION 2
 #endif
 
+// #define STBTT_SSE2 to convert scanlines and apply the oversampling prefilters with SSE2 (output is unchanged)
+#ifdef STBTT_SSE2
+#include <emmintrin.h>
+#endif
+
 #ifdef _MSC_VER
 #define STBTT__NOTUSED(v)  (void)(v)
 #else
@@ -3174,6 +3179,35 @@ static void stbtt__rasterize_sorted_edges(stbtt__bitmap *result, stbtt__edge *e,
       if (active)
          stbtt__fill_active_edges_new(scanline, scanline2+1, result->w, active, scan_y_top);
 
+#ifdef STBTT_SSE2
+      {
+         // the running sum is inherently serial, so accumulate it first with the same float operations as below,
+         // then convert 16 pixels at a time. cvttps+packs+packus saturate exactly like the scalar clamp.
+         const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+         const __m128 scale = _mm_set1_ps(255.0f), bias = _mm_set1_ps(0.5f);
+         unsigned char *dest = result->pixels + j*result->stride;
+         float sum = 0;
+         for (i=0; i < result->w; ++i) {
+            sum += scanline2[i];
+            scanline[i] += sum;
+         }
+         for (i=0; i + 16 <= result->w; i += 16) {
+            __m128i m0 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_and_ps(_mm_loadu_ps(scanline+i   ), abs_mask), scale), bias));
+            __m128i m1 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_and_ps(_mm_loadu_ps(scanline+i+ 4), abs_mask), scale), bias));
+            __m128i m2 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_and_ps(_mm_loadu_ps(scanline+i+ 8), abs_mask), scale), bias));
+            __m128i m3 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_and_ps(_mm_loadu_ps(scanline+i+12), abs_mask), scale), bias));
+            _mm_storeu_si128((__m128i *) (dest + i), _mm_packus_epi16(_mm_packs_epi32(m0, m1), _mm_packs_epi32(m2, m3)));
+         }
+         for (; i < result->w; ++i) {
+            float k;
+            int m;
+            k = (float) STBTT_fabs(scanline[i])*255 + 0.5f;
+            m = (int) k;
+            if (m > 255) m = 255;
+            dest[i] = (unsigned char) m;
+         }
+      }
+#else
       {
          float sum = 0;
          for (i=0; i < result->w; ++i) {
@@ -3187,6 +3221,7 @@ static void stbtt__rasterize_sorted_edges(stbtt__bitmap *result, stbtt__edge *e,
             result->pixels[j*result->stride + i] = (unsigned char) m;
          }
       }
+#endif
       // advance all the edges
       step = &active;
       while (*step) {
@@ -3817,11 +3852,75 @@ STBTT_DEF void stbtt_PackSetOversampling(stbtt_pack_context *spc, unsigned int h
 
 #define STBTT__OVER_MASK  (STBTT_MAX_OVERSAMPLE-1)
 
+#ifdef STBTT_SSE2
+// Box filters computed on 16 bytes at a time. Totals are at most 255*kernel_width so they fit in 16 bits, and
+// mulhi by ceil(65536/kernel_width) gives the exact integer division for kernel_width <= 16.
+static int stbtt__h_prefilter_sse2(unsigned char *pixels, int w, int h, int stride_in_bytes, unsigned int kernel_width)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i inv_kernel = _mm_set1_epi16((short) ((65536 + kernel_width - 1) / kernel_width));
+   int blocks = (w - (int) kernel_width + 1) / 16;
+   int x_end = w - blocks*16;
+   int j;
+   if (kernel_width > 16 || blocks <= 0)
+      return w;
+   // each row is filtered right to left so a block's inputs (x-kernel_width+1 .. x+15) are still unfiltered.
+   // blocks stop before they would read left of the row; the first x_end pixels are left to the scalar filter.
+   for (j=0; j < h; ++j) {
+      unsigned char *row = pixels + j*stride_in_bytes;
+      int x;
+      for (x = w - 16; x >= x_end; x -= 16) {
+         __m128i lo = zero, hi = zero;
+         unsigned int s;
+         for (s=0; s < kernel_width; ++s) {
+            __m128i v = _mm_loadu_si128((const __m128i *) (row + x - s));
+            lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(v, zero));
+            hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(v, zero));
+         }
+         _mm_storeu_si128((__m128i *) (row + x), _mm_packus_epi16(_mm_mulhi_epu16(lo, inv_kernel), _mm_mulhi_epu16(hi, inv_kernel)));
+      }
+   }
+   return x_end;
+}
+
+static int stbtt__v_prefilter_sse2(unsigned char *pixels, int w, int h, int stride_in_bytes, unsigned int kernel_width)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i inv_kernel = _mm_set1_epi16((short) ((65536 + kernel_width - 1) / kernel_width));
+   __m128i buffer[STBTT_MAX_OVERSAMPLE];
+   int x;
+   if (kernel_width > 16)
+      return 0;
+   // same running total as the scalar filter, for 16 columns at once. rows past the glyph are zero, so reading
+   // them unconditionally matches the scalar tail loop.
+   for (x=0; x + 16 <= w; x += 16) {
+      unsigned char *col = pixels + x;
+      __m128i total_lo = zero, total_hi = zero;
+      int i;
+      for (i=0; i < STBTT_MAX_OVERSAMPLE; ++i)
+         buffer[i] = zero;
+      for (i=0; i < h; ++i) {
+         __m128i v = _mm_loadu_si128((const __m128i *) (col + i*stride_in_bytes));
+         __m128i old = buffer[i & STBTT__OVER_MASK];
+         total_lo = _mm_sub_epi16(_mm_add_epi16(total_lo, _mm_unpacklo_epi8(v, zero)), _mm_unpacklo_epi8(old, zero));
+         total_hi = _mm_sub_epi16(_mm_add_epi16(total_hi, _mm_unpackhi_epi8(v, zero)), _mm_unpackhi_epi8(old, zero));
+         buffer[(i+kernel_width) & STBTT__OVER_MASK] = v;
+         _mm_storeu_si128((__m128i *) (col + i*stride_in_bytes), _mm_packus_epi16(_mm_mulhi_epu16(total_lo, inv_kernel), _mm_mulhi_epu16(total_hi, inv_kernel)));
+      }
+   }
+   return x;
+}
+#endif
+
 static void stbtt__h_prefilter(unsigned char *pixels, int w, int h, int stride_in_bytes, unsigned int kernel_width)
 {
    unsigned char buffer[STBTT_MAX_OVERSAMPLE];
    int safe_w = w - kernel_width;
    int j;
+#ifdef STBTT_SSE2
+   w = stbtt__h_prefilter_sse2(pixels, w, h, stride_in_bytes, kernel_width);
+   if (safe_w > w - 1) safe_w = w - 1;
+#endif
    STBTT_memset(buffer, 0, STBTT_MAX_OVERSAMPLE); // suppress bogus warning from VS2013 -analyze
    for (j=0; j < h; ++j) {
       int i;
@@ -3884,6 +3983,11 @@ static void stbtt__v_prefilter(unsigned char *pixels, int w, int h, int stride_i
    unsigned char buffer[STBTT_MAX_OVERSAMPLE];
    int safe_h = h - kernel_width;
    int j;
+#ifdef STBTT_SSE2
+   j = stbtt__v_prefilter_sse2(pixels, w, h, stride_in_bytes, kernel_width);
+   pixels += j;
+   w -= j;
+#endif
    STBTT_memset(buffer, 0, STBTT_MAX_OVERSAMPLE); // suppress bogus warning from VS2013 -analyze
    for (j=0; j < w; ++j) {
       int i;
@@ -0,0 +1,100 @@
+// Startup benchmark: ImFontAtlas::Build() time by font count and glyph range size, single-threaded vs worker threads.
+// Fails if the threaded build doesn't produce the same texture and glyphs as the single-threaded one.
+// Usage: bench_font_atlas_build [font.ttf ...]   (the embedded ProggyClean font is used when no font is given)
+// Built with IMGUI_ENABLE_FONT_ATLAS_BUILD_THREADS by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+struct BenchRanges
+{
+    const char*     Name;
+    const ImWchar*  Ranges;
+};
+
+static double BuildAtlas(ImFontAtlas& atlas, int argc, char** argv, int fonts_count, const ImWchar* ranges, int threads_count)
+{
+    atlas.Clear();
+    atlas.BuildThreadsCount = threads_count;
+    for (int n = 0; n < fonts_count; n++)
+    {
+        ImFontConfig cfg;
+        cfg.SizePixels = 13.0f + (float)n * 2.0f;
+        cfg.GlyphRanges = ranges;
+        if (argc > 1)
+            atlas.AddFontFromFileTTF(argv[1 + n % (argc - 1)], cfg.SizePixels, &cfg, ranges);
+        else
+        {
+            atlas.AddFontDefault(&cfg);
+            atlas.ConfigData.back().GlyphRanges = ranges; // AddFontDefault() always uses the default ranges
+        }
+    }
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    atlas.Build();
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+static bool SameGlyph(const ImFontGlyph& a, const ImFontGlyph& b)
+{
+    return a.Codepoint == b.Codepoint && a.Page == b.Page && a.TexPage == b.TexPage && a.AdvanceX == b.AdvanceX &&
+        a.X0 == b.X0 && a.Y0 == b.Y0 && a.X1 == b.X1 && a.Y1 == b.Y1 && a.U0 == b.U0 && a.V0 == b.V0 && a.U1 == b.U1 && a.V1 == b.V1;
+}
+
+static bool SameAtlas(const ImFontAtlas& a, const ImFontAtlas& b)
+{
+    if (a.TexWidth != b.TexWidth || a.TexHeight != b.TexHeight || memcmp(a.TexPixelsAlpha8, b.TexPixelsAlpha8, (size_t)a.TexWidth * a.TexHeight) != 0)
+        return false;
+    if (a.Fonts.Size != b.Fonts.Size)
+        return false;
+    for (int n = 0; n < a.Fonts.Size; n++)
+    {
+        if (a.Fonts[n]->Glyphs.Size != b.Fonts[n]->Glyphs.Size)
+            return false;
+        for (int glyph_i = 0; glyph_i < a.Fonts[n]->Glyphs.Size; glyph_i++)
+            if (!SameGlyph(a.Fonts[n]->Glyphs[glyph_i], b.Fonts[n]->Glyphs[glyph_i]))
+                return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    ImFontAtlas ranges_atlas;
+    const BenchRanges ranges_list[] =
+    {
+        { "Default",     ranges_atlas.GetGlyphRangesDefault() },
+        { "Cyrillic",    ranges_atlas.GetGlyphRangesCyrillic() },
+        { "Japanese",    ranges_atlas.GetGlyphRangesJapanese() },
+        { "ChineseFull", ranges_atlas.GetGlyphRangesChinese() },
+    };
+    const int fonts_counts[] = { 1, 4, 16 };
+    const int repeat_count = 3;
+
+    printf("%-12s %6s %8s %12s %12s %8s\n", "ranges", "fonts", "glyphs", "serial (ms)", "threads (ms)", "speedup");
+    int failures = 0;
+    for (int ranges_i = 0; ranges_i < IM_ARRAYSIZE(ranges_list); ranges_i++)
+        for (int fonts_i = 0; fonts_i < IM_ARRAYSIZE(fonts_counts); fonts_i++)
+        {
+            ImFontAtlas serial_atlas, threads_atlas;
+            double serial_ms = 0.0, threads_ms = 0.0;
+            for (int repeat = 0; repeat < repeat_count; repeat++)
+            {
+                double ms = BuildAtlas(serial_atlas, argc, argv, fonts_counts[fonts_i], ranges_list[ranges_i].Ranges, 1);
+                serial_ms = (repeat == 0 || ms < serial_ms) ? ms : serial_ms;
+                ms = BuildAtlas(threads_atlas, argc, argv, fonts_counts[fonts_i], ranges_list[ranges_i].Ranges, 0);
+                threads_ms = (repeat == 0 || ms < threads_ms) ? ms : threads_ms;
+            }
+            int glyphs_count = 0;
+            for (int n = 0; n < serial_atlas.Fonts.Size; n++)
+                glyphs_count += serial_atlas.Fonts[n]->Glyphs.Size;
+            const bool same = SameAtlas(serial_atlas, threads_atlas);
+            printf("%-12s %6d %8d %12.2f %12.2f %7.2fx%s\n", ranges_list[ranges_i].Name, fonts_counts[fonts_i], glyphs_count, serial_ms, threads_ms, serial_ms / threads_ms, same ? "" : "  MISMATCH");
+            if (!same)
+                failures++;
+        }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,262 @@
+// Micro-benchmark: ImHash() on ID workloads (labels under an ID stack, "label###id" strings, window names, PushID(int) and pointer IDs), against the CRC32 it replaced.
+// Reports hashes per second and collisions. Fails if a workload has far more collisions than a random 32-bit hash would, or if the "###" and zero-terminated string semantics are broken.
+// Usage: bench_hash
+// Built by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <chrono>
+
+// Byte by byte CRC32, as it was before MurmurHash3
+static ImU32 RefImHash(const void* data, int data_size, ImU32 seed)
+{
+    static ImU32 crc32_lut[256] = { 0 };
+    if (!crc32_lut[1])
+    {
+        const ImU32 polynomial = 0xEDB88320;
+        for (ImU32 i = 0; i < 256; i++)
+        {
+            ImU32 crc = i;
+            for (ImU32 j = 0; j < 8; j++)
+                crc = (crc >> 1) ^ (ImU32(-int(crc & 1)) & polynomial);
+            crc32_lut[i] = crc;
+        }
+    }
+
+    seed = ~seed;
+    ImU32 crc = seed;
+    const unsigned char* current = (const unsigned char*)data;
+
+    if (data_size > 0)
+    {
+        while (data_size--)
+            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *current++];
+    }
+    else
+    {
+        while (unsigned char c = *current++)
+        {
+            if (c == '#' && current[0] == '#' && current[1] == '#')
+                crc = seed;
+            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
+        }
+    }
+    return ~crc;
+}
+
+enum BenchKeyType
+{
+    BenchKeyType_String,        // Zero-terminated, as GetID(const char*)
+    BenchKeyType_StringSized,   // As GetID(const char* str_begin, const char* str_end)
+    BenchKeyType_Pointer        // As GetID(const void*) and PushID(int)
+};
+
+struct BenchWorkload
+{
+    const char*         Name;
+    BenchKeyType        Type;
+    ImVector<char>      Text;           // Zero-separated strings
+    ImVector<int>       Offsets;
+    ImVector<void*>     Pointers;
+    ImVector<ImU32>     Seeds;          // Top of the ID stack for each key
+};
+
+static unsigned int g_Rand = 12345;
+static ImU32        g_Checksum = 0;     // Keeps the timed hashes alive
+static int RandInt(int n) { g_Rand = g_Rand * 1103515245 + 12345; return (int)((g_Rand >> 16) % (unsigned int)n); }
+
+static void AddString(BenchWorkload& workload, const char* s, ImU32 seed)
+{
+    const int len = (int)strlen(s) + 1;
+    workload.Offsets.push_back(workload.Text.Size);
+    workload.Text.resize(workload.Text.Size + len);
+    memcpy(workload.Text.Data + workload.Text.Size - len, s, (size_t)len);
+    workload.Seeds.push_back(seed);
+}
+
+// Unique widget labels, spread over the ID stacks of a few hundred windows and tree nodes
+static void BuildLabels(BenchWorkload& workload, int keys_count, bool triple_hash)
+{
+    static const char* words[] = { "Button", "Checkbox", "Color", "Edit", "Drag", "Slider", "Input", "Combo", "Tree", "Node", "Selected", "Value", "float", "int", "Open", "Save", "Settings", "Item" };
+    ImVector<ImU32> parent_ids;
+    for (int n = 0; n < 300; n++)
+        parent_ids.push_back(RefImHash(&n, sizeof(n), 0));
+    char buf[256];
+    for (int n = 0; n < keys_count; n++)
+    {
+        const char* word = words[RandInt(IM_ARRAYSIZE(words))];
+        switch (triple_hash ? 3 : RandInt(3))
+        {
+        case 0: sprintf(buf, "%s %d", word, n); break;
+        case 1: sprintf(buf, "##%s%d", word, n); break;
+        case 2: sprintf(buf, "%s##%d", word, n); break;
+        case 3: sprintf(buf, "%s %d###%s%d", word, RandInt(100), word, n); break;
+        }
+        AddString(workload, buf, parent_ids[RandInt(parent_ids.Size)]);
+    }
+}
+
+// Window names hashed from the root (seed 0), including child windows "Parent/Child_XXXXXXXX"
+static void BuildWindowNames(BenchWorkload& workload, int keys_count)
+{
+    static const char* names[] = { "Dear ImGui Demo", "Example: Console", "Example: Log", "Example: Property editor", "Debug##Default", "Metrics", "Inspector" };
+    char buf[256];
+    for (int n = 0; n < keys_count; n++)
+    {
+        if (n % 2)
+            sprintf(buf, "%s %d", names[RandInt(IM_ARRAYSIZE(names))], n);
+        else
+            sprintf(buf, "%s/Child_%08X", names[RandInt(IM_ARRAYSIZE(names))], RefImHash(&n, sizeof(n), 0));
+        AddString(workload, buf, 0);
+    }
+}
+
+// PushID(int) with loop indices, or pointers to consecutive heap objects, all under the same parent
+static void BuildPointers(BenchWorkload& workload, int keys_count, bool from_ints)
+{
+    const ImU32 seed = RefImHash("Table", 0, 0);
+    const uintptr_t heap_base = (uintptr_t)0x10000000;
+    for (int n = 0; n < keys_count; n++)
+    {
+        workload.Pointers.push_back(from_ints ? (void*)(intptr_t)n : (void*)(heap_base + (uintptr_t)n * 48));
+        workload.Seeds.push_back(seed);
+    }
+}
+
+static ImU32 HashKey(const BenchWorkload& workload, int n, bool reference)
+{
+    if (workload.Type == BenchKeyType_Pointer)
+    {
+        const void* ptr = workload.Pointers[n];
+        return reference ? RefImHash(&ptr, sizeof(void*), workload.Seeds[n]) : ImHash(&ptr, sizeof(void*), workload.Seeds[n]);
+    }
+    const char* str = workload.Text.Data + workload.Offsets[n];
+    const int str_size = (workload.Type == BenchKeyType_StringSized) ? (int)strlen(str) : 0;
+    return reference ? RefImHash(str, str_size, workload.Seeds[n]) : ImHash(str, str_size, workload.Seeds[n]);
+}
+
+// Time a frame's worth of keys hashed over and over (they stay in cache as in a real application), return the time per million hashes
+static double TimeWorkload(const BenchWorkload& workload, bool reference, int repeat_count)
+{
+    const int frame_keys_count = ImMin(workload.Seeds.Size, 4096);
+    const int frames_count = 64;
+    double best_ms = 0.0;
+    for (int repeat = 0; repeat < repeat_count; repeat++)
+    {
+        ImU32 checksum = 0;
+        std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < frames_count; frame++)
+            for (int n = 0; n < frame_keys_count; n++)
+                checksum += HashKey(workload, n, reference);
+        std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        best_ms = (repeat == 0 || ms < best_ms) ? ms : best_ms;
+        g_Checksum += checksum;
+    }
+    return best_ms * 1000000.0 / ((double)frame_keys_count * frames_count);
+}
+
+static void HashAllKeys(const BenchWorkload& workload, bool reference, ImVector<ImU32>& out_hashes)
+{
+    out_hashes.resize(workload.Seeds.Size);
+    for (int n = 0; n < workload.Seeds.Size; n++)
+        out_hashes[n] = HashKey(workload, n, reference);
+}
+
+static int CompareU32(const void* lhs, const void* rhs)
+{
+    const ImU32 a = *(const ImU32*)lhs, b = *(const ImU32*)rhs;
+    return (a < b) ? -1 : (a > b) ? 1 : 0;
+}
+
+// Number of keys sharing a hash with a previous key (all keys of a workload are distinct)
+static int CountCollisions(ImVector<ImU32>& hashes)
+{
+    qsort(hashes.Data, (size_t)hashes.Size, sizeof(ImU32), CompareU32);
+    int collisions = 0;
+    for (int n = 1; n < hashes.Size; n++)
+        if (hashes[n] == hashes[n - 1])
+            collisions++;
+    return collisions;
+}
+
+// "###" resets the hash to the seed, and a zero-terminated string hashes the same as its characters with an explicit size
+static int CheckStringSemantics()
+{
+    int failures = 0;
+    char label[64], id[64], buf[128];
+    for (int n = 0; n < 20000; n++)
+    {
+        const ImU32 seed = (ImU32)RandInt(0x7FFF) * 0x10001u;
+        sprintf(label, "%.*s", RandInt(12), "Label 0123456789ABCDEF");
+        sprintf(id, "###%.*s%d", RandInt(12), "id_0123456789ABCDEF", n);
+        sprintf(buf, "%s%s", label, id);
+        if (ImHash(buf, 0, seed) != ImHash(id, 0, seed))
+            failures++;
+        if (ImHash(id, 0, seed) != ImHash(id, (int)strlen(id), seed))
+            failures++;
+        if (label[0] && ImHash(label, 0, seed) != ImHash(label, (int)strlen(label), seed))
+            failures++;
+        sprintf(buf, "%s##%d", label, n);
+        sprintf(id, "X%s##%d", label, n);
+        if (ImHash(buf, 0, seed) == ImHash(id, 0, seed))    // "##" alone is part of the hash
+            failures++;
+        for (int offset = 1; offset < 4; offset++)          // Whole words are read from any alignment
+        {
+            strcpy(id + offset, buf);
+            if (ImHash(id + offset, 0, seed) != ImHash(buf, 0, seed))
+                failures++;
+        }
+    }
+    return failures;
+}
+
+int main(int, char**)
+{
+    const int keys_count = 250000;
+    BenchWorkload workloads[6];
+    workloads[0].Name = "Labels";       workloads[0].Type = BenchKeyType_String;      BuildLabels(workloads[0], keys_count, false);
+    workloads[1].Name = "LabelsSized";  workloads[1].Type = BenchKeyType_StringSized; BuildLabels(workloads[1], keys_count, false);
+    workloads[2].Name = "TripleHash";   workloads[2].Type = BenchKeyType_String;      BuildLabels(workloads[2], keys_count, true);
+    workloads[3].Name = "WindowNames";  workloads[3].Type = BenchKeyType_String;      BuildWindowNames(workloads[3], keys_count);
+    workloads[4].Name = "PushIDInt";    workloads[4].Type = BenchKeyType_Pointer;     BuildPointers(workloads[4], keys_count, true);
+    workloads[5].Name = "Pointers";     workloads[5].Type = BenchKeyType_Pointer;     BuildPointers(workloads[5], keys_count, false);
+    const int repeat_count = 5;
+
+    // Expected collisions for a random 32-bit hash of k distinct keys: k*(k-1)/2^33
+    const double expected_collisions = (double)keys_count * (double)(keys_count - 1) / 8589934592.0;
+    printf("%-12s %8s %12s %12s %8s %12s %12s\n", "workload", "keys", "crc32 Mh/s", "murmur Mh/s", "speedup", "crc32 coll.", "murmur coll.");
+    int failures = 0;
+    ImVector<ImU32> ref_hashes, hashes;
+    for (int workload_n = 0; workload_n < IM_ARRAYSIZE(workloads); workload_n++)
+    {
+        const BenchWorkload& workload = workloads[workload_n];
+        const double ref_ms = TimeWorkload(workload, true, repeat_count);
+        const double ms = TimeWorkload(workload, false, repeat_count);
+        HashAllKeys(workload, true, ref_hashes);
+        HashAllKeys(workload, false, hashes);
+        const int ref_collisions = CountCollisions(ref_hashes);
+        const int collisions = CountCollisions(hashes);
+        printf("%-12s %8d %12.1f %12.1f %7.2fx %12d %12d", workload.Name, workload.Seeds.Size, 1000.0 / ref_ms, 1000.0 / ms, ref_ms / ms, ref_collisions, collisions);
+        if (collisions > (int)(expected_collisions * 4.0) + 8)
+        {
+            printf("  TOO MANY COLLISIONS (expected ~%.1f)", expected_collisions);
+            failures++;
+        }
+        printf("\n");
+    }
+
+    const int semantics_failures = CheckStringSemantics();
+    if (semantics_failures > 0)
+    {
+        printf("\"###\" or zero-terminated string semantics broken (%d)\n", semantics_failures);
+        failures++;
+    }
+    printf("(checksum %08X)\n", g_Checksum);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+// Startup benchmark: LoadIniSettingsFromMemory() on generated .ini files with 1K, 20K and 100K window entries (with "###" names, unknown sections and CRLF line endings), against the parser it replaced.
+// Fails if the window settings differ from the ones the previous parser reads.
+// Usage: bench_ini_load
+// Built by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+struct RefWindowSettings
+{
+    char*       Name;
+    ImGuiID     Id;
+    ImVec2      Pos;
+    ImVec2      Size;
+    bool        Collapsed;
+};
+
+// Copy of the buffer with zero terminators written in it, sscanf() on each line and a linear search of the window settings, as it was before the single pass parser
+static void RefLoadIniSettingsFromMemory(const char* buf_readonly, ImVector<RefWindowSettings>& settings_windows)
+{
+    char* buf = ImStrdup(buf_readonly);
+    char* buf_end = buf + strlen(buf);
+    RefWindowSettings* entry_data = NULL;
+
+    char* line_end = NULL;
+    for (char* line = buf; line < buf_end; line = line_end + 1)
+    {
+        while (*line == '\n' || *line == '\r')
+            line++;
+        line_end = line;
+        while (line_end < buf_end && *line_end != '\n' && *line_end != '\r')
+            line_end++;
+        line_end[0] = 0;
+
+        if (line[0] == '[' && line_end > line && line_end[-1] == ']')
+        {
+            line_end[-1] = 0;
+            const char* name_end = line_end - 1;
+            const char* type_start = line + 1;
+            char* type_end = ImStrchrRange(type_start, name_end, ']');
+            const char* name_start = type_end ? ImStrchrRange(type_end + 1, name_end, '[') : NULL;
+            if (!type_end || !name_start)
+            {
+                name_start = type_start;
+                type_start = "Window";
+            }
+            else
+            {
+                *type_end = 0;
+                name_start++;
+            }
+            entry_data = NULL;
+            if (ImGui::FindSettingsHandler(type_start) == ImGui::FindSettingsHandler("Window"))
+            {
+                const ImGuiID id = ImHash(name_start, 0);
+                for (int i = 0; i != settings_windows.Size && !entry_data; i++)
+                    if (settings_windows[i].Id == id)
+                        entry_data = &settings_windows[i];
+                if (!entry_data)
+                {
+                    RefWindowSettings settings;
+                    settings.Name = ImStrdup(name_start);
+                    settings.Id = id;
+                    settings.Pos = settings.Size = ImVec2(0, 0);
+                    settings.Collapsed = false;
+                    settings_windows.push_back(settings);
+                    entry_data = &settings_windows.back();
+                }
+            }
+        }
+        else if (entry_data != NULL)
+        {
+            float x, y;
+            int i;
+            if (sscanf(line, "Pos=%f,%f", &x, &y) == 2)         entry_data->Pos = ImVec2(x, y);
+            else if (sscanf(line, "Size=%f,%f", &x, &y) == 2)   entry_data->Size = ImMax(ImVec2(x, y), GImGui->Style.WindowMinSize);
+            else if (sscanf(line, "Collapsed=%d", &i) == 1)     entry_data->Collapsed = (i != 0);
+        }
+    }
+    ImGui::MemFree(buf);
+}
+
+static unsigned int g_Rand = 12345;
+static int RandInt(int n) { g_Rand = g_Rand * 1103515245 + 12345; return (int)((g_Rand >> 16) % (unsigned int)n); }
+
+// A layout of a large tool: top-level windows, child windows, "###" names, sections of types without handler and a few legacy sections without type
+static void BuildIniFile(ImGuiTextBuffer& buf, int windows_count, bool crlf)
+{
+    const char* eol = crlf ? "\r\n" : "\n";
+    buf.clear();
+    for (int n = 0; n < windows_count; n++)
+    {
+        switch (RandInt(4))
+        {
+        case 0: buf.appendf("[Window][Inspector %d]%s", n, eol); break;
+        case 1: buf.appendf("[Window][Viewport %d###Viewport%d]%s", RandInt(100), n, eol); break;
+        case 2: buf.appendf("[Window][Scene/Child_%08X]%s", ImHash(&n, sizeof(n), 0), eol); break;
+        case 3: buf.appendf("[Log %d]%s", n, eol); break;
+        }
+        buf.appendf("Pos=%d,%d%sSize=%d,%d%sCollapsed=%d%s", RandInt(4000) - 200, RandInt(3000) - 200, eol, RandInt(1000), RandInt(1000), eol, RandInt(2), eol);
+        if (RandInt(8) == 0)
+            buf.appendf("[Table][0x%08X,%d]%sColumn 0 Width=%d%sColumn 1 Width=%d%s", ImHash(&n, sizeof(n), 1), 2, eol, RandInt(300), eol, RandInt(300), eol);
+        buf.appendf("%s", eol);
+    }
+}
+
+static int CompareSettings(const ImVector<ImGuiWindowSettings>& settings_windows, const ImVector<RefWindowSettings>& ref_settings_windows)
+{
+    if (settings_windows.Size != ref_settings_windows.Size)
+        return 1;
+    int mismatches = 0;
+    for (int n = 0; n < settings_windows.Size; n++)
+    {
+        const ImGuiWindowSettings& a = settings_windows[n];
+        const RefWindowSettings& b = ref_settings_windows[n];
+        if (strcmp(a.Name, b.Name) != 0 || a.Id != b.Id || a.Pos.x != b.Pos.x || a.Pos.y != b.Pos.y || a.Size.x != b.Size.x || a.Size.y != b.Size.y || a.Collapsed != b.Collapsed)
+            mismatches++;
+    }
+    return mismatches;
+}
+
+int main(int, char**)
+{
+    const int sizes[] = { 1000, 20000, 100000 };
+    const int ref_windows_max = 20000;  // The linear search makes the previous parser O(N^2): 100K entries take a long time
+    const int repeat_count = 3;
+    int failures = 0;
+
+    ImGui::CreateContext();
+    ImGui::GetIO().IniFilename = NULL;
+    printf("%-8s %-5s %10s %12s %12s %8s\n", "windows", "eol", "bytes", "before (ms)", "after (ms)", "speedup");
+    ImGuiTextBuffer ini;
+    for (int size_n = 0; size_n < IM_ARRAYSIZE(sizes); size_n++)
+        for (int crlf = 0; crlf < 2; crlf++)
+        {
+            const int windows_count = sizes[size_n];
+            BuildIniFile(ini, windows_count, crlf != 0);
+            const bool run_ref = (windows_count <= ref_windows_max);
+
+            double ref_ms = 0.0, ms = 0.0;
+            ImVector<RefWindowSettings> ref_settings_windows;
+            for (int repeat = 0; repeat < repeat_count; repeat++)
+            {
+                for (int n = 0; n < ref_settings_windows.Size; n++)
+                    ImGui::MemFree(ref_settings_windows[n].Name);
+                ref_settings_windows.resize(0);
+                if (run_ref)
+                {
+                    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+                    RefLoadIniSettingsFromMemory(ini.c_str(), ref_settings_windows);
+                    const double repeat_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+                    ref_ms = (repeat == 0 || repeat_ms < ref_ms) ? repeat_ms : ref_ms;
+                }
+
+                // Each load starts from an empty context, as at startup
+                ImGui::DestroyContext();
+                ImGui::CreateContext();
+                ImGui::GetIO().IniFilename = NULL;
+                std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+                ImGui::LoadIniSettingsFromMemory(ini.begin(), ini.end());
+                const double repeat_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+                ms = (repeat == 0 || repeat_ms < ms) ? repeat_ms : ms;
+            }
+
+            if (run_ref)
+                printf("%-8d %-5s %10d %12.2f %12.2f %7.2fx", windows_count, crlf ? "crlf" : "lf", ini.size(), ref_ms, ms, ref_ms / ms);
+            else
+                printf("%-8d %-5s %10d %12s %12.2f %8s", windows_count, crlf ? "crlf" : "lf", ini.size(), "(skipped)", ms, "");
+            if (run_ref)
+            {
+                const int mismatches = CompareSettings(GImGui->SettingsWindows, ref_settings_windows);
+                if (mismatches > 0)
+                {
+                    printf("  MISMATCH (%d)", mismatches);
+                    failures++;
+                }
+            }
+            printf("\n");
+            for (int n = 0; n < ref_settings_windows.Size; n++)
+                ImGui::MemFree(ref_settings_windows[n].Name);
+        }
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,334 @@
+// Throughput benchmark: ImFont::RenderText() in glyphs per second, on a long log view (as in ShowExampleAppLongText()), labels, wrapped paragraphs and fine clipped labels.
+// Compared to the glyph by glyph code it replaced. Fails if the vertices, indices or draw commands differ.
+// Usage: bench_render_text
+// Built by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+// Glyph by glyph code reserving 4 vertices and 6 indices per remaining byte of text, as it was before the batched emission
+static void RefRenderText(const ImFont* font, ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip)
+{
+    pos.x = (float)(int)pos.x + font->DisplayOffset.x;
+    pos.y = (float)(int)pos.y + font->DisplayOffset.y;
+    float x = pos.x;
+    float y = pos.y;
+    if (y > clip_rect.w)
+        return;
+
+    const float scale = size / font->FontSize;
+    const float line_height = font->FontSize * scale;
+    const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const char* word_wrap_eol = NULL;
+
+    const char* s = text_begin;
+    if (!word_wrap_enabled && y + line_height < clip_rect.y)
+        while (s < text_end && *s != '\n')
+            s++;
+
+    const int vtx_count_max = (int)(text_end - s) * 4;
+    const int idx_count_max = (int)(text_end - s) * 6;
+    const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
+    draw_list->PrimReserve(idx_count_max, vtx_count_max);
+
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+
+    while (s < text_end)
+    {
+        if (word_wrap_enabled)
+        {
+            if (!word_wrap_eol)
+            {
+                word_wrap_eol = font->CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - pos.x));
+                if (word_wrap_eol == s)
+                    word_wrap_eol++;
+            }
+            if (s >= word_wrap_eol)
+            {
+                x = pos.x;
+                y += line_height;
+                word_wrap_eol = NULL;
+                while (s < text_end)
+                {
+                    const char c = *s;
+                    if (ImCharIsSpace(c)) { s++; } else if (c == '\n') { s++; break; } else { break; }
+                }
+                continue;
+            }
+        }
+
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+        {
+            s += 1;
+        }
+        else
+        {
+            s += ImTextCharFromUtf8(&c, s, text_end);
+            if (c == 0)
+                break;
+        }
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                x = pos.x;
+                y += line_height;
+                if (y > clip_rect.w)
+                    break;
+                if (!word_wrap_enabled && y + line_height < clip_rect.y)
+                    while (s < text_end && *s != '\n')
+                        s++;
+                continue;
+            }
+            if (c == '\r')
+                continue;
+        }
+
+        float char_width = 0.0f;
+        if (const ImFontGlyph* glyph = font->FindGlyph((ImWchar)c))
+        {
+            char_width = glyph->AdvanceX * scale;
+            if (c != ' ' && c != '\t')
+            {
+                float x1 = x + glyph->X0 * scale;
+                float x2 = x + glyph->X1 * scale;
+                float y1 = y + glyph->Y0 * scale;
+                float y2 = y + glyph->Y1 * scale;
+                if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+                {
+                    float u1 = glyph->U0;
+                    float v1 = glyph->V0;
+                    float u2 = glyph->U1;
+                    float v2 = glyph->V1;
+                    if (cpu_fine_clip)
+                    {
+                        if (x1 < clip_rect.x)
+                        {
+                            u1 = u1 + (1.0f - (x2 - clip_rect.x) / (x2 - x1)) * (u2 - u1);
+                            x1 = clip_rect.x;
+                        }
+                        if (y1 < clip_rect.y)
+                        {
+                            v1 = v1 + (1.0f - (y2 - clip_rect.y) / (y2 - y1)) * (v2 - v1);
+                            y1 = clip_rect.y;
+                        }
+                        if (x2 > clip_rect.z)
+                        {
+                            u2 = u1 + ((clip_rect.z - x1) / (x2 - x1)) * (u2 - u1);
+                            x2 = clip_rect.z;
+                        }
+                        if (y2 > clip_rect.w)
+                        {
+                            v2 = v1 + ((clip_rect.w - y1) / (y2 - y1)) * (v2 - v1);
+                            y2 = clip_rect.w;
+                        }
+                        if (y1 >= y2)
+                        {
+                            x += char_width;
+                            continue;
+                        }
+                    }
+                    idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+                    idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+                    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+                    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+                    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+                    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                    vtx_write += 4;
+                    vtx_current_idx += 4;
+                    idx_write += 6;
+                }
+            }
+        }
+        x += char_width;
+    }
+
+    draw_list->VtxBuffer.resize((int)(vtx_write - draw_list->VtxBuffer.Data));
+    draw_list->IdxBuffer.resize((int)(idx_write - draw_list->IdxBuffer.Data));
+    draw_list->CmdBuffer[draw_list->CmdBuffer.Size-1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = (unsigned int)draw_list->VtxBuffer.Size;
+}
+
+struct BenchItem
+{
+    ImVec2              Pos;
+    int                 TextBegin, TextEnd;
+};
+
+struct BenchWorkload
+{
+    const char*         Name;
+    ImVector<char>      Text;
+    ImVector<BenchItem> Items;
+    float               WrapWidth;
+    bool                FineClip;
+};
+
+static const ImVec4 g_ViewClipRect(0.0f, 0.0f, 1280.0f, 800.0f);
+
+static unsigned int g_Rand = 12345;
+static int RandInt(int n) { g_Rand = g_Rand * 1103515245 + 12345; return (int)((g_Rand >> 16) % (unsigned int)n); }
+
+static void AppendText(ImVector<char>& buf, const char* s)
+{
+    const int len = (int)strlen(s);
+    buf.resize(buf.Size + len);
+    memcpy(buf.Data + buf.Size - len, s, (size_t)len);
+}
+
+static void AddItem(BenchWorkload& workload, ImVec2 pos, const char* text)
+{
+    BenchItem item;
+    item.Pos = pos;
+    item.TextBegin = workload.Text.Size;
+    AppendText(workload.Text, text);
+    item.TextEnd = workload.Text.Size;
+    workload.Items.push_back(item);
+}
+
+static void RenderWorkload(const ImFont* font, ImDrawList* draw_list, const BenchWorkload& workload, bool reference)
+{
+    draw_list->Clear();
+    draw_list->PushClipRect(ImVec2(g_ViewClipRect.x, g_ViewClipRect.y), ImVec2(g_ViewClipRect.z, g_ViewClipRect.w));
+    draw_list->PushTextureID(font->ContainerAtlas->TexID);
+    const ImU32 col = IM_COL32(255, 255, 255, 255);
+    for (int n = 0; n < workload.Items.Size; n++)
+    {
+        const BenchItem& item = workload.Items[n];
+        const char* text_begin = workload.Text.Data + item.TextBegin;
+        const char* text_end = workload.Text.Data + item.TextEnd;
+        const ImVec4 fine_clip_rect(item.Pos.x, item.Pos.y, item.Pos.x + 60.0f, item.Pos.y + font->FontSize);
+        if (reference)
+            RefRenderText(font, draw_list, font->FontSize, item.Pos, col, workload.FineClip ? fine_clip_rect : g_ViewClipRect, text_begin, text_end, workload.WrapWidth, workload.FineClip);
+        else
+            draw_list->AddText(font, font->FontSize, item.Pos, col, text_begin, text_end, workload.WrapWidth, workload.FineClip ? &fine_clip_rect : NULL);
+    }
+}
+
+static double TimeWorkload(const ImFont* font, ImDrawList* draw_list, const BenchWorkload& workload, bool reference, int repeat_count)
+{
+    double best_ms = 0.0;
+    for (int repeat = 0; repeat < repeat_count; repeat++)
+    {
+        std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        RenderWorkload(font, draw_list, workload, reference);
+        std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        best_ms = (repeat == 0 || ms < best_ms) ? ms : best_ms;
+    }
+    return best_ms;
+}
+
+static bool SameDrawList(const ImDrawList& a, const ImDrawList& b)
+{
+    if (a.VtxBuffer.Size != b.VtxBuffer.Size || a.IdxBuffer.Size != b.IdxBuffer.Size || a.CmdBuffer.Size != b.CmdBuffer.Size)
+        return false;
+    if (memcmp(a.VtxBuffer.Data, b.VtxBuffer.Data, (size_t)a.VtxBuffer.Size * sizeof(ImDrawVert)) != 0 || memcmp(a.IdxBuffer.Data, b.IdxBuffer.Data, (size_t)a.IdxBuffer.Size * sizeof(ImDrawIdx)) != 0)
+        return false;
+    for (int n = 0; n < a.CmdBuffer.Size; n++)
+        if (a.CmdBuffer[n].ElemCount != b.CmdBuffer[n].ElemCount || a.CmdBuffer[n].TextureId != b.CmdBuffer[n].TextureId)
+            return false;
+    return true;
+}
+
+int main(int, char**)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(g_ViewClipRect.z, g_ViewClipRect.w);
+    io.IniFilename = NULL;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    const ImFont* font = io.Fonts->Fonts[0];
+    ImGui::NewFrame();
+
+    static const char* words[] = { "Window", "options", "Show", "Hide", "Enable", "Color", "Edit", "File", "Open", "Save", "Settings", "Widgets", "Layout", "Columns", "Tree", "Node", "Value", "Drag", "Slider", "Input", "the", "of", "a", "to" };
+    char buf[256];
+    BenchWorkload workloads[4];
+
+    // Log of 20000 lines scrolled to the middle, rendered with a single call as ShowExampleAppLongText() does without a clipper
+    workloads[0].Name = "LongText";
+    ImVector<char> log;
+    for (int n = 0; n < 20000; n++)
+    {
+        sprintf(buf, "%i The quick brown fox jumps over the lazy dog\n", n);
+        AppendText(log, buf);
+    }
+    log.push_back(0);
+    AddItem(workloads[0], ImVec2(8.0f, -10000.0f * font->FontSize), log.Data);
+
+    // Labels laid out in a grid filling the view
+    workloads[1].Name = "Labels";
+    workloads[3].Name = "FineClip";
+    workloads[3].FineClip = true;
+    for (float y = 0.0f; y + font->FontSize < g_ViewClipRect.w; y += font->FontSize + 4.0f)
+        for (float x = 0.0f; x + 160.0f < g_ViewClipRect.z; x += 160.0f)
+        {
+            int len = 0;
+            const int words_count = 1 + RandInt(3);
+            for (int word_n = 0; word_n < words_count; word_n++)
+                len += sprintf(buf + len, word_n > 0 ? " %s" : "%s", words[RandInt(IM_ARRAYSIZE(words))]);
+            if (RandInt(3) == 0)
+                sprintf(buf + len, ": %d", RandInt(10000));
+            AddItem(workloads[1], ImVec2(x, y), buf);
+            AddItem(workloads[3], ImVec2(x, y), buf);
+        }
+
+    // Paragraphs wrapped at 400 pixels, as TextWrapped()
+    workloads[2].Name = "Wrapped";
+    workloads[2].WrapWidth = 400.0f;
+    for (int paragraph_n = 0; paragraph_n < 3; paragraph_n++)
+    {
+        ImVector<char> paragraph;
+        for (int word_n = 0; word_n < 400; word_n++)
+        {
+            AppendText(paragraph, words[RandInt(IM_ARRAYSIZE(words))]);
+            AppendText(paragraph, RandInt(10) == 0 ? ". " : " ");
+        }
+        paragraph.push_back(0);
+        AddItem(workloads[2], ImVec2(8.0f + 420.0f * (float)paragraph_n, 0.0f), paragraph.Data);
+    }
+
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    ImDrawList ref_draw_list(ImGui::GetDrawListSharedData());
+    const int repeat_count = 20;
+    printf("%-10s %8s %14s %14s %8s %12s %12s\n", "workload", "glyphs", "ref Mglyphs/s", "new Mglyphs/s", "speedup", "ref vtx cap", "new vtx cap");
+    int failures = 0;
+    for (int workload_n = 0; workload_n < IM_ARRAYSIZE(workloads); workload_n++)
+    {
+        const BenchWorkload& workload = workloads[workload_n];
+        const double ref_ms = TimeWorkload(font, &ref_draw_list, workload, true, repeat_count);
+        const double ms = TimeWorkload(font, &draw_list, workload, false, repeat_count);
+
+        // Capacity reserved by a single pass, from cleared buffers
+        ImDrawList ref_single(ImGui::GetDrawListSharedData()), single(ImGui::GetDrawListSharedData());
+        RenderWorkload(font, &ref_single, workload, true);
+        RenderWorkload(font, &single, workload, false);
+        const bool same = SameDrawList(draw_list, ref_draw_list);
+
+        const int glyphs_count = draw_list.IdxBuffer.Size / 6;
+        printf("%-10s %8d %14.1f %14.1f %7.2fx %12d %12d%s\n", workload.Name, glyphs_count, glyphs_count / (ref_ms * 1000.0), glyphs_count / (ms * 1000.0), ref_ms / ms,
+            ref_single.VtxBuffer.Capacity, single.VtxBuffer.Capacity, same ? "" : "  MISMATCH");
+        if (!same)
+            failures++;
+        ref_single.ClearFreeMemory();
+        single.ClearFreeMemory();
+    }
+    draw_list.ClearFreeMemory();
+    ref_draw_list.ClearFreeMemory();
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}
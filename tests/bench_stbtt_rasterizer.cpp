@@ -0,0 +1,115 @@
+// Glyph-by-glyph comparison of the STBTT_SSE2 rasterizer (used by the atlas builder when IMGUI_ENABLE_SSE is defined) against the scalar one, at several sizes and oversampling factors.
+// Fails if a pixel differs by more than 1 or a glyph box differs, also reports the time spent rasterizing with both builds.
+// Usage: bench_stbtt_rasterizer [font.ttf ...]   (the default ProggyClean font is used when no font is given)
+// Built with tests/bench_stbtt_rasterizer_scalar.cpp by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"     // IMGUI_ENABLE_SSE, ImFileLoadToMemory()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef IMGUI_ENABLE_SSE
+#define STBTT_SSE2
+#endif
+#include "bench_stbtt_rasterizer.h"
+
+double RasterizeGlyphsSse2(const unsigned char* font_data, float pixel_height, int oversample_h, int oversample_v, GlyphBitmaps& out_bitmaps)
+{
+    return RasterizeGlyphs(font_data, pixel_height, oversample_h, oversample_v, out_bitmaps);
+}
+
+static int CompareFont(const char* name, const unsigned char* font_data)
+{
+    const float pixel_sizes[] = { 10.0f, 13.0f, 16.0f, 24.0f, 48.0f };
+    const int oversamples[][2] = { { 1, 1 }, { 2, 1 }, { 3, 1 }, { 2, 2 }, { 4, 4 }, { 8, 8 } };
+    const int repeat_count = 3;
+
+    int failures = 0;
+    GlyphBitmaps scalar_bitmaps, sse2_bitmaps;
+    for (int size_n = 0; size_n < IM_ARRAYSIZE(pixel_sizes); size_n++)
+        for (int oversample_n = 0; oversample_n < IM_ARRAYSIZE(oversamples); oversample_n++)
+        {
+            const int oversample_h = oversamples[oversample_n][0], oversample_v = oversamples[oversample_n][1];
+            double scalar_ms = 0.0, sse2_ms = 0.0;
+            for (int repeat = 0; repeat < repeat_count; repeat++)
+            {
+                const double ms = RasterizeGlyphsScalar(font_data, pixel_sizes[size_n], oversample_h, oversample_v, scalar_bitmaps);
+                scalar_ms = (repeat == 0 || ms < scalar_ms) ? ms : scalar_ms;
+            }
+            for (int repeat = 0; repeat < repeat_count; repeat++)
+            {
+                const double ms = RasterizeGlyphsSse2(font_data, pixel_sizes[size_n], oversample_h, oversample_v, sse2_bitmaps);
+                sse2_ms = (repeat == 0 || ms < sse2_ms) ? ms : sse2_ms;
+            }
+            if (scalar_ms < 0.0 || sse2_ms < 0.0)
+            {
+                printf("%s: can't parse font\n", name);
+                return 1;
+            }
+
+            int exact_count = 0, off_by_one_count = 0, wrong_count = 0;
+            const int glyphs_count = scalar_bitmaps.Glyphs.Size;
+            for (int glyph_index = 0; glyph_index < glyphs_count; glyph_index++)
+            {
+                const GlyphBitmap& a = scalar_bitmaps.Glyphs[glyph_index];
+                const GlyphBitmap& b = sse2_bitmaps.Glyphs[glyph_index];
+                int max_diff = (a.Width != b.Width || a.Height != b.Height) ? 256 : 0;
+                for (int n = 0; n < a.Width * a.Height && max_diff <= 255; n++)
+                    max_diff = ImMax(max_diff, abs((int)scalar_bitmaps.Pixels[a.PixelsOffset + n] - (int)sse2_bitmaps.Pixels[b.PixelsOffset + n]));
+                if (max_diff == 0)
+                    exact_count++;
+                else if (max_diff <= 1)
+                    off_by_one_count++;
+                else
+                    wrong_count++;
+            }
+            char oversample_name[16];
+            sprintf(oversample_name, "%dx%d", oversample_h, oversample_v);
+            printf("%-24s %5.0f %6s %8d %8d %8d %8d %12.2f %12.2f %7.2fx", name, pixel_sizes[size_n], oversample_name, glyphs_count, exact_count, off_by_one_count, wrong_count, scalar_ms, sse2_ms, scalar_ms / sse2_ms);
+            if (wrong_count > 0)
+            {
+                printf("  MISMATCH");
+                failures++;
+            }
+            printf("\n");
+        }
+    return failures;
+}
+
+int main(int argc, char** argv)
+{
+#ifndef IMGUI_ENABLE_SSE
+    printf("IMGUI_ENABLE_SSE is not defined for this target, comparing the scalar rasterizer with itself.\n");
+#endif
+    printf("%-24s %5s %6s %8s %8s %8s %8s %12s %12s %8s\n", "font", "size", "over", "glyphs", "exact", "diff 1", "diff >1", "scalar (ms)", "sse2 (ms)", "speedup");
+    int failures = 0;
+    if (argc > 1)
+    {
+        for (int n = 1; n < argc; n++)
+        {
+            unsigned char* data = (unsigned char*)ImFileLoadToMemory(argv[n], "rb");
+            if (!data)
+            {
+                printf("%s: can't open\n", argv[n]);
+                failures++;
+                continue;
+            }
+            const char* name = argv[n];
+            for (const char* p = argv[n]; *p; p++)
+                if (*p == '/' || *p == '\\')
+                    name = p + 1;
+            failures += CompareFont(name, data);
+            ImGui::MemFree(data);
+        }
+    }
+    else
+    {
+        // Building the atlas leaves the decompressed default font in ConfigData
+        ImFontAtlas atlas;
+        atlas.AddFontDefault();
+        atlas.Build();
+        failures += CompareFont("ProggyClean.ttf", (const unsigned char*)atlas.ConfigData[0].FontData);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+// Shared by bench_stbtt_rasterizer.cpp (STBTT_SSE2 build) and bench_stbtt_rasterizer_scalar.cpp (scalar build).
+// stb_truetype declares its functions with C linkage, so the two builds of the rasterizer can't live in the same file.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <string.h>
+#include <chrono>
+
+#ifdef _MSC_VER
+#pragma warning (disable: 4505) // unreferenced local function has been removed (stb stuff)
+#pragma warning (disable: 4456) // declaration of 'xx' hides previous local declaration
+#endif
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#endif
+
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "stb_truetype.h"
+
+struct GlyphBitmap
+{
+    int                     Width, Height;
+    int                     PixelsOffset;
+};
+
+struct GlyphBitmaps
+{
+    ImVector<GlyphBitmap>   Glyphs;
+    ImVector<unsigned char> Pixels;             // All glyphs, one after the other
+};
+
+// Rasterize every glyph of the font the way the atlas builder does (oversampled box, prefilter), return the time spent in the rasterizer or -1.0 if the font can't be parsed
+double  RasterizeGlyphsScalar(const unsigned char* font_data, float pixel_height, int oversample_h, int oversample_v, GlyphBitmaps& out_bitmaps);
+double  RasterizeGlyphsSse2(const unsigned char* font_data, float pixel_height, int oversample_h, int oversample_v, GlyphBitmaps& out_bitmaps);
+
+static double RasterizeGlyphs(const unsigned char* font_data, float pixel_height, int oversample_h, int oversample_v, GlyphBitmaps& out_bitmaps)
+{
+    stbtt_fontinfo info;
+    if (!stbtt_InitFont(&info, font_data, stbtt_GetFontOffsetForIndex(font_data, 0)))
+        return -1.0;
+    const float scale = stbtt_ScaleForPixelHeight(&info, pixel_height);
+    out_bitmaps.Glyphs.resize(info.numGlyphs);
+    out_bitmaps.Pixels.resize(0);
+    double total_ms = 0.0;
+    for (int glyph_index = 0; glyph_index < info.numGlyphs; glyph_index++)
+    {
+        GlyphBitmap& bitmap = out_bitmaps.Glyphs[glyph_index];
+        int x0, y0, x1, y1;
+        stbtt_GetGlyphBitmapBoxSubpixel(&info, glyph_index, scale * oversample_h, scale * oversample_v, 0.0f, 0.0f, &x0, &y0, &x1, &y1);
+        bitmap.Width = (x1 - x0) + oversample_h - 1;
+        bitmap.Height = (y1 - y0) + oversample_v - 1;
+        bitmap.PixelsOffset = out_bitmaps.Pixels.Size;
+        if (x1 <= x0 || y1 <= y0)
+        {
+            bitmap.Width = bitmap.Height = 0;
+            continue;
+        }
+        out_bitmaps.Pixels.resize(bitmap.PixelsOffset + bitmap.Width * bitmap.Height);
+        unsigned char* pixels = out_bitmaps.Pixels.Data + bitmap.PixelsOffset;
+        memset(pixels, 0, (size_t)(bitmap.Width * bitmap.Height));
+        float sub_x, sub_y;
+        std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        stbtt_MakeGlyphBitmapSubpixelPrefilter(&info, pixels, bitmap.Width, bitmap.Height, bitmap.Width, scale * oversample_h, scale * oversample_v, 0.0f, 0.0f, oversample_h, oversample_v, &sub_x, &sub_y, glyph_index);
+        std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+        total_ms += std::chrono::duration<double, std::milli>(t1 - t0).count();
+    }
+    return total_ms;
+}
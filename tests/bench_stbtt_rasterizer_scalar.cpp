@@ -0,0 +1,8 @@
+// Scalar build of the stb_truetype rasterizer, linked into bench_stbtt_rasterizer.
+
+#include "bench_stbtt_rasterizer.h"
+
+double RasterizeGlyphsScalar(const unsigned char* font_data, float pixel_height, int oversample_h, int oversample_v, GlyphBitmaps& out_bitmaps)
+{
+    return RasterizeGlyphs(font_data, pixel_height, oversample_h, oversample_v, out_bitmaps);
+}
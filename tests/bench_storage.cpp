@@ -0,0 +1,234 @@
+// Benchmark: ImGuiStorage inserts, lookups and missed lookups with 1K, 100K and 1M keys, and a mixed per-frame workload, against the sorted vector with binary search it replaced.
+// Fails if a value differs from the sorted vector, or if a read-only Get***() modifies the storage.
+// Usage: bench_storage
+// Built by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+// Pairs sorted by key with a binary search, inserting in the middle of the vector, as it was before the hash table
+struct RefStorage
+{
+    ImVector<ImGuiStorage::Pair> Data;
+
+    ImGuiStorage::Pair* LowerBound(ImGuiID key)
+    {
+        ImGuiStorage::Pair* first = Data.begin();
+        size_t count = (size_t)Data.Size;
+        while (count > 0)
+        {
+            size_t count2 = count >> 1;
+            ImGuiStorage::Pair* mid = first + count2;
+            if (mid->key < key)
+            {
+                first = ++mid;
+                count -= count2 + 1;
+            }
+            else
+            {
+                count = count2;
+            }
+        }
+        return first;
+    }
+    int GetInt(ImGuiID key, int default_val)
+    {
+        ImGuiStorage::Pair* it = LowerBound(key);
+        return (it == Data.end() || it->key != key) ? default_val : it->val_i;
+    }
+    void SetInt(ImGuiID key, int val)
+    {
+        ImGuiStorage::Pair* it = LowerBound(key);
+        if (it == Data.end() || it->key != key)
+        {
+            Data.insert(it, ImGuiStorage::Pair(key, val));
+            return;
+        }
+        it->val_i = val;
+    }
+    void** GetVoidPtrRef(ImGuiID key, void* default_val = NULL)
+    {
+        ImGuiStorage::Pair* it = LowerBound(key);
+        if (it == Data.end() || it->key != key)
+            it = Data.insert(it, ImGuiStorage::Pair(key, default_val));
+        return &it->val_p;
+    }
+    static int PairCompareByID(const void* lhs, const void* rhs)
+    {
+        if (((const ImGuiStorage::Pair*)lhs)->key > ((const ImGuiStorage::Pair*)rhs)->key) return +1;
+        if (((const ImGuiStorage::Pair*)lhs)->key < ((const ImGuiStorage::Pair*)rhs)->key) return -1;
+        return 0;
+    }
+};
+
+typedef std::chrono::high_resolution_clock BenchClock;
+static double MsSince(BenchClock::time_point t0) { return std::chrono::duration<double, std::milli>(BenchClock::now() - t0).count(); }
+
+// Widget IDs as produced by GetID(): hashed, in no particular order, all distinct (ImHash() of 4 bytes is a bijection). Missed keys use another seed.
+static void BuildKeys(ImVector<ImGuiID>& keys, int keys_count, ImU32 seed)
+{
+    keys.resize(keys_count);
+    for (int n = 0; n < keys_count; n++)
+        keys[n] = ImHash(&n, sizeof(n), seed);
+}
+
+// Frames of an application: persistent widgets read their state every frame (tree nodes, columns), some write it back or keep a pointer in it,
+// and transient IDs (rows scrolled into view, popups, tooltips) are added in between and never seen again. Returns the sum of the values read.
+template<typename STORAGE>
+static int RunMixedFrames(STORAGE& storage, const ImVector<ImGuiID>& persistent_keys, const ImVector<ImGuiID>& transient_keys, int frames_count)
+{
+    const int transient_per_frame = transient_keys.Size / frames_count;
+    const int transient_every = persistent_keys.Size / transient_per_frame;
+    int sum = 0;
+    for (int frame = 0; frame < frames_count; frame++)
+        for (int n = 0; n < persistent_keys.Size; n++)
+        {
+            const ImGuiID key = persistent_keys[n];
+            switch (n & 3)
+            {
+            case 0: case 1: sum += storage.GetInt(key, n); break;
+            case 2: if ((frame + n) % 16 == 0) storage.SetInt(key, frame); else sum += storage.GetInt(key, -1); break;
+            case 3: { void** p = storage.GetVoidPtrRef(key); if (*p == NULL) *p = (void*)(intptr_t)n; sum += (int)(intptr_t)*p; } break;
+            }
+            if (n % transient_every == 0 && n / transient_every < transient_per_frame)
+            {
+                const int transient_n = frame * transient_per_frame + n / transient_every;
+                if (transient_n & 1)
+                    storage.SetInt(transient_keys[transient_n], transient_n);
+                else
+                    sum += (int)(intptr_t)*storage.GetVoidPtrRef(transient_keys[transient_n], (void*)(intptr_t)transient_n);
+            }
+        }
+    return sum;
+}
+
+// A read-only query must not touch Index, even when Data was filled directly and Index is stale
+static int CheckConstQueries()
+{
+    int failures = 0;
+    ImGuiStorage storage;
+    for (int n = 0; n < 1000; n++)
+        storage.Data.push_back(ImGuiStorage::Pair(ImHash(&n, sizeof(n), 0), n));
+    const ImGuiStorage& const_storage = storage;
+    for (int n = 0; n < 1000; n++)
+        if (const_storage.GetInt(ImHash(&n, sizeof(n), 0), -1) != n || const_storage.GetInt(ImHash(&n, sizeof(n), 1), -1) != -1)
+            failures++;
+    if (storage.Index.Size != 0 || storage.IndexedCount != 0)
+        failures++;
+    storage.BuildSortByKey();
+    for (int n = 0; n < 1000; n++)
+        if (const_storage.GetInt(ImHash(&n, sizeof(n), 0), -1) != n)
+            failures++;
+    storage.SetInt(ImHash("new", 0, 0), 1234);
+    if (storage.GetInt(ImHash("new", 0, 0)) != 1234 || storage.IndexedCount != storage.Data.Size)
+        failures++;
+    return failures;
+}
+
+int main(int, char**)
+{
+    const int sizes[] = { 1000, 100000, 1000000 };
+    const int ref_insert_max = 100000;  // Inserting in the middle of a sorted vector is O(N^2): 1M inserts take minutes
+    int failures = 0;
+
+    printf("%-8s %-10s %14s %14s %8s\n", "keys", "operation", "sorted (ms)", "hashed (ms)", "speedup");
+    ImVector<ImGuiID> keys, missed_keys;
+    for (int size_n = 0; size_n < IM_ARRAYSIZE(sizes); size_n++)
+    {
+        const int keys_count = sizes[size_n];
+        BuildKeys(keys, keys_count, 0);
+        BuildKeys(missed_keys, keys_count, 1);
+
+        // Insert
+        RefStorage ref_storage;
+        double ref_insert_ms = -1.0;
+        BenchClock::time_point t0 = BenchClock::now();
+        if (keys_count <= ref_insert_max)
+        {
+            for (int n = 0; n < keys_count; n++)
+                ref_storage.SetInt(keys[n], n);
+            ref_insert_ms = MsSince(t0);
+        }
+        else
+        {
+            for (int n = 0; n < keys_count; n++)
+                ref_storage.Data.push_back(ImGuiStorage::Pair(keys[n], n));
+            qsort(ref_storage.Data.Data, (size_t)ref_storage.Data.Size, sizeof(ImGuiStorage::Pair), RefStorage::PairCompareByID);
+        }
+        ImGuiStorage storage;
+        t0 = BenchClock::now();
+        for (int n = 0; n < keys_count; n++)
+            storage.SetInt(keys[n], n);
+        const double insert_ms = MsSince(t0);
+        if (ref_insert_ms >= 0.0)
+            printf("%-8d %-10s %14.2f %14.2f %7.2fx\n", keys_count, "insert", ref_insert_ms, insert_ms, ref_insert_ms / insert_ms);
+        else
+            printf("%-8d %-10s %14s %14.2f %8s\n", keys_count, "insert", "(skipped)", insert_ms, "");
+
+        // Lookup existing keys, then missing keys
+        for (int pass = 0; pass < 2; pass++)
+        {
+            const ImVector<ImGuiID>& lookup_keys = (pass == 0) ? keys : missed_keys;
+            int ref_sum = 0, sum = 0;
+            t0 = BenchClock::now();
+            for (int n = 0; n < keys_count; n++)
+                ref_sum += ref_storage.GetInt(lookup_keys[n], -1);
+            const double ref_ms = MsSince(t0);
+            t0 = BenchClock::now();
+            for (int n = 0; n < keys_count; n++)
+                sum += storage.GetInt(lookup_keys[n], -1);
+            const double ms = MsSince(t0);
+            printf("%-8d %-10s %14.2f %14.2f %7.2fx", keys_count, pass == 0 ? "lookup" : "miss", ref_ms, ms, ref_ms / ms);
+            if (sum != ref_sum)
+            {
+                printf("  MISMATCH");
+                failures++;
+            }
+            printf("\n");
+        }
+        for (int n = 0; n < keys_count; n++)
+            if (storage.GetInt(keys[n], -1) != ref_storage.GetInt(keys[n], -1))
+            {
+                printf("%-8d value of key %08X differs\n", keys_count, keys[n]);
+                failures++;
+                break;
+            }
+    }
+
+    // Mixed per-frame workload, from empty storages
+    {
+        const int persistent_count = 5000;
+        const int frames_count = 300;
+        ImVector<ImGuiID> transient_keys;
+        BuildKeys(keys, persistent_count, 2);
+        BuildKeys(transient_keys, frames_count * 100, 3);
+        RefStorage ref_storage;
+        ImGuiStorage storage;
+        BenchClock::time_point t0 = BenchClock::now();
+        const int ref_sum = RunMixedFrames(ref_storage, keys, transient_keys, frames_count);
+        const double ref_ms = MsSince(t0) / frames_count;
+        t0 = BenchClock::now();
+        const int sum = RunMixedFrames(storage, keys, transient_keys, frames_count);
+        const double ms = MsSince(t0) / frames_count;
+        printf("%-8d %-10s %14.3f %14.3f %7.2fx  (per frame, +%d transient keys per frame)", persistent_count, "frame", ref_ms, ms, ref_ms / ms, transient_keys.Size / frames_count);
+        if (sum != ref_sum || storage.Data.Size != ref_storage.Data.Size)
+        {
+            printf("  MISMATCH");
+            failures++;
+        }
+        printf("\n");
+    }
+
+    const int const_failures = CheckConstQueries();
+    if (const_failures > 0)
+    {
+        printf("read-only queries modified the storage or returned wrong values (%d)\n", const_failures);
+        failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+// Benchmark: ImGuiTextFilter::PassFilter() over 100K object paths against the ImStristr() filter it replaced, and PassFilterArray() against PassFilter() on each item.
+// Fails if PassFilter() or PassFilterArray() disagree with the old filter on any item (zero-terminated items, patterns without a lone "-", where the old quirks don't apply).
+// Usage: bench_text_filter
+// Built with -DIMGUI_ENABLE_TEXT_FILTER_THREADS by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+// Case-insensitive search calling toupper() on both sides of every comparison, as it was before the folded patterns
+static const char* RefImStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
+{
+    if (!needle_end)
+        needle_end = needle + strlen(needle);
+
+    const int un0 = toupper((unsigned char)*needle);
+    while ((!haystack_end && *haystack) || (haystack_end && haystack < haystack_end))
+    {
+        if (toupper((unsigned char)*haystack) == un0)
+        {
+            const char* b = needle + 1;
+            for (const char* a = haystack + 1; b < needle_end; a++, b++)
+                if (toupper((unsigned char)*a) != toupper((unsigned char)*b))
+                    break;
+            if (b == needle_end)
+                return haystack;
+        }
+        haystack++;
+    }
+    return NULL;
+}
+
+static bool RefPassFilter(const ImGuiTextFilter& filter, const char* text)
+{
+    if (filter.Filters.empty())
+        return true;
+    for (int i = 0; i != filter.Filters.Size; i++)
+    {
+        const ImGuiTextFilter::TextRange& f = filter.Filters[i];
+        if (f.empty())
+            continue;
+        if (f.front() == '-')
+        {
+            if (RefImStristr(text, NULL, f.begin() + 1, f.end()) != NULL)
+                return false;
+        }
+        else
+        {
+            if (RefImStristr(text, NULL, f.begin(), f.end()) != NULL)
+                return true;
+        }
+    }
+    return filter.CountGrep == 0;
+}
+
+static unsigned int g_Rand = 12345;
+static int RandInt(int n) { g_Rand = g_Rand * 1103515245 + 12345; return (int)((g_Rand >> 16) % (unsigned int)n); }
+
+// Asset and scene object paths, in mixed case, a few with non-ASCII names
+static void BuildItems(ImVector<char>& text, ImVector<int>& offsets, int items_count)
+{
+    static const char* dirs[] = { "Scene", "Levels", "Props", "Characters", "FX", "UI", "Audio", "Materials", "Textures", "Shaders", "LOD", "Collision" };
+    static const char* names[] = { "Barrel", "crate", "Door", "window", "Tree", "rock", "Player", "enemy", "Spark", "smoke", "Button", "Caf\xC3\xA9", "\xE6\x97\xA5\xE6\x9C\xAC" };
+    static const char* exts[] = { ".mesh", ".tex", ".mat", ".wav", ".anim", "" };
+    char buf[256];
+    for (int n = 0; n < items_count; n++)
+    {
+        int len = 0;
+        const int depth = 1 + RandInt(4);
+        for (int d = 0; d < depth; d++)
+            len += sprintf(buf + len, "%s%s_%02d/", RandInt(5) == 0 ? "" : dirs[RandInt(IM_ARRAYSIZE(dirs))], RandInt(3) == 0 ? "" : "Group", RandInt(40));
+        sprintf(buf + len, "%s_%04d%s", names[RandInt(IM_ARRAYSIZE(names))], n % 10000, exts[RandInt(IM_ARRAYSIZE(exts))]);
+        offsets.push_back(text.Size);
+        const int size = (int)strlen(buf) + 1;
+        text.resize(text.Size + size);
+        memcpy(text.Data + text.Size - size, buf, (size_t)size);
+    }
+}
+
+typedef std::chrono::high_resolution_clock BenchClock;
+static double MsSince(BenchClock::time_point t0) { return std::chrono::duration<double, std::milli>(BenchClock::now() - t0).count(); }
+
+int main(int, char**)
+{
+    ImGui::CreateContext();     // PassFilterArray() keeps its worker threads in the current context
+    const int items_count = 100000;
+    const int repeat_count = 5;
+    ImVector<char> text;
+    ImVector<int> offsets;
+    BuildItems(text, offsets, items_count);
+    ImVector<const char*> items;
+    for (int n = 0; n < offsets.Size; n++)
+        items.push_back(text.Data + offsets[n]);
+    ImVector<ImU32> bits;
+    bits.resize((items_count + 31) / 32);
+
+    static const char* patterns[] = { "barrel", "BARREL_00", "e", "props,-mesh", "-tex", "zzz", "door,window,crate", "levels_1,-lod,-collision", "scene_03/group_12", "caf\xC3\xA9", "  Smoke  ,  -.wav " };
+    printf("%-28s %8s %12s %12s %8s %12s %8s\n", "filter", "passing", "old (ms)", "filter (ms)", "speedup", "array (ms)", "speedup");
+    int failures = 0;
+    double ref_total_ms = 0.0, total_ms = 0.0, array_total_ms = 0.0;
+    for (int pattern_n = 0; pattern_n < IM_ARRAYSIZE(patterns); pattern_n++)
+    {
+        ImGuiTextFilter filter(patterns[pattern_n]);
+        double ref_ms = 0.0, ms = 0.0, array_ms = 0.0;
+        int ref_count = 0, count = 0, array_count = 0;
+        for (int repeat = 0; repeat < repeat_count; repeat++)
+        {
+            BenchClock::time_point t0 = BenchClock::now();
+            ref_count = 0;
+            for (int n = 0; n < items_count; n++)
+                ref_count += RefPassFilter(filter, items[n]) ? 1 : 0;
+            const double ref_run_ms = MsSince(t0);
+            t0 = BenchClock::now();
+            count = 0;
+            for (int n = 0; n < items_count; n++)
+                count += filter.PassFilter(items[n]) ? 1 : 0;
+            const double run_ms = MsSince(t0);
+            t0 = BenchClock::now();
+            array_count = filter.PassFilterArray(items.Data, items_count, bits.Data);
+            const double array_run_ms = MsSince(t0);
+            ref_ms = (repeat == 0 || ref_run_ms < ref_ms) ? ref_run_ms : ref_ms;
+            ms = (repeat == 0 || run_ms < ms) ? run_ms : ms;
+            array_ms = (repeat == 0 || array_run_ms < array_ms) ? array_run_ms : array_ms;
+        }
+        ref_total_ms += ref_ms;
+        total_ms += ms;
+        array_total_ms += array_ms;
+
+        // Item by item: the old filter, PassFilter() with and without text_end, and the bitmap
+        int mismatches = (count != ref_count || array_count != ref_count) ? 1 : 0;
+        for (int n = 0; n < items_count; n++)
+        {
+            const bool ref_pass = RefPassFilter(filter, items[n]);
+            const bool array_pass = (bits[n >> 5] & (1u << (n & 31))) != 0;
+            if (filter.PassFilter(items[n]) != ref_pass || filter.PassFilter(items[n], items[n] + strlen(items[n])) != ref_pass || array_pass != ref_pass)
+                mismatches++;
+        }
+        char name[32];
+        sprintf(name, "\"%.24s\"", patterns[pattern_n]);
+        printf("%-28s %8d %12.2f %12.2f %7.2fx %12.2f %7.2fx", name, ref_count, ref_ms, ms, ref_ms / ms, array_ms, ms / array_ms);
+        if (mismatches > 0)
+        {
+            printf("  MISMATCH (%d)", mismatches);
+            failures++;
+        }
+        printf("\n");
+    }
+    printf("%-28s %8s %12.2f %12.2f %7.2fx %12.2f %7.2fx\n", "total", "", ref_total_ms, total_ms, ref_total_ms / total_ms, array_total_ms, total_ms / array_total_ms);
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}
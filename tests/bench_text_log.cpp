@@ -0,0 +1,205 @@
+// Benchmark: ImGuiTextLog ingest rate, and frame time of ImGuiTextLog::Draw() at 10K, 100K and 1M lines (idle, streaming 100 lines per frame, filtered),
+// against the ImGuiTextBuffer + line offsets log of the demo it replaced, which drew the whole text or tested every line against the filter every frame.
+// Fails if the lines or the filtered lines differ from the old log.
+// Usage: bench_text_log
+// Built by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+// The log of the demo before ImGuiTextLog
+struct RefTextLog
+{
+    ImGuiTextBuffer     Buf;
+    ImGuiTextFilter     Filter;
+    ImVector<int>       LineOffsets;        // Index to lines offset
+    bool                ScrollToBottom;
+
+    RefTextLog() { ScrollToBottom = false; }
+
+    void AddLog(const char* fmt, ...) IM_FMTARGS(2)
+    {
+        int old_size = Buf.size();
+        va_list args;
+        va_start(args, fmt);
+        Buf.appendfv(fmt, args);
+        va_end(args);
+        for (int new_size = Buf.size(); old_size < new_size; old_size++)
+            if (Buf[old_size] == '\n')
+                LineOffsets.push_back(old_size);
+        ScrollToBottom = true;
+    }
+
+    void Draw()
+    {
+        ImGui::BeginChild("scrolling", ImVec2(0,0), false, ImGuiWindowFlags_HorizontalScrollbar);
+        if (Filter.IsActive())
+        {
+            const char* buf_begin = Buf.begin();
+            const char* line = buf_begin;
+            for (int line_no = 0; line != NULL; line_no++)
+            {
+                const char* line_end = (line_no < LineOffsets.Size) ? buf_begin + LineOffsets[line_no] : NULL;
+                if (Filter.PassFilter(line, line_end))
+                    ImGui::TextUnformatted(line, line_end);
+                line = line_end && line_end[1] ? line_end + 1 : NULL;
+            }
+        }
+        else
+        {
+            ImGui::TextUnformatted(Buf.begin());
+        }
+        if (ScrollToBottom)
+            ImGui::SetScrollHere(1.0f);
+        ScrollToBottom = false;
+        ImGui::EndChild();
+    }
+};
+
+typedef std::chrono::high_resolution_clock BenchClock;
+static double MsSince(BenchClock::time_point t0) { return std::chrono::duration<double, std::milli>(BenchClock::now() - t0).count(); }
+
+static const char* g_Levels[] = { "info", "debug", "warning", "error" };
+
+// Lines as an application logs them: a frame number, a level, a message with a value
+#define LOG_LINE_FMT    "[%06d] [%s] Loaded asset %d in %d ms\n"
+#define LOG_LINE_ARGS(n) (n) / 100, g_Levels[(n) & 3], (n), (n) % 97
+
+static void AppendLines(ImGuiTextLog& log, RefTextLog* ref_log, int first_n, int count)
+{
+    for (int n = first_n; n < first_n + count; n++)
+    {
+        log.appendf(LOG_LINE_FMT, LOG_LINE_ARGS(n));
+        if (ref_log)
+            ref_log->AddLog(LOG_LINE_FMT, LOG_LINE_ARGS(n));
+    }
+}
+
+static void SetFilter(ImGuiTextFilter& filter, const char* text)
+{
+    strcpy(filter.InputBuf, text);
+    filter.Build();
+}
+
+// Average time of a NewFrame() .. Render() drawing one of the logs, optionally appending lines before each frame
+static double TimeFrames(ImGuiTextLog* log, RefTextLog* ref_log, int frames_count, int new_lines_per_frame, int* lines_count)
+{
+    BenchClock::time_point t0 = BenchClock::now();
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        for (int n = 0; n < new_lines_per_frame; n++, (*lines_count)++)
+        {
+            if (log)
+                log->appendf(LOG_LINE_FMT, LOG_LINE_ARGS(*lines_count));
+            else
+                ref_log->AddLog(LOG_LINE_FMT, LOG_LINE_ARGS(*lines_count));
+        }
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImVec2(800, 600));
+        ImGui::Begin(log ? "Log" : "RefLog");
+        if (log)
+            log->Draw("scrolling");
+        else
+            ref_log->Draw();
+        ImGui::End();
+        ImGui::Render();
+    }
+    return MsSince(t0) / frames_count;
+}
+
+// Same lines and same filtered lines as the old log
+static int CheckLines(ImGuiTextLog& log, RefTextLog& ref_log)
+{
+    if (log.Lines.Size != ref_log.LineOffsets.Size)
+        return 1;
+    const char* ref_line = ref_log.Buf.begin();
+    int filtered_count = 0;
+    for (int n = 0; n < log.Lines.Size; n++)
+    {
+        const char* ref_line_end = ref_log.Buf.begin() + ref_log.LineOffsets[n];
+        if (log.Lines[n].e - log.Lines[n].b != ref_line_end - ref_line || memcmp(log.Lines[n].b, ref_line, (size_t)(ref_line_end - ref_line)) != 0)
+            return 1;
+        if (ref_log.Filter.PassFilter(ref_line, ref_line_end))
+            filtered_count++;
+        ref_line = ref_line_end + 1;
+    }
+    return (log.Filter.IsActive() && log.FilteredLines.Size != filtered_count) ? 1 : 0;
+}
+
+int main(int, char**)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280, 800);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    int failures = 0;
+
+    // Ingest
+    {
+        const int lines_count = 1000000;
+        ImGuiTextLog log;
+        RefTextLog ref_log;
+        BenchClock::time_point t0 = BenchClock::now();
+        for (int n = 0; n < lines_count; n++)
+            ref_log.AddLog(LOG_LINE_FMT, LOG_LINE_ARGS(n));
+        const double ref_ms = MsSince(t0);
+        t0 = BenchClock::now();
+        AppendLines(log, NULL, 0, lines_count);
+        const double ms = MsSince(t0);
+        const double mb = (double)ref_log.Buf.size() / (1024.0 * 1024.0);
+        printf("ingest %d lines (%.1f MB): old log %.2f M lines/s, ImGuiTextLog %.2f M lines/s (%.0f MB/s), %.2fx\n", lines_count, mb,
+            lines_count / ref_ms / 1000.0, lines_count / ms / 1000.0, mb / (ms / 1000.0), ref_ms / ms);
+        if (CheckLines(log, ref_log) != 0)
+        {
+            printf("ingest: lines differ from the old log\n");
+            failures++;
+        }
+    }
+
+    // Frame time as the logs grow
+    const int sizes[] = { 10000, 100000, 1000000 };
+    const int new_lines_per_frame = 100;
+    printf("%-8s %-10s %14s %14s %8s\n", "lines", "frame", "old log (ms)", "text log (ms)", "speedup");
+    ImGuiTextLog log;
+    RefTextLog ref_log;
+    int lines_count = 0;
+    double idle_ms_first = 0.0, idle_ms_last = 0.0;
+    for (int size_n = 0; size_n < IM_ARRAYSIZE(sizes); size_n++)
+    {
+        AppendLines(log, &ref_log, lines_count, sizes[size_n] - lines_count);
+        lines_count = sizes[size_n];
+        const int ref_frames_count = (sizes[size_n] >= 1000000) ? 5 : 20;
+        for (int pass = 0; pass < 3; pass++)
+        {
+            const char* pass_name = (pass == 0) ? "idle" : (pass == 1) ? "streaming" : "filtered";
+            SetFilter(log.Filter, pass == 2 ? "warning" : "");
+            SetFilter(ref_log.Filter, pass == 2 ? "warning" : "");
+            const int new_lines = (pass == 1) ? new_lines_per_frame : 0;
+            TimeFrames(&log, NULL, 2, 0, &lines_count); // Warm up, and build the filter cache
+            int ref_lines_count = lines_count;
+            const double ref_ms = TimeFrames(NULL, &ref_log, ref_frames_count, new_lines, &ref_lines_count);
+            const double ms = TimeFrames(&log, NULL, new_lines > 0 ? ref_frames_count : 100, new_lines, &lines_count); // Streaming: the same lines as the old log
+            printf("%-8d %-10s %14.3f %14.3f %7.1fx\n", sizes[size_n], pass_name, ref_ms, ms, ref_ms / ms);
+            if (pass == 0)
+                (size_n == 0 ? idle_ms_first : idle_ms_last) = ms;
+            if (CheckLines(log, ref_log) != 0)
+            {
+                printf("%d lines, %s: lines or filtered lines differ from the old log\n", sizes[size_n], pass_name);
+                failures++;
+            }
+        }
+    }
+    printf("ImGuiTextLog idle frame: %.3f ms at %d lines, %.3f ms at %d lines\n", idle_ms_first, sizes[0], idle_ms_last, sizes[IM_ARRAYSIZE(sizes) - 1]);
+
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}
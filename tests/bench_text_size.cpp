@@ -0,0 +1,303 @@
+// Throughput benchmark: ImFont::CalcTextSizeA() and CalcWordWrapPositionA() on label and paragraph corpora, against the scalar code they replaced.
+// Fails if the sizes or the wrap positions differ from the scalar code.
+// Usage: bench_text_size
+// Built by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+// Scalar code decoding every character, as it was before the printable ASCII fast path
+static const char* RefCalcWordWrapPositionA(const ImFont* font, float scale, const char* text, const char* text_end, float wrap_width)
+{
+    float line_width = 0.0f;
+    float word_width = 0.0f;
+    float blank_width = 0.0f;
+    wrap_width /= scale;
+
+    const char* word_end = text;
+    const char* prev_word_end = NULL;
+    bool inside_word = true;
+
+    const char* s = text;
+    while (s < text_end)
+    {
+        unsigned int c = (unsigned int)*s;
+        const char* next_s;
+        if (c < 0x80)
+            next_s = s + 1;
+        else
+            next_s = s + ImTextCharFromUtf8(&c, s, text_end);
+        if (c == 0)
+            break;
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                line_width = word_width = blank_width = 0.0f;
+                inside_word = true;
+                s = next_s;
+                continue;
+            }
+            if (c == '\r')
+            {
+                s = next_s;
+                continue;
+            }
+        }
+
+        const float char_width = font->GetCharAdvance((ImWchar)c);
+        if (ImCharIsSpace(c))
+        {
+            if (inside_word)
+            {
+                line_width += blank_width;
+                blank_width = 0.0f;
+                word_end = s;
+            }
+            blank_width += char_width;
+            inside_word = false;
+        }
+        else
+        {
+            word_width += char_width;
+            if (inside_word)
+            {
+                word_end = next_s;
+            }
+            else
+            {
+                prev_word_end = word_end;
+                line_width += word_width + blank_width;
+                word_width = blank_width = 0.0f;
+            }
+            inside_word = !(c == '.' || c == ',' || c == ';' || c == '!' || c == '?' || c == '\"');
+        }
+
+        if (line_width + word_width >= wrap_width)
+        {
+            if (word_width < wrap_width)
+                s = prev_word_end ? prev_word_end : word_end;
+            break;
+        }
+
+        s = next_s;
+    }
+    return s;
+}
+
+static ImVec2 RefCalcTextSizeA(const ImFont* font, float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining)
+{
+    const float line_height = size;
+    const float scale = size / font->FontSize;
+
+    ImVec2 text_size = ImVec2(0, 0);
+    float line_width = 0.0f;
+
+    const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const char* word_wrap_eol = NULL;
+
+    const char* s = text_begin;
+    while (s < text_end)
+    {
+        if (word_wrap_enabled)
+        {
+            if (!word_wrap_eol)
+            {
+                word_wrap_eol = RefCalcWordWrapPositionA(font, scale, s, text_end, wrap_width - line_width);
+                if (word_wrap_eol == s)
+                    word_wrap_eol++;
+            }
+            if (s >= word_wrap_eol)
+            {
+                if (text_size.x < line_width)
+                    text_size.x = line_width;
+                text_size.y += line_height;
+                line_width = 0.0f;
+                word_wrap_eol = NULL;
+                while (s < text_end)
+                {
+                    const char c = *s;
+                    if (ImCharIsSpace(c)) { s++; } else if (c == '\n') { s++; break; } else { break; }
+                }
+                continue;
+            }
+        }
+
+        const char* prev_s = s;
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+        {
+            s += 1;
+        }
+        else
+        {
+            s += ImTextCharFromUtf8(&c, s, text_end);
+            if (c == 0)
+                break;
+        }
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                text_size.x = ImMax(text_size.x, line_width);
+                text_size.y += line_height;
+                line_width = 0.0f;
+                continue;
+            }
+            if (c == '\r')
+                continue;
+        }
+
+        const float char_width = font->GetCharAdvance((ImWchar)c) * scale;
+        if (line_width + char_width >= max_width)
+        {
+            s = prev_s;
+            break;
+        }
+        line_width += char_width;
+    }
+
+    if (text_size.x < line_width)
+        text_size.x = line_width;
+    if (line_width > 0 || text_size.y == 0.0f)
+        text_size.y += line_height;
+    if (remaining)
+        *remaining = s;
+    return text_size;
+}
+
+struct BenchCorpus
+{
+    const char*         Name;
+    ImVector<char>      Text;           // Zero-separated strings
+    ImVector<int>       Offsets;
+    float               WrapWidth;
+};
+
+static unsigned int g_Rand = 12345;
+static int RandInt(int n) { g_Rand = g_Rand * 1103515245 + 12345; return (int)((g_Rand >> 16) % (unsigned int)n); }
+
+static void AddString(BenchCorpus& corpus, const char* s)
+{
+    const int len = (int)strlen(s) + 1;
+    corpus.Offsets.push_back(corpus.Text.Size);
+    corpus.Text.resize(corpus.Text.Size + len);
+    memcpy(corpus.Text.Data + corpus.Text.Size - len, s, (size_t)len);
+}
+
+// Labels, menu items and values as seen in tools: short words, some "##" suffixes and printf-ed numbers, a few non-ASCII characters
+static void BuildCorpus(BenchCorpus& corpus, int strings_count, int words_min, int words_max, bool newlines, bool non_ascii)
+{
+    static const char* words[] = { "Window", "options", "Show", "Hide", "Enable", "Color", "Edit", "File", "Open", "Save", "as...", "Recent", "Settings", "Widgets", "Layout", "Columns", "Tree", "Node",
+        "Selected", "Value", "float", "int", "Drag", "Slider", "Input", "text", "multiline", "Filter", "Clear", "Copy", "Paste", "Undo", "Redo", "the", "of", "and", "a", "to", "is", "in", "with,", "size.", "(default)", "\"quoted\"" };
+    static const char* non_ascii_words[] = { "caf\xC3\xA9", "na\xC3\xAFve", "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E", "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82", "\xE2\x82\xAC" "42" };
+    char buf[1024];
+    for (int n = 0; n < strings_count; n++)
+    {
+        int len = 0;
+        const int words_count = words_min + RandInt(words_max - words_min + 1);
+        for (int word_n = 0; word_n < words_count && len < (int)sizeof(buf) - 64; word_n++)
+        {
+            const char* word = (non_ascii && RandInt(8) == 0) ? non_ascii_words[RandInt(IM_ARRAYSIZE(non_ascii_words))] : words[RandInt(IM_ARRAYSIZE(words))];
+            if (word_n > 0)
+                buf[len++] = (newlines && RandInt(12) == 0) ? '\n' : ' ';
+            len += sprintf(buf + len, RandInt(10) == 0 ? "%s %d" : "%s", word, RandInt(1000));
+        }
+        if (RandInt(4) == 0)
+            len += sprintf(buf + len, "##%d", n);
+        buf[len] = 0;
+        AddString(corpus, buf);
+    }
+}
+
+static double TimeCorpus(const ImFont* font, const BenchCorpus& corpus, bool reference, int repeat_count, float* out_checksum)
+{
+    double best_ms = 0.0;
+    for (int repeat = 0; repeat < repeat_count; repeat++)
+    {
+        float checksum = 0.0f;
+        std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        for (int n = 0; n < corpus.Offsets.Size; n++)
+        {
+            const char* text = corpus.Text.Data + corpus.Offsets[n];
+            const char* text_end = text + strlen(text);
+            const ImVec2 size = reference ? RefCalcTextSizeA(font, font->FontSize, FLT_MAX, corpus.WrapWidth, text, text_end, NULL) : font->CalcTextSizeA(font->FontSize, FLT_MAX, corpus.WrapWidth, text, text_end, NULL);
+            checksum += size.x + size.y;
+        }
+        std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        best_ms = (repeat == 0 || ms < best_ms) ? ms : best_ms;
+        *out_checksum = checksum;
+    }
+    return best_ms;
+}
+
+// Compare every size, remaining pointer (with a max_width cutting the text) and wrap position with the scalar code
+static int CheckCorpus(const ImFont* font, const BenchCorpus& corpus)
+{
+    int mismatches = 0;
+    for (int n = 0; n < corpus.Offsets.Size; n++)
+    {
+        const char* text = corpus.Text.Data + corpus.Offsets[n];
+        const char* text_end = text + strlen(text);
+        const float max_widths[] = { FLT_MAX, 40.0f };
+        for (int max_width_n = 0; max_width_n < IM_ARRAYSIZE(max_widths); max_width_n++)
+        {
+            const char* remaining = NULL;
+            const char* ref_remaining = NULL;
+            const ImVec2 size = font->CalcTextSizeA(font->FontSize, max_widths[max_width_n], corpus.WrapWidth, text, text_end, &remaining);
+            const ImVec2 ref_size = RefCalcTextSizeA(font, font->FontSize, max_widths[max_width_n], corpus.WrapWidth, text, text_end, &ref_remaining);
+            if (size.x != ref_size.x || size.y != ref_size.y || remaining != ref_remaining)
+                mismatches++;
+        }
+        const float wrap_widths[] = { 30.0f, 100.0f, 300.0f };
+        for (int wrap_width_n = 0; wrap_width_n < IM_ARRAYSIZE(wrap_widths); wrap_width_n++)
+            if (font->CalcWordWrapPositionA(1.0f, text, text_end, wrap_widths[wrap_width_n]) != RefCalcWordWrapPositionA(font, 1.0f, text, text_end, wrap_widths[wrap_width_n]))
+                mismatches++;
+    }
+    return mismatches;
+}
+
+int main(int, char**)
+{
+    ImFontAtlas atlas;
+    ImFont* font = atlas.AddFontDefault();
+    atlas.Build();
+
+    BenchCorpus corpora[4];
+    corpora[0].Name = "Labels"; corpora[0].WrapWidth = 0.0f;
+    BuildCorpus(corpora[0], 20000, 1, 4, false, false);
+    corpora[1].Name = "LabelsUtf8"; corpora[1].WrapWidth = 0.0f;
+    BuildCorpus(corpora[1], 20000, 1, 4, false, true);
+    corpora[2].Name = "Paragraphs"; corpora[2].WrapWidth = 0.0f;
+    BuildCorpus(corpora[2], 500, 50, 200, true, false);
+    corpora[3].Name = "Wrapped"; corpora[3].WrapWidth = 300.0f;
+    BuildCorpus(corpora[3], 500, 50, 200, true, false);
+    const int repeat_count = 5;
+
+    printf("%-12s %8s %10s %12s %12s %8s\n", "corpus", "strings", "bytes", "scalar MB/s", "fast MB/s", "speedup");
+    int failures = 0;
+    for (int corpus_n = 0; corpus_n < IM_ARRAYSIZE(corpora); corpus_n++)
+    {
+        const BenchCorpus& corpus = corpora[corpus_n];
+        float ref_checksum = 0.0f, checksum = 0.0f;
+        const double ref_ms = TimeCorpus(font, corpus, true, repeat_count, &ref_checksum);
+        const double ms = TimeCorpus(font, corpus, false, repeat_count, &checksum);
+        const int mismatches = CheckCorpus(font, corpus);
+        const double mb = (double)(corpus.Text.Size - corpus.Offsets.Size) / (1024.0 * 1024.0);
+        printf("%-12s %8d %10d %12.1f %12.1f %7.2fx", corpus.Name, corpus.Offsets.Size, corpus.Text.Size - corpus.Offsets.Size, mb / (ref_ms / 1000.0), mb / (ms / 1000.0), ref_ms / ms);
+        if (mismatches > 0 || checksum != ref_checksum)
+        {
+            printf("  MISMATCH (%d)", mismatches);
+            failures++;
+        }
+        printf("\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+// Test: ImFontAtlas::CacheFilename. A second build of the same fonts loads the cache without decompressing the default font, and a font modified without
+// touching its table directory (here the ascender in the 'hhea' table, with the table checksum left stale as patching tools often do) is rebuilt instead of loading the stale atlas.
+// Fails if a cache load differs from a build, or if the modified font gets the cached atlas of the original one. Also reports the build and cache load times.
+// Usage: test_font_atlas_cache
+// Built by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+static const char* g_CacheFilename = "test_font_atlas_cache.bin";
+
+static bool SameGlyph(const ImFontGlyph& a, const ImFontGlyph& b)
+{
+    return a.Codepoint == b.Codepoint && a.Page == b.Page && a.TexPage == b.TexPage && a.AdvanceX == b.AdvanceX &&
+        a.X0 == b.X0 && a.Y0 == b.Y0 && a.X1 == b.X1 && a.Y1 == b.Y1 && a.U0 == b.U0 && a.V0 == b.V0 && a.U1 == b.U1 && a.V1 == b.V1;
+}
+
+static bool SameAtlas(const ImFontAtlas& a, const ImFontAtlas& b)
+{
+    if (a.TexWidth != b.TexWidth || a.TexHeight != b.TexHeight || memcmp(a.TexPixelsAlpha8, b.TexPixelsAlpha8, (size_t)a.TexWidth * a.TexHeight) != 0)
+        return false;
+    if (a.Fonts.Size != b.Fonts.Size)
+        return false;
+    for (int n = 0; n < a.Fonts.Size; n++)
+    {
+        if (a.Fonts[n]->Glyphs.Size != b.Fonts[n]->Glyphs.Size)
+            return false;
+        for (int glyph_i = 0; glyph_i < a.Fonts[n]->Glyphs.Size; glyph_i++)
+            if (!SameGlyph(a.Fonts[n]->Glyphs[glyph_i], b.Fonts[n]->Glyphs[glyph_i]))
+                return false;
+    }
+    return true;
+}
+
+static double BuildAtlas(ImFontAtlas& atlas, const char* cache_filename)
+{
+    atlas.CacheFilename = cache_filename;
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    atlas.Build();
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+}
+
+// A copy of the font data owned by the atlas it is given to
+static void* CopyFontData(const void* data, int data_size)
+{
+    void* copy = ImGui::MemAlloc((size_t)data_size);
+    memcpy(copy, data, (size_t)data_size);
+    return copy;
+}
+
+static unsigned int ReadU16(const unsigned char* p) { return ((unsigned int)p[0] << 8) | p[1]; }
+static unsigned int ReadU32(const unsigned char* p) { return (ReadU16(p) << 16) | ReadU16(p + 2); }
+
+// Double the ascender in the 'hhea' table, which scales every glyph down (the pixel height covers ascender - descender), without updating the table directory
+static bool PatchAscender(unsigned char* data, int data_size)
+{
+    const int tables_count = (int)ReadU16(data + 4);
+    for (int n = 0; n < tables_count && 12 + 16 * (n + 1) <= data_size; n++)
+    {
+        const unsigned char* record = data + 12 + 16 * n;
+        const int offset = (int)ReadU32(record + 8);
+        if (memcmp(record, "hhea", 4) != 0 || offset + 6 > data_size)
+            continue;
+        const unsigned int ascender = (ReadU16(data + offset + 4) * 2) & 0x7FFF;
+        data[offset + 4] = (unsigned char)(ascender >> 8);
+        data[offset + 5] = (unsigned char)(ascender & 0xFF);
+        return true;
+    }
+    return false;
+}
+
+int main(int, char**)
+{
+    int failures = 0;
+    remove(g_CacheFilename);
+
+    // Cold start: build and write the cache, then load it
+    ImFontAtlas built_atlas;
+    built_atlas.AddFontDefault();
+    const double build_ms = BuildAtlas(built_atlas, g_CacheFilename);
+    ImFontAtlas loaded_atlas;
+    loaded_atlas.AddFontDefault();
+    const double load_ms = BuildAtlas(loaded_atlas, g_CacheFilename);
+    printf("default font: build %.2f ms, cache load %.2f ms\n", build_ms, load_ms);
+    if (!SameAtlas(built_atlas, loaded_atlas))
+    {
+        printf("default font: the atlas loaded from the cache differs from the built one\n");
+        failures++;
+    }
+    if (loaded_atlas.ConfigData[0].FontData != NULL)
+    {
+        printf("default font: decompressed although the atlas was loaded from the cache\n");
+        failures++;
+    }
+
+    // The same font given as a TTF file, then modified: the modified font must be built, not loaded from the cache of the original one
+    const ImFontConfig& default_cfg = built_atlas.ConfigData[0];
+    ImFontAtlas file_atlas;
+    file_atlas.AddFontFromMemoryTTF(CopyFontData(default_cfg.FontData, default_cfg.FontDataSize), default_cfg.FontDataSize, 13.0f);
+    BuildAtlas(file_atlas, g_CacheFilename);
+
+    unsigned char* patched_data = (unsigned char*)CopyFontData(default_cfg.FontData, default_cfg.FontDataSize);
+    if (!PatchAscender(patched_data, default_cfg.FontDataSize))
+    {
+        printf("can't find the 'hhea' table\n");
+        return 1;
+    }
+    ImFontAtlas patched_atlas, patched_ref_atlas;
+    patched_atlas.AddFontFromMemoryTTF(patched_data, default_cfg.FontDataSize, 13.0f);
+    patched_ref_atlas.AddFontFromMemoryTTF(CopyFontData(patched_data, default_cfg.FontDataSize), default_cfg.FontDataSize, 13.0f);
+    BuildAtlas(patched_atlas, g_CacheFilename);
+    BuildAtlas(patched_ref_atlas, NULL);
+    if (SameAtlas(file_atlas, patched_ref_atlas))
+    {
+        printf("modified font: the change doesn't affect the atlas, the test is meaningless\n");
+        failures++;
+    }
+    if (!SameAtlas(patched_atlas, patched_ref_atlas))
+    {
+        printf("modified font: loaded the stale atlas of the original font from the cache\n");
+        failures++;
+    }
+    else
+    {
+        printf("modified font: rebuilt\n");
+    }
+
+    remove(g_CacheFilename);
+    return failures == 0 ? 0 : 1;
+}
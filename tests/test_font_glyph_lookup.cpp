@@ -0,0 +1,55 @@
+// Test: the paged glyph lookup table of ImFont for codepoints in ranges of 256 codepoints without any glyph, which share page 0 of ImFont::IndexPages.
+// Memory is filled with garbage by the allocator, so anything the lookup table doesn't initialize shows up. Fails if such a codepoint doesn't measure as the fallback glyph.
+// Usage: test_font_glyph_lookup
+// Built by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 0x7F bytes read as 3.39e+38 in a float
+static void* PoisonedAlloc(size_t size, void*) { void* ptr = malloc(size); if (ptr) memset(ptr, 0x7F, size); return ptr; }
+static void  PoisonedFree(void* ptr, void*)    { free(ptr); }
+
+int main(int, char**)
+{
+    ImGui::SetAllocatorFunctions(PoisonedAlloc, PoisonedFree);
+    int failures = 0;
+    {
+        // A glyph at U+2500 makes the pages of U+0100..U+24FF glyphless
+        ImFontAtlas atlas;
+        ImFont* font = atlas.AddFontDefault();
+        atlas.AddCustomRectFontGlyph(font, 0x2500, 7, 13, 7.0f);
+        atlas.Build();
+        const float fallback_advance_x = font->FallbackAdvanceX;
+        const ImWchar codepoints[] = { 0x100, 0x300, 0x4E2, 0x1234, 0x24FF, 0x2501, 0x25FF };
+        for (int n = 0; n < IM_ARRAYSIZE(codepoints); n++)
+        {
+            const float advance_x = font->GetCharAdvance(codepoints[n]);
+            if (advance_x != fallback_advance_x)
+            {
+                printf("U+%04X: advance %g, expected the fallback advance %g\n", codepoints[n], advance_x, fallback_advance_x);
+                failures++;
+            }
+        }
+        if (font->GetCharAdvance(0x2500) != 7.0f)
+        {
+            printf("U+2500: advance %g, expected 7\n", font->GetCharAdvance(0x2500));
+            failures++;
+        }
+
+        // "a" U+0300 "b" U+1234 measures as "a", "b" and two fallback glyphs
+        const char* text = "a\xCC\x80" "b\xE1\x88\xB4";
+        const float width = font->CalcTextSizeA(font->FontSize, FLT_MAX, 0.0f, text).x;
+        const float expected_width = font->GetCharAdvance('a') + font->GetCharAdvance('b') + fallback_advance_x * 2;
+        if (width != expected_width)
+        {
+            printf("CalcTextSizeA(): width %g, expected %g\n", width, expected_width);
+            failures++;
+        }
+    }
+    printf("%s\n", failures == 0 ? "glyphless pages measure as the fallback glyph" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
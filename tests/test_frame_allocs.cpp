@@ -0,0 +1,223 @@
+// Headless test: the demo window rendered for a few hundred frames with the mouse moving over it must not allocate once warmed up (io.MetricsFrameAllocs == 0).
+// Allocations are counted per context: a warmed up context must keep reporting 0 while another context allocates every frame, in turn on the same thread and,
+// with IMGUI_ENABLE_THREAD_LOCAL_CONTEXT, at the same time on another thread.
+// With IMGUI_ENABLE_ALLOCATION_STATS, also checks the per category counters of each context, and that the allocation peak of a frame is kept per context when several contexts build frames in turn.
+// Usage: test_frame_allocs
+// Built with -DIMGUI_ENABLE_ALLOCATION_STATS -DIMGUI_ENABLE_THREAD_LOCAL_CONTEXT by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+#include <atomic>
+#include <thread>
+#endif
+
+static ImGuiContext* CreateHeadlessContext()
+{
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGui::SetCurrentContext(ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280, 800);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    return ctx;
+}
+
+static int TestDemoFrameAllocs()
+{
+    const int warm_up_frames_count = 10;
+    const int frames_count = 300;
+    ImGuiContext* ctx = CreateHeadlessContext();
+    ImGuiIO& io = ImGui::GetIO();
+    int failures = 0;
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        io.MousePos = ImVec2(60.0f + (float)(frame * 7 % 500), 40.0f + (float)(frame * 13 % 600));
+        ImGui::NewFrame();
+        if (frame > warm_up_frames_count && io.MetricsFrameAllocs != 0)
+        {
+            printf("frame %d: %d allocation(s)\n", frame, io.MetricsFrameAllocs);
+            failures++;
+        }
+        ImGui::ShowDemoWindow();
+        ImGui::Render();
+    }
+    printf("demo: %d frames, %d allocating after the first %d\n", frames_count, failures, warm_up_frames_count);
+    ImGui::DestroyContext(ctx);
+    return failures;
+}
+
+static void BuildFrame(const char* name)
+{
+    ImGui::Begin(name);
+    ImGui::Text("Hello");
+    ImGui::End();
+}
+
+// A frame of the current context, which creates a new window when 'allocate' is set. Returns the allocations the context counted during its previous frame.
+static int RunFrame(const char* name, bool allocate, int frame)
+{
+    ImGui::NewFrame();
+    const int frame_allocs = ImGui::GetIO().MetricsFrameAllocs;
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+    size_t stats_count = 0;
+    for (int n = 0; n < ImGuiAllocCategory_COUNT; n++)
+        stats_count += GImGui->AllocStatsLastFrame.Count[n];
+    if (stats_count != (size_t)frame_allocs)
+        printf("%s, frame %d: %d allocation(s), %d in the per category counters\n", name, frame, frame_allocs, (int)stats_count);
+#endif
+    BuildFrame(name);
+    if (allocate)
+    {
+        char window_name[32];
+        sprintf(window_name, "%s %d", name, frame);
+        BuildFrame(window_name);
+    }
+    ImGui::Render();
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+    return (stats_count == (size_t)frame_allocs) ? frame_allocs : -1;
+#else
+    return frame_allocs;
+#endif
+}
+
+// A doesn't allocate once warmed up, B creates a new window every frame. Returns the failures of A.
+static int CheckFrameAllocs(const char* name, int frame, int allocs_a, int allocs_b, int warm_up_frames_count)
+{
+    if (frame <= warm_up_frames_count)
+        return 0;
+    if (allocs_a != 0 || allocs_b <= 0)
+    {
+        printf("%s, frame %d: %d allocation(s) counted by A, %d by B, expected none for A and some for B\n", name, frame, allocs_a, allocs_b);
+        return 1;
+    }
+    return 0;
+}
+
+static int TestFrameAllocsPerContext()
+{
+    const int warm_up_frames_count = 10;
+    const int frames_count = 100;
+    ImGuiContext* ctx_a = CreateHeadlessContext();
+    ImGuiContext* ctx_b = CreateHeadlessContext();
+    int failures = 0;
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        ImGui::SetCurrentContext(ctx_a);
+        const int allocs_a = RunFrame("A", false, frame);
+        ImGui::SetCurrentContext(ctx_b);
+        const int allocs_b = RunFrame("B", true, frame);
+        failures += CheckFrameAllocs("same thread", frame, allocs_a, allocs_b, warm_up_frames_count);
+    }
+    printf("per context, same thread: %d frames, %d failure(s)\n", frames_count, failures);
+    ImGui::DestroyContext(ctx_b);
+    ImGui::SetCurrentContext(ctx_a);    // Shutdown() works on the current context
+    ImGui::DestroyContext(ctx_a);
+    return failures;
+}
+
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+// B builds its frames on another thread, at the same time as A
+static int TestFrameAllocsPerThreadContext()
+{
+    const int warm_up_frames_count = 10;
+    const int frames_count = 300;
+    ImGuiContext* ctx_a = CreateHeadlessContext();
+    std::atomic<int> allocs_b(0);
+    std::atomic<int> frame_b(0);
+    std::thread thread_b([&]()
+    {
+        ImGuiContext* ctx_b = CreateHeadlessContext();
+        for (int frame = 0; frame < frames_count; frame++)
+        {
+            allocs_b.store(RunFrame("B", true, frame));
+            frame_b.store(frame + 1);
+        }
+        ImGui::DestroyContext(ctx_b);
+    });
+    int failures = 0;
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        while (frame_b.load() < frame)  // Stay within a frame of B so both threads build their frames at the same time
+            std::this_thread::yield();
+        const int allocs_a = RunFrame("A", false, frame);
+        failures += CheckFrameAllocs("other thread", frame, allocs_a, frame > warm_up_frames_count ? allocs_b.load() : 0, warm_up_frames_count);
+    }
+    thread_b.join();
+    printf("per context, other thread: %d frames, %d failure(s)\n", frames_count, failures);
+    ImGui::DestroyContext(ctx_a);
+    return failures;
+}
+#endif
+
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+
+static size_t GetLiveBytes()
+{
+    ImGuiAllocStats stats;
+    ImGui::GetAllocStats(&stats);
+    size_t live_bytes = 0;
+    for (int n = 0; n < ImGuiAllocCategory_COUNT; n++)
+        live_bytes += stats.LiveBytes[n];
+    return live_bytes;
+}
+
+// NewFrame() of B doesn't reset the peak measured for A: a temporary allocation made during a frame of A, before B started its frame, is part of the peak of that frame of A.
+// B started its frame after the allocation, so its next frame doesn't include it.
+static int TestFramePeakPerContext()
+{
+    const size_t spike_size = 4 * 1024 * 1024;
+    const int spike_frame = 1;
+    ImGuiContext* ctx_a = CreateHeadlessContext();
+    ImGuiContext* ctx_b = CreateHeadlessContext();
+    int failures = 0;
+    for (int frame = 0; frame < 4; frame++)
+    {
+        ImGui::SetCurrentContext(ctx_a);
+        ImGui::NewFrame();
+        const size_t peak_a = ctx_a->AllocStatsLastFrame.PeakLiveBytes;
+        const size_t live_bytes = GetLiveBytes();
+        if (frame == spike_frame)
+            ImGui::MemFree(ImGui::MemAlloc(spike_size));
+        BuildFrame("A");
+        ImGui::Render();
+
+        ImGui::SetCurrentContext(ctx_b);
+        ImGui::NewFrame();
+        const size_t peak_b = ctx_b->AllocStatsLastFrame.PeakLiveBytes;
+        BuildFrame("B");
+        ImGui::Render();
+
+        const bool spike_expected_a = (frame == spike_frame + 1);
+        const bool spike_expected_b = (frame == spike_frame);
+        if (peak_a < live_bytes || peak_b < live_bytes || (peak_a >= live_bytes + spike_size) != spike_expected_a || (peak_b >= live_bytes + spike_size) != spike_expected_b)
+        {
+            printf("frame %d: peak of A %d KB, peak of B %d KB, live %d KB, wrong peak for the %d KB allocation made during frame %d\n", frame, (int)(peak_a / 1024), (int)(peak_b / 1024), (int)(live_bytes / 1024), (int)(spike_size / 1024), spike_frame);
+            failures++;
+        }
+    }
+    printf("peak per context: %d failure(s)\n", failures);
+    ImGui::DestroyContext(ctx_b);
+    ImGui::SetCurrentContext(ctx_a);    // Shutdown() works on the current context
+    ImGui::DestroyContext(ctx_a);
+    return failures;
+}
+#endif
+
+int main(int, char**)
+{
+    int failures = TestDemoFrameAllocs();
+    failures += TestFrameAllocsPerContext();
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+    failures += TestFrameAllocsPerThreadContext();
+#endif
+#ifdef IMGUI_ENABLE_ALLOCATION_STATS
+    failures += TestFramePeakPerContext();
+#endif
+    return failures == 0 ? 0 : 1;
+}
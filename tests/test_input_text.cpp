@@ -0,0 +1,250 @@
+// Test: randomized editing sequences on InputText() and InputTextMultiline(): typed characters, Enter, Backspace/Delete, arrows with Shift/Ctrl, Home/End, Ctrl+A, Ctrl+Z, clicks and drags.
+// After every frame the user buffers, the cursor and selection of the active widget and the number of vertices drawn go into a checksum per sequence. The expected
+// checksums were recorded by building this same file against imgui.cpp as it was before the edit state kept its incremental UTF-8 copy and line index.
+// Fails if a sequence ends with another checksum. Also times frames of typing and moving around in a 1 MB multi-line buffer, whose result is checked the same way.
+// Usage: test_input_text [--print]   (--print outputs the checksums of this build instead, to record them again)
+// Built by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+static const ImU32 g_ExpectedChecksums[] =
+{
+    0xA094A25D, 0xC275DCF1, 0x621ED3DB, 0x1EA9BA9D, 0x6128B1F2, 0xCFB8B491, 0x61E5A917, 0x1A0269F7,
+    0xBA4347FF, 0xC86B6D91, 0xA516B619, 0xC1B5E459, 0xA132CF8D, 0x331DBE47, 0x37E3F051, 0xB2A5F3FD,
+};
+static const ImU32 g_ExpectedLargeChecksum = 0xA67D24C4;    // The 1 MB buffer and its cursor after the timed frames
+
+static unsigned int g_Rand = 12345;
+static int RandInt(int n) { g_Rand = g_Rand * 1103515245 + 12345; return (int)((g_Rand >> 16) % (unsigned int)n); }
+
+// FNV-1a, independent from ImHash() which changed since the checksums were recorded
+static ImU32 Checksum(ImU32 h, const void* data, size_t size)
+{
+    for (size_t n = 0; n < size; n++)
+        h = (h ^ ((const unsigned char*)data)[n]) * 16777619u;
+    return h;
+}
+static ImU32 Checksum(ImU32 h, int v) { return Checksum(h, &v, sizeof(v)); }
+
+enum Action
+{
+    Action_Char, Action_Enter, Action_Backspace, Action_Delete, Action_Arrow, Action_HomeEnd, Action_SelectAll, Action_Undo, Action_Click, Action_Drag, Action_COUNT
+};
+
+struct EditTest
+{
+    char            SingleBuf[64];
+    char            MultiBuf[4096];
+    ImGuiID         SingleId, MultiId;
+    ImVec2          SingleMin, SingleMax, MultiMin, MultiMax;
+    ImVec2          DragTo;
+    bool            Dragging;
+
+    EditTest()
+    {
+        strcpy(SingleBuf, "Hello world");
+        strcpy(MultiBuf, "First line\nSecond line, a bit longer\n\nFourth line caf\xC3\xA9\nLast");
+        SingleId = MultiId = 0;
+        Dragging = false;
+    }
+
+    void Frame()
+    {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(10, 10));
+        ImGui::SetNextWindowSize(ImVec2(500, 400));
+        ImGui::Begin("Edit", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize);
+        SingleId = ImGui::GetID("single");
+        MultiId = ImGui::GetID("multi");
+        ImGui::InputText("single", SingleBuf, IM_ARRAYSIZE(SingleBuf));
+        SingleMin = ImGui::GetItemRectMin();
+        SingleMax = ImGui::GetItemRectMax();
+        ImGui::InputTextMultiline("multi", MultiBuf, IM_ARRAYSIZE(MultiBuf), ImVec2(300, 150));
+        MultiMin = ImGui::GetItemRectMin();
+        MultiMax = ImGui::GetItemRectMax();
+        ImGui::End();
+        ImGui::Render();
+    }
+
+    ImVec2 RandomPos()
+    {
+        const bool single = RandInt(4) == 0;
+        const ImVec2 min = single ? SingleMin : MultiMin, max = single ? SingleMax : MultiMax;
+        return ImVec2(min.x + (float)RandInt((int)(max.x - min.x)), min.y + (float)RandInt((int)(max.y - min.y)));
+    }
+
+    // Set up the input of the next frame
+    void RandomInput()
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        static const ImWchar chars[] = { 'a', 'b', 'Z', ' ', '.', '0', 0xE9, 0x65E5 };
+        switch (RandInt(100) * Action_COUNT / 100)
+        {
+        case Action_Char:       io.AddInputCharacter(RandInt(3) == 0 ? chars[RandInt(IM_ARRAYSIZE(chars))] : (ImWchar)('a' + RandInt(26))); break;
+        case Action_Enter:      io.KeysDown[io.KeyMap[ImGuiKey_Enter]] = true; break;
+        case Action_Backspace:  io.KeysDown[io.KeyMap[ImGuiKey_Backspace]] = true; break;
+        case Action_Delete:     io.KeysDown[io.KeyMap[ImGuiKey_Delete]] = true; break;
+        case Action_Arrow:      io.KeysDown[io.KeyMap[ImGuiKey_LeftArrow + RandInt(4)]] = true; io.KeyShift = RandInt(2) == 0; io.KeyCtrl = RandInt(4) == 0; break;
+        case Action_HomeEnd:    io.KeysDown[io.KeyMap[RandInt(2) ? ImGuiKey_Home : ImGuiKey_End]] = true; io.KeyShift = RandInt(2) == 0; io.KeyCtrl = RandInt(4) == 0; break;
+        case Action_SelectAll:  io.KeysDown[io.KeyMap[ImGuiKey_A]] = true; io.KeyCtrl = true; break;
+        case Action_Undo:       io.KeysDown[io.KeyMap[ImGuiKey_Z]] = true; io.KeyCtrl = true; break;
+        case Action_Click:      io.MousePos = RandomPos(); io.MouseDown[0] = true; io.KeyShift = RandInt(4) == 0; break;
+        case Action_Drag:       io.MousePos = RandomPos(); io.MouseDown[0] = true; DragTo = RandomPos(); Dragging = true; break;
+        }
+    }
+
+    // Release everything so the next key press or click is a new one
+    void ReleaseInput()
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        memset(io.KeysDown, 0, sizeof(io.KeysDown));
+        io.KeyCtrl = io.KeyShift = false;
+        if (Dragging)
+        {
+            io.MousePos = DragTo;
+            Dragging = false;
+        }
+        else
+        {
+            io.MouseDown[0] = false;
+        }
+    }
+
+    ImU32 StateChecksum(ImU32 h)
+    {
+        ImGuiContext& g = *GImGui;
+        h = Checksum(h, SingleBuf, strlen(SingleBuf));
+        h = Checksum(h, MultiBuf, strlen(MultiBuf));
+        const bool active = g.ActiveId != 0 && g.ActiveId == g.InputTextState.Id;
+        h = Checksum(h, !active ? 0 : g.InputTextState.Id == SingleId ? 1 : g.InputTextState.Id == MultiId ? 2 : 3);    // Not the ID itself: ImHash() changed
+        h = Checksum(h, active ? g.InputTextState.StbState.cursor : -1);
+        h = Checksum(h, active ? g.InputTextState.StbState.select_start : -1);
+        h = Checksum(h, active ? g.InputTextState.StbState.select_end : -1);
+        h = Checksum(h, ImGui::GetDrawData()->TotalVtxCount);
+        return h;
+    }
+};
+
+static void InitContext()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280, 800);
+    io.DeltaTime = 1.0f / 60.0f;
+    for (int n = 0; n < ImGuiKey_COUNT; n++)
+        io.KeyMap[n] = n;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+}
+
+static ImU32 RunSequence(int seed, int steps_count)
+{
+    InitContext();
+    g_Rand = (unsigned int)seed * 2654435761u + 1;
+    EditTest test;
+    ImU32 h = 2166136261u;
+    test.Frame();
+    for (int step = 0; step < steps_count; step++)
+    {
+        test.RandomInput();
+        test.Frame();
+        h = test.StateChecksum(h);
+        test.ReleaseInput();
+        test.Frame();
+        h = test.StateChecksum(h);
+    }
+    ImGui::DestroyContext();
+    return h;
+}
+
+// Frames of typing and moving the cursor around in a 1 MB multi-line buffer
+static double TimeLargeBuffer(int* out_text_size, ImU32* out_checksum)
+{
+    InitContext();
+    ImGuiIO& io = ImGui::GetIO();
+    const int buf_size = 2 * 1024 * 1024;
+    char* buf = (char*)ImGui::MemAlloc(buf_size);
+    int len = 0;
+    for (int line = 0; len < 1024 * 1024; line++)
+        len += sprintf(buf + len, "Line %d: The quick brown fox jumps over the lazy dog.\n", line);
+    *out_text_size = len;
+
+    const int frames_count = 300;
+    double total_ms = 0.0;
+    bool activated = false;
+    for (int frame = -3; frame < frames_count; frame++)
+    {
+        memset(io.KeysDown, 0, sizeof(io.KeysDown));
+        io.MouseDown[0] = (frame == -2);    // Click into the text to activate it, once the first frame made it hoverable
+        io.MousePos = ImVec2(100, 100);
+        if (frame >= 0)
+        {
+            switch (frame % 6)
+            {
+            case 0: io.AddInputCharacter('x'); break;
+            case 1: io.KeysDown[io.KeyMap[ImGuiKey_DownArrow]] = true; break;
+            case 2: io.KeysDown[io.KeyMap[ImGuiKey_Backspace]] = true; break;
+            case 3: io.KeysDown[io.KeyMap[ImGuiKey_End]] = true; break;
+            case 4: io.AddInputCharacter('\n'); break;
+            case 5: io.KeysDown[io.KeyMap[ImGuiKey_Home]] = true; break;
+            }
+        }
+        std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImVec2(800, 600));
+        ImGui::Begin("Large", NULL, ImGuiWindowFlags_NoTitleBar);
+        ImGui::InputTextMultiline("##large", buf, buf_size, ImVec2(-1.0f, -1.0f));
+        ImGui::End();
+        ImGui::Render();
+        if (frame == -1)
+            activated = (GImGui->ActiveId != 0);
+        if (frame >= 0)
+            total_ms += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+    }
+    *out_checksum = Checksum(Checksum(2166136261u, buf, strlen(buf)), GImGui->InputTextState.StbState.cursor);
+    ImGui::MemFree(buf);
+    ImGui::DestroyContext();
+    return activated ? total_ms / frames_count : -1.0;
+}
+
+int main(int argc, char** argv)
+{
+    const bool print = (argc > 1 && strcmp(argv[1], "--print") == 0);
+    const int sequences_count = 16;
+    const int steps_count = 1500;
+    int failures = 0;
+    for (int seed = 0; seed < sequences_count; seed++)
+    {
+        const ImU32 h = RunSequence(seed, steps_count);
+        if (print)
+            printf("0x%08X,%s", h, (seed % 8) == 7 ? "\n" : " ");
+        else if (seed >= IM_ARRAYSIZE(g_ExpectedChecksums) || h != g_ExpectedChecksums[seed])
+        {
+            printf("sequence %d: checksum %08X, expected %08X\n", seed, h, seed < IM_ARRAYSIZE(g_ExpectedChecksums) ? g_ExpectedChecksums[seed] : 0);
+            failures++;
+        }
+    }
+    if (!print)
+        printf("%d sequences of %d edits: %d different from the recorded ones\n", sequences_count, steps_count, failures);
+
+    int text_size = 0;
+    ImU32 large_checksum = 0;
+    const double frame_ms = TimeLargeBuffer(&text_size, &large_checksum);
+    if (print)
+        printf("0x%08X\n", large_checksum);
+    else if (frame_ms < 0.0 || large_checksum != g_ExpectedLargeChecksum)
+    {
+        printf("1 MB multi-line buffer: %s\n", frame_ms < 0.0 ? "the click didn't activate the text" : "checksum differs from the recorded one");
+        failures++;
+    }
+    printf("%d KB multi-line buffer: %.3f ms per frame of typing and moving around\n", text_size / 1024, frame_ms);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+// Test: io.LogFileOverflow when the log file writer thread (IMGUI_ENABLE_LOG_FILE_THREAD) falls behind. The writer is stalled by holding the lock of the log FILE,
+// which its fwrite() waits for, while chunks are logged. Fails if a policy loses, keeps or reorders the wrong chunks, if LogBytesWritten/LogBytesDropped/LogChunksDropped
+// don't match the file, or if ImGuiLogOverflow_Block spins instead of sleeping while it waits.
+// Usage: test_log_overflow
+// Built with -DIMGUI_ENABLE_LOG_FILE_THREAD by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#ifndef IMGUI_ENABLE_LOG_FILE_THREAD
+#error Build with -DIMGUI_ENABLE_LOG_FILE_THREAD
+#endif
+
+#ifdef _MSC_VER
+static void LockFile(FILE* f)   { _lock_file(f); }
+static void UnlockFile(FILE* f) { _unlock_file(f); }
+#else
+static void LockFile(FILE* f)   { flockfile(f); }
+static void UnlockFile(FILE* f) { funlockfile(f); }
+#endif
+
+static const char*  g_LogFilename = "test_log_overflow.log";
+static const int    g_ChunkSize = 64 * 1024;    // IMGUI_LOG_FILE_CHUNK_SIZE: each LogChunk() hands exactly one chunk over
+static const int    g_ChunksCount = 40;         // Far more than the IMGUI_LOG_FILE_CHUNKS_COUNT slots of the writer
+static char         g_Chunk[g_ChunkSize + 1];
+
+static void LogChunk(int chunk_n)
+{
+    sprintf(g_Chunk, "<chunk %04d>", chunk_n);
+    g_Chunk[strlen(g_Chunk)] = '.';
+    ImGui::LogText("%s", g_Chunk);
+}
+
+// Chunk numbers found in the log file, in order
+static int ReadLogFile(ImVector<int>& out_chunks, long* out_size)
+{
+    out_chunks.resize(0);
+    FILE* f = fopen(g_LogFilename, "rb");
+    if (!f)
+        return 0;
+    ImVector<char> data;
+    fseek(f, 0, SEEK_END);
+    data.resize((int)ftell(f) + 1);
+    fseek(f, 0, SEEK_SET);
+    data.resize((int)fread(data.Data, 1, (size_t)data.Size - 1, f) + 1);
+    data.back() = 0;
+    fclose(f);
+    *out_size = (long)data.Size - 1;
+    for (const char* p = data.Data; (p = strstr(p, "<chunk ")) != NULL; p++)
+        out_chunks.push_back(atoi(p + 7));
+    return 1;
+}
+
+// Hold the lock of the log file for 'stall_ms', from another thread than the writer (a FILE lock must be released by the thread which took it)
+static void StallFile(FILE* f, int stall_ms, std::atomic<bool>* locked)
+{
+    LockFile(f);
+    locked->store(true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(stall_ms));
+    UnlockFile(f);
+}
+
+// Log g_ChunksCount chunks with the writer stalled for 'stall_ms', then check what reached the file
+static int TestOverflow(ImGuiLogOverflow overflow, const char* name, int stall_ms)
+{
+    remove(g_LogFilename);
+    ImGuiContext& g = *GImGui;
+    g.IO.LogFileOverflow = overflow;
+    g.LogBytesWritten = g.LogBytesDropped = 0;
+    g.LogChunksDropped = 0;
+    ImGui::NewFrame();
+    ImGui::Begin("Log");
+    ImGui::LogToFile(-1, g_LogFilename);
+    std::atomic<bool> locked(false);
+    std::thread staller;
+    if (stall_ms > 0)
+    {
+        staller = std::thread(StallFile, g.LogFile, stall_ms, &locked);
+        while (!locked.load())
+            std::this_thread::yield();
+    }
+
+    const clock_t cpu_t0 = clock();
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < g_ChunksCount; n++)
+        LogChunk(n);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+    const double cpu_ms = (double)(clock() - cpu_t0) * 1000.0 / CLOCKS_PER_SEC;
+    if (staller.joinable())
+        staller.join();
+    g.IO.LogFileOverflow = ImGuiLogOverflow_Block;  // The writer may still be catching up: don't drop the final newline
+    ImGui::LogFinish();
+    ImGui::End();
+    ImGui::Render();
+
+    ImVector<int> chunks;
+    long file_size = 0;
+    int failures = 0;
+    if (!ReadLogFile(chunks, &file_size))
+    {
+        printf("%s: can't read %s\n", name, g_LogFilename);
+        return 1;
+    }
+    const ImU64 logged_bytes = (ImU64)g_ChunksCount * g_ChunkSize + strlen(IM_NEWLINE);
+    printf("%-10s writer stalled %3d ms: logged %d chunks in %.1f ms (%.1f ms CPU), %d chunks in the file, %llu bytes written, %llu bytes dropped, %d chunks dropped\n", name, stall_ms,
+        g_ChunksCount, ms, cpu_ms, chunks.Size, (unsigned long long)g.LogBytesWritten, (unsigned long long)g.LogBytesDropped, g.LogChunksDropped);
+    if (g.LogBytesWritten + g.LogBytesDropped != logged_bytes || g.LogBytesWritten != (ImU64)file_size || g.LogBytesDropped != (ImU64)g.LogChunksDropped * g_ChunkSize)
+    {
+        printf("%s: counters don't add up (%llu bytes logged, %ld bytes in the file)\n", name, (unsigned long long)logged_bytes, file_size);
+        failures++;
+    }
+    if (chunks.Size + g.LogChunksDropped != g_ChunksCount)
+    {
+        printf("%s: %d chunks in the file and %d dropped, expected %d in total\n", name, chunks.Size, g.LogChunksDropped, g_ChunksCount);
+        failures++;
+    }
+    for (int n = 1; n < chunks.Size; n++)
+        if (chunks[n] <= chunks[n - 1])
+        {
+            printf("%s: chunk %d written after chunk %d\n", name, chunks[n], chunks[n - 1]);
+            failures++;
+            break;
+        }
+
+    // What each policy keeps when the writer falls behind
+    const bool stalled = (stall_ms > 0);
+    if (overflow == ImGuiLogOverflow_Block || !stalled)
+    {
+        if (g.LogChunksDropped != 0)
+        {
+            printf("%s: dropped %d chunks\n", name, g.LogChunksDropped);
+            failures++;
+        }
+    }
+    else if (g.LogChunksDropped == 0 || chunks.Size == 0)
+    {
+        printf("%s: expected the stalled writer to drop chunks\n", name);
+        failures++;
+    }
+    else if (overflow == ImGuiLogOverflow_DropNewest && (chunks[0] != 0 || chunks.back() == g_ChunksCount - 1))
+    {
+        printf("%s: expected the first chunks to be kept and the last ones dropped\n", name);
+        failures++;
+    }
+    else if (overflow == ImGuiLogOverflow_DropOldest && chunks.back() != g_ChunksCount - 1)
+    {
+        printf("%s: expected the last chunk to be kept\n", name);
+        failures++;
+    }
+
+    // Waiting for the writer must sleep. clock() is the wall time with the Microsoft CRT, so this is only checked elsewhere.
+#ifndef _MSC_VER
+    if (overflow == ImGuiLogOverflow_Block && stalled && cpu_ms > ms * 0.5)
+    {
+        printf("%s: busy while waiting for the writer thread\n", name);
+        failures++;
+    }
+#endif
+    return failures;
+}
+
+int main(int, char**)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(800, 600);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    memset(g_Chunk, '.', g_ChunkSize);
+    g_Chunk[g_ChunkSize] = 0;
+
+    int failures = 0;
+    failures += TestOverflow(ImGuiLogOverflow_Block, "Block", 0);
+    failures += TestOverflow(ImGuiLogOverflow_Block, "Block", 300);
+    failures += TestOverflow(ImGuiLogOverflow_DropNewest, "DropNewest", 300);
+    failures += TestOverflow(ImGuiLogOverflow_DropOldest, "DropOldest", 300);
+
+    ImGui::DestroyContext();
+    remove(g_LogFilename);
+    printf("%s\n", failures == 0 ? "all policies ok" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
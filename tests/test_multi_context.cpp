@@ -0,0 +1,111 @@
+// Stress test: N contexts building frames at the same time on N threads (IMGUI_ENABLE_THREAD_LOCAL_CONTEXT), each with its own font atlas, input, text edit, tree nodes and clipboard.
+// Fails if a thread's draw data differs from the same frames built alone on the main thread. Run under a thread sanitizer to catch data races on shared state.
+// Usage: test_multi_context [threads] [frames]   (default: 8 threads, 200 frames)
+// Built with -DIMGUI_ENABLE_THREAD_LOCAL_CONTEXT by vs2015_tests.bat.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+#ifndef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+#error Build with -DIMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+#endif
+
+// Per-context clipboard, so the threads don't fight over the OS clipboard
+static const char* GetClipboardText(void* user_data)                { return ((ImVector<char>*)user_data)->Data; }
+static void        SetClipboardText(void* user_data, const char* text)
+{
+    ImVector<char>& clipboard = *(ImVector<char>*)user_data;
+    clipboard.resize((int)strlen(text) + 1);
+    memcpy(clipboard.Data, text, (size_t)clipboard.Size);
+}
+
+// Build frames_count frames on a new context and return a checksum of the draw data
+static void RunContext(int frames_count, ImU32* out_checksum)
+{
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGui::SetCurrentContext(ctx);
+    ImVector<char> clipboard;
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(800, 600);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.GetClipboardTextFn = GetClipboardText;
+    io.SetClipboardTextFn = SetClipboardText;
+    io.ClipboardUserData = &clipboard;
+    io.Fonts->AddFontDefault();
+    io.Fonts->GetGlyphRangesChinese();      // Unpacked on first use, by whichever thread comes first
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    char buf[256] = "Hello";
+    float f = 0.0f;
+    bool b = false;
+    ImU32 checksum = 0;
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        io.MousePos = ImVec2((float)(frame * 7 % 800), (float)(frame * 13 % 600));
+        io.MouseDown[0] = (frame % 3) == 0;
+        ImGui::NewFrame();
+        ImGui::Begin("Stress");
+        ImGui::Text("Frame %d", frame);
+        ImGui::InputText("Text", buf, IM_ARRAYSIZE(buf));
+        ImGui::SliderFloat("Float", &f, 0.0f, 1.0f);
+        ImGui::Checkbox("Bool", &b);
+        ImGui::SetNextTreeNodeOpen(true, ImGuiCond_Once);
+        if (ImGui::TreeNode("Tree"))
+        {
+            for (int n = 0; n < 50; n++)
+                ImGui::Selectable("Item");
+            ImGui::TreePop();
+        }
+        ImGui::SetClipboardText(buf);
+        if (strcmp(ImGui::GetClipboardText(), buf) != 0)
+            checksum++;
+        ImGui::End();
+        ImGui::Render();
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        checksum = checksum * 31 + (ImU32)draw_data->TotalVtxCount;
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+            checksum = ImHash(draw_data->CmdLists[n]->VtxBuffer.Data, draw_data->CmdLists[n]->VtxBuffer.Size * (int)sizeof(ImDrawVert), checksum);
+    }
+    *out_checksum = checksum;
+    ImGui::DestroyContext(ctx);
+}
+
+int main(int argc, char** argv)
+{
+    const int threads_count = (argc > 1) ? atoi(argv[1]) : 8;
+    const int frames_count = (argc > 2) ? atoi(argv[2]) : 200;
+    if (threads_count < 1 || frames_count < 1)
+    {
+        printf("Usage: test_multi_context [threads] [frames]\n");
+        return 1;
+    }
+
+    ImVector<ImU32> checksums;
+    ImVector<std::thread*> threads;
+    checksums.resize(threads_count);
+    for (int n = 0; n < threads_count; n++)
+        threads.push_back(new std::thread(RunContext, frames_count, &checksums[n]));
+    for (int n = 0; n < threads_count; n++)
+    {
+        threads[n]->join();
+        delete threads[n];
+    }
+
+    // Reference run once the threads are done, so they are the ones racing to the first use of shared static data
+    ImU32 ref_checksum = 0;
+    RunContext(frames_count, &ref_checksum);
+    int mismatches = 0;
+    for (int n = 0; n < threads_count; n++)
+        if (checksums[n] != ref_checksum)
+            mismatches++;
+    printf("%d contexts on %d threads, %d frames each: %d mismatch(es)\n", threads_count, threads_count, frames_count, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
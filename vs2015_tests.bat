@@ -0,0 +1,33 @@
+@echo off
+call "C:\Program Files (x86)\Microsoft Visual Studio 14.0\VC\vcvarsall.bat" x64
+cd /d %~dp0
+set INCLUDE_DIRS=-Iimgui_winapi_gl2
+set IMGUI_SOURCES=imgui_winapi_gl2/imgui.cpp imgui_winapi_gl2/imgui_demo.cpp imgui_winapi_gl2/imgui_draw.cpp
+if not exist tests\bin mkdir tests\bin
+call :run bench_font_atlas_build "-DIMGUI_ENABLE_FONT_ATLAS_BUILD_THREADS" || goto failed
+call :run bench_text_size "" || goto failed
+call :run bench_render_text "" || goto failed
+call :run bench_stbtt_rasterizer "tests/bench_stbtt_rasterizer_scalar.cpp" || goto failed
+call :run bench_hash "" || goto failed
+call :run bench_storage "" || goto failed
+call :run bench_ini_load "" || goto failed
+call :run bench_text_log "" || goto failed
+call :run bench_text_filter "-DIMGUI_ENABLE_TEXT_FILTER_THREADS" || goto failed
+call :run test_multi_context "-DIMGUI_ENABLE_THREAD_LOCAL_CONTEXT" || goto failed
+call :run test_frame_allocs "-DIMGUI_ENABLE_ALLOCATION_STATS -DIMGUI_ENABLE_THREAD_LOCAL_CONTEXT" || goto failed
+call :run test_font_atlas_cache "" || goto failed
+call :run test_font_glyph_lookup "" || goto failed
+call :run test_log_overflow "-DIMGUI_ENABLE_LOG_FILE_THREAD" || goto failed
+call :run test_input_text "" || goto failed
+echo All tests passed
+pause
+exit /b 0
+:failed
+echo FAILED
+pause
+exit /b 1
+
+:run
+cl -nologo -MT -O2 -Oi -fp:fast -Gm- -EHsc -GR- -WX -W4 -FC -Z7 %INCLUDE_DIRS% %~2 tests/%1.cpp %IMGUI_SOURCES% -Fotests\bin\ -Fetests\bin\%1.exe /link -incremental:no -opt:ref || exit /b 1
+tests\bin\%1.exe || exit /b 1
+exit /b 0